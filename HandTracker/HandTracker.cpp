@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <future>
 #include <iostream>
 #include <mutex>
@@ -71,10 +73,12 @@ class OneEuroFilter {
 
 // 共享数据结构
 struct SharedData {
-    float scale    = 1.0f;
-    float rot_x    = 0.5f;
-    float rot_y    = 0.5f;
-    bool  has_hand = false;
+    float                                 scale    = 1.0f;
+    float                                 rot_x    = 0.5f;
+    float                                 rot_y    = 0.5f;
+    bool                                  has_hand = false;
+    unsigned int                          sequence = 0; // 每处理完一帧 +1，0 表示还没有结果
+    std::chrono::steady_clock::time_point capture_time; // 该结果对应的摄像头帧取得时间
 };
 
 // 调试数据结构
@@ -99,6 +103,11 @@ struct TrackerContext {
     std::mutex              init_mutex;
     std::condition_variable init_cv;
 
+    // 处理间隔 (SetTrackerInterval)，0 表示暂停: 工作线程关闭摄像头并阻塞，直到恢复或 ReleaseTracker
+    std::atomic<int>        interval_ms{33};
+    std::mutex              interval_mutex;
+    std::condition_variable interval_cv;
+
     // 调试模式
     std::atomic<bool> debug_mode{false};
     std::atomic<bool> debug_window_created{false};
@@ -283,17 +292,55 @@ void WorkerThreadFunc(int cam_id, std::string model_dir) {
     bool debug_landmarks_valid = false;
     int  hand_lost_counter     = 0;
     bool smooth_has_hand       = false;
-
-    // 自适应帧率控制：目标 30 FPS (约 33ms 每帧)
-    const auto TARGET_FRAME_TIME = std::chrono::milliseconds(33);
+    bool camera_open           = true; // 暂停时关闭，恢复时重新打开
 
     while (g_ctx.running) {
-        auto frame_start = std::chrono::steady_clock::now();
+        if (g_ctx.interval_ms.load() == 0) {
+            if (camera_open) {
+                // 暂停: 释放摄像头 (停止取流和推理)
+                camera->close();
+                camera_open = false;
+                g_ctx.filter_rot_x.reset();
+                g_ctx.filter_rot_y.reset();
+                g_ctx.filter_scale.reset();
+                hand_lost_counter = 0;
+                smooth_has_hand   = false;
+                {
+                    // 发布一个无手的结果，恢复后重新打开摄像头期间调用方不会沿用暂停前的手势
+                    std::lock_guard<std::mutex> lock(g_ctx.data_mutex);
+                    g_ctx.latest_data.has_hand     = false;
+                    g_ctx.latest_data.capture_time = std::chrono::steady_clock::now();
+                    g_ctx.latest_data.sequence++;
+                }
+                std::cout << "[HandTracker] Suspended, camera released" << std::endl;
+            }
+            std::unique_lock<std::mutex> lock(g_ctx.interval_mutex);
+            g_ctx.interval_cv.wait(lock, [] { return !g_ctx.running || g_ctx.interval_ms.load() != 0; });
+            continue;
+        }
+        if (!camera_open) {
+            // 恢复: 重新打开摄像头 (不持有 interval_mutex，SetTrackerInterval 不会被打开的耗时阻塞)
+            camera_open = camera->open(cam_id, 640, 480);
+            if (!camera_open) {
+                // 例如摄像头在暂停期间被其他程序占用，每秒重试
+                std::cerr << "[HandTracker] Failed to reopen camera " << cam_id << ", retrying..." << std::endl;
+                std::unique_lock<std::mutex> lock(g_ctx.interval_mutex);
+                g_ctx.interval_cv.wait_for(lock, std::chrono::seconds(1),
+                                           [] { return !g_ctx.running || g_ctx.interval_ms.load() == 0; });
+                continue;
+            }
+            std::cout << "[HandTracker] Resumed, camera reopened" << std::endl;
+        }
+
+        // 自适应帧率控制：目标间隔由 SetTrackerInterval 决定 (默认 33ms，约 30 FPS)
+        const auto TARGET_FRAME_TIME = std::chrono::milliseconds(g_ctx.interval_ms.load());
+        auto       frame_start       = std::chrono::steady_clock::now();
 
         if (!camera->getLatestFrame(frame)) {
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
             continue;
         }
+        auto capture_time = std::chrono::steady_clock::now();
 
         frame_count++;
         debug_landmarks_valid = false;
@@ -399,7 +446,7 @@ void WorkerThreadFunc(int cam_id, std::string model_dir) {
         }
 
         // 使用 One Euro Filter 平滑数据
-        const float dt     = 1.0f / 30.0f;
+        const float dt     = TARGET_FRAME_TIME.count() / 1000.0f;
         g_ctx.smooth_rot_x = g_ctx.filter_rot_x.filter(target_rot_x, dt);
         g_ctx.smooth_rot_y = g_ctx.filter_rot_y.filter(target_rot_y, dt);
         g_ctx.smooth_scale = g_ctx.filter_scale.filter(target_scale, dt);
@@ -417,10 +464,12 @@ void WorkerThreadFunc(int cam_id, std::string model_dir) {
 
         {
             std::lock_guard<std::mutex> lock(g_ctx.data_mutex);
-            g_ctx.latest_data.has_hand = smooth_has_hand;
-            g_ctx.latest_data.scale    = g_ctx.smooth_scale;
-            g_ctx.latest_data.rot_x    = g_ctx.smooth_rot_x;
-            g_ctx.latest_data.rot_y    = g_ctx.smooth_rot_y;
+            g_ctx.latest_data.has_hand     = smooth_has_hand;
+            g_ctx.latest_data.scale        = g_ctx.smooth_scale;
+            g_ctx.latest_data.rot_x        = g_ctx.smooth_rot_x;
+            g_ctx.latest_data.rot_y        = g_ctx.smooth_rot_y;
+            g_ctx.latest_data.capture_time = capture_time;
+            g_ctx.latest_data.sequence++;
         }
 
         // 调试窗口显示 (优化: 只在调试模式下才 clone frame)
@@ -578,6 +627,10 @@ HAND_API bool WaitForTrackerReady(int timeout_ms) {
     return g_ctx.init_success.load();
 }
 
+HAND_API bool IsTrackerInitComplete() {
+    return g_ctx.init_complete.load();
+}
+
 HAND_API bool GetHandData(float* out_scale, float* out_rot_x, float* out_rot_y, bool* out_has_hand) {
     std::lock_guard<std::mutex> lock(g_ctx.data_mutex);
 
@@ -597,8 +650,41 @@ HAND_API bool GetHandData(float* out_scale, float* out_rot_x, float* out_rot_y,
     return g_ctx.latest_data.has_hand;
 }
 
+HAND_API bool GetHandDataEx(float* out_scale, float* out_rot_x, float* out_rot_y, bool* out_has_hand,
+                            unsigned int* out_sequence, double* out_age_ms) {
+    std::lock_guard<std::mutex> lock(g_ctx.data_mutex);
+
+    if (out_scale) {
+        *out_scale = g_ctx.latest_data.scale;
+    }
+    if (out_rot_x) {
+        *out_rot_x = g_ctx.latest_data.rot_x;
+    }
+    if (out_rot_y) {
+        *out_rot_y = g_ctx.latest_data.rot_y;
+    }
+    if (out_has_hand) {
+        *out_has_hand = g_ctx.latest_data.has_hand;
+    }
+    if (out_sequence) {
+        *out_sequence = g_ctx.latest_data.sequence;
+    }
+    if (out_age_ms) {
+        // 调用方与 DLL 的时钟不一定相同，返回帧龄而不是绝对时间
+        auto age    = std::chrono::steady_clock::now() - g_ctx.latest_data.capture_time;
+        *out_age_ms = g_ctx.latest_data.sequence ? std::chrono::duration<double, std::milli>(age).count() : 0.0;
+    }
+
+    return g_ctx.latest_data.has_hand;
+}
+
 HAND_API void ReleaseTracker() {
-    g_ctx.running = false;
+    {
+        // 在 interval_mutex 内修改，暂停中的工作线程不会漏掉通知
+        std::lock_guard<std::mutex> lock(g_ctx.interval_mutex);
+        g_ctx.running = false;
+    }
+    g_ctx.interval_cv.notify_all();
     if (g_ctx.worker_thread) {
         if (g_ctx.worker_thread->joinable()) {
             // 超时保护: 最多等待 3 秒，防止线程阻塞导致主程序挂起
@@ -618,6 +704,19 @@ HAND_API void ReleaseTracker() {
     g_ctx.Reset();
 }
 
+HAND_API void SetTrackerInterval(int interval_ms) {
+    interval_ms = std::max(interval_ms, 0);
+    {
+        std::lock_guard<std::mutex> lock(g_ctx.interval_mutex);
+        g_ctx.interval_ms = interval_ms;
+    }
+    g_ctx.interval_cv.notify_all();
+}
+
+HAND_API int GetTrackerInterval() {
+    return g_ctx.interval_ms.load();
+}
+
 HAND_API void SetTrackerDebugMode(bool enabled) {
     g_ctx.debug_mode = enabled;
 }
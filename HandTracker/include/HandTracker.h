@@ -43,6 +43,10 @@ HAND_API bool InitTracker(int camera_id, const char* model_dir);
 // 注意: 初始化失败时可通过 GetTrackerLastError() 获取错误码
 HAND_API bool WaitForTrackerReady(int timeout_ms);
 
+// 查询初始化是否已结束（无论成功或失败），不阻塞
+// 用于在渲染循环中轮询，避免启动时等待摄像头；返回 true 后调用 WaitForTrackerReady 可立即得到结果
+HAND_API bool IsTrackerInitComplete();
+
 // 获取最后一次错误码
 HAND_API int GetTrackerLastError();
 
@@ -56,9 +60,23 @@ HAND_API const char* GetTrackerLastErrorMessage();
 // out_has_hand: 是否检测到手部
 HAND_API bool GetHandData(float* out_scale, float* out_rot_x, float* out_rot_y, bool* out_has_hand);
 
+// 获取手部追踪数据及其来源帧信息
+// out_sequence: 结果序号，追踪器每处理完一帧 +1（0 表示尚无结果），用于判断是否为新结果
+// out_age_ms: 结果对应的摄像头帧取得至今的时间（毫秒），用于统计输入到显示的延迟
+HAND_API bool GetHandDataEx(float* out_scale, float* out_rot_x, float* out_rot_y, bool* out_has_hand,
+                            unsigned int* out_sequence, double* out_age_ms);
+
 // 释放资源并关闭摄像头
 HAND_API void ReleaseTracker();
 
+// 设置追踪器处理摄像头帧的间隔（毫秒），默认 33（约 30 FPS）
+// 0 表示暂停: 工作线程释放摄像头并阻塞，不再取流和推理；再次设为正值时重新打开摄像头
+// 暂停期间 GetHandData 报告无手部
+HAND_API void SetTrackerInterval(int interval_ms);
+
+// 获取当前处理间隔（毫秒），0 表示已暂停
+HAND_API int GetTrackerInterval();
+
 // 启用/禁用 OpenCV 调试窗口
 HAND_API void SetTrackerDebugMode(bool enabled);
 
@@ -16,6 +16,8 @@ struct AppState {
         unsigned int width        = 1920;
         unsigned int height       = 1080;
         bool         resized      = true;
+        bool         iconified    = false; // 最小化 (GLFW 回调更新)
+        bool         focused      = true;
         bool         isFullscreen = false;
         int          windowedX    = 100;
         int          windowedY    = 100;
@@ -30,6 +32,12 @@ struct AppState {
         float        densityComp            = 0.6f; // 缓存的密度补偿值
         int          vsyncMode              = -1;   // -1: Adaptive, 0: Off, 1: On
         bool         adaptiveVSyncSupported = false;
+        bool         temporalAccum          = true; // 粒子时间累积 (抖动 + 重投影历史)
+        bool         particleSplat          = true; // 小粒子用计算着色器光栅化 (大粒子仍为点精灵)
+        int          particleBackend        = 0;    // 土星粒子的图元后端 (ParticleBackend::Backend，首次启动时测量选择)
+        bool         saturnImpostor         = true; // 土星在屏幕上较小时改画八面体图集替身
+        bool         framePacing            = true; // VSync 下按预测的 vblank 推迟帧开始，并在提交前锁存手部输入
+        bool         powerSaving            = true; // 最小化 / 被遮挡时暂停渲染和追踪，失去焦点时降低帧率
     } render;
 
     // UI 状态
@@ -47,6 +55,8 @@ struct AppState {
         bool keyB_pressed   = false;
         bool keyF3_pressed  = false;
         bool keyF11_pressed = false;
+        bool keyF9_pressed  = false;
+        bool keyF12_pressed = false;
     } input;
 
     // 背景效果状态 (Windows DWM)
@@ -0,0 +1,304 @@
+// BlurPyramid.cpp - 双重 Kawase 模糊金字塔实现
+
+#include "pch.h"
+
+#include "BlurPyramid.h"
+#include "FrameGraph.h" // Capacity
+#include "Renderer.h"   // UniformCache
+
+#include <iomanip>
+
+namespace BlurPyramid {
+
+namespace {
+
+// 按调度分组对齐: 起点向下取整到 8 的倍数 (着色器分块原点依赖这一点)，终点扩展到覆盖最后一个分组
+// 整个分组都会被写入，所以对齐后的范围才是实际写入 (也是需要有效输入) 的范围
+Rect Align(const Rect& r, int w, int h) {
+    Rect a;
+    a.x0 = std::clamp(r.x0, 0, w) / kGroupSize * kGroupSize;
+    a.y0 = std::clamp(r.y0, 0, h) / kGroupSize * kGroupSize;
+    a.x1 = std::min(w, a.x0 + (std::clamp(r.x1, 0, w) - a.x0 + kGroupSize - 1) / kGroupSize * kGroupSize);
+    a.y1 = std::min(h, a.y0 + (std::clamp(r.y1, 0, h) - a.y0 + kGroupSize - 1) / kGroupSize * kGroupSize);
+    return a;
+}
+
+// 升采样写入 dst 时读取的上一级 (更低分辨率) 范围: 分块原点 base / 2 - 2，宽 8
+Rect UpSource(const Rect& dst) {
+    return {dst.x0 / 2 - 2, dst.y0 / 2 - 2, (dst.x1 + kGroupSize - 1) / 2 + 2, (dst.y1 + kGroupSize - 1) / 2 + 2};
+}
+
+// 降采样写入 dst 时读取的下一级 (更高分辨率) 范围: 分块原点 base * 2 - 1，宽 18
+Rect DownSource(const Rect& dst) {
+    return {dst.x0 * 2 - 1, dst.y0 * 2 - 1, (dst.x1 + kGroupSize - 1) / kGroupSize * kGroupSize * 2 + 1,
+            (dst.y1 + kGroupSize - 1) / kGroupSize * kGroupSize * 2 + 1};
+}
+
+// 旧实现的 1/6 分辨率 ping-pong 帧缓冲 (R11F_G11F_B10F)，仅保留给 --bench-blur 做对比
+struct BlurFramebuffer {
+    GLuint fbo = 0, tex = 0;
+    int    w = 0, h = 0;
+
+    void Init(int width, int height) {
+        w = width;
+        h = height;
+        glGenFramebuffers(1, &fbo);
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, width, height, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+};
+
+// 旧实现: 固定 1/6 分辨率的 Kawase ping-pong (4 ~ 8 次全屏 pass)，返回 pass 数
+int LegacyKawase(GLuint program, const UniformCache& uc, GLuint vaoQuad, GLuint srcTex, BlurFramebuffer& a,
+                 BlurFramebuffer& b, float strength) {
+    glBlendFunc(GL_ONE, GL_ZERO);
+    glViewport(0, 0, a.w, a.h);
+    glUseProgram(program);
+    glUniform1i(uc.blur_uTexture, 0);
+    glUniform2f(uc.blur_uTexelSize, 1.0f / a.w, 1.0f / a.h);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(vaoQuad);
+
+    // 迭代次数取偶数，最终结果落在 b 中
+    const float offsets[]     = {0.0f, 1.0f, 2.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    const int   maxIterations = sizeof(offsets) / sizeof(offsets[0]);
+    int         iterations    = std::min(3 + (int)strength, maxIterations);
+    iterations                = std::min(iterations + iterations % 2, maxIterations);
+
+    GLuint src = srcTex;
+    for (int i = 0; i < iterations; i++) {
+        BlurFramebuffer& dst = (i % 2 == 0) ? a : b;
+        glBindFramebuffer(GL_FRAMEBUFFER, dst.fbo);
+        glBindTexture(GL_TEXTURE_2D, src);
+        glUniform1f(uc.blur_uOffset, offsets[i]);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        src = dst.tex;
+    }
+    return iterations;
+}
+
+} // namespace
+
+int DepthForStrength(float strength) {
+    return 3 + (int)(std::clamp(strength, 0.0f, 5.0f) * 0.6f + 0.5f);
+}
+
+void Pyramid::Init(int width, int height, int displayWidth, int displayHeight) {
+    srcW     = width;
+    srcH     = height;
+    displayW = std::max(1, displayWidth);
+    displayH = std::max(1, displayHeight);
+
+    // 各级纹理按帧图尺寸档位下的源尺寸分配: 动态分辨率的小幅变化只改各级的逻辑尺寸，超出容量才重新分配
+    // 容量链的每一级都不小于逻辑链的对应级，逻辑链需要的级别总是已经存在
+    if (levels[0].tex == 0 || width > capW || height > capH) {
+        for (Level& level : levels) {
+            if (level.tex) {
+                glDeleteTextures(1, &level.tex);
+            }
+            level = {};
+        }
+        capW = FrameGraph::Capacity(width);
+        capH = FrameGraph::Capacity(height);
+        int w = capW, h = capH;
+        for (int k = 0; k < kMaxLevels; k++) {
+            w = std::max(1, (w + 1) / 2);
+            h = std::max(1, (h + 1) / 2);
+            if (k > kOutputLevel && std::min(w, h) < 4) {
+                break;
+            }
+            Level& level = levels[k];
+            level.capW   = w;
+            level.capH   = h;
+            glGenTextures(1, &level.tex);
+            glBindTexture(GL_TEXTURE_2D, level.tex);
+            // 不可变存储才能绑定为 image；与主 FBO 相同的紧凑 HDR 格式
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_R11F_G11F_B10F, w, h);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+    }
+
+    // level k 为源图像的 1/2^(k+1)，向上取整保证边缘像素不丢失
+    // 输出级之前的各级总是使用，更深的级别在短边小于 4 像素时停止
+    levelCount = 0;
+    int w = width, h = height;
+    for (int k = 0; k < kMaxLevels && levels[k].tex; k++) {
+        w = std::max(1, (w + 1) / 2);
+        h = std::max(1, (h + 1) / 2);
+        if (k > kOutputLevel && std::min(w, h) < 4) {
+            break;
+        }
+        levels[k].w = w;
+        levels[k].h = h;
+        levelCount++;
+    }
+}
+
+glm::vec2 Pyramid::GetResultUV(float u, float v) const {
+    const Level& out = levels[kOutputLevel];
+    if (out.capW == 0) {
+        return {u, v};
+    }
+    // 双线性采样不越过子矩形最外一圈纹素的中心
+    float maxU = (out.w - 0.5f) / out.capW;
+    float maxV = (out.h - 0.5f) / out.capH;
+    return {std::min(u * out.w / out.capW, maxU), std::min(v * out.h / out.capH, maxV)};
+}
+
+void Pyramid::AddRegion(float x, float y, float width, float height) {
+    // ImGui 的 y 轴向下，纹理的 y 轴向上；窗口坐标按源图像与窗口的比例换算
+    float sx = (float)srcW / displayW;
+    float sy = (float)srcH / displayH;
+    Rect  r;
+    r.x0 = std::max(0, (int)floorf(x * sx));
+    r.x1 = std::min(srcW, (int)ceilf((x + width) * sx));
+    r.y0 = std::max(0, srcH - (int)ceilf((y + height) * sy));
+    r.y1 = std::min(srcH, srcH - (int)floorf(y * sy));
+    if (r.Empty()) {
+        return;
+    }
+    // 与已有区域相交则合并 (两个面板重叠时只算一次)
+    for (size_t i = 0; i < regions.size(); i++) {
+        const Rect& o = regions[i];
+        if (r.x0 < o.x1 && o.x0 < r.x1 && r.y0 < o.y1 && o.y0 < r.y1) {
+            r = {std::min(r.x0, o.x0), std::min(r.y0, o.y0), std::max(r.x1, o.x1), std::max(r.y1, o.y1)};
+            regions.erase(regions.begin() + i);
+            i = (size_t)-1; // 合并后的区域可能又与之前的区域相交
+        }
+    }
+    regions.push_back(r);
+}
+
+void Pyramid::Dispatch(GLuint program, GLint offsetLoc, GLuint src, const Level& dst, const Rect& rect) {
+    if (rect.Empty()) {
+        return;
+    }
+    glUseProgram(program);
+    glUniform2i(offsetLoc, rect.x0, rect.y0);
+    glBindTexture(GL_TEXTURE_2D, src);
+    glBindImageTexture(0, dst.tex, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R11F_G11F_B10F);
+    glDispatchCompute((rect.x1 - rect.x0 + kGroupSize - 1) / kGroupSize,
+                      (rect.y1 - rect.y0 + kGroupSize - 1) / kGroupSize, 1);
+}
+
+GLuint Pyramid::Run(GLuint downProgram, GLuint upProgram, const UniformCache& uc, GLuint srcTex, int depth) {
+    if (regions.empty() || levelCount <= kOutputLevel) {
+        regions.clear();
+        return 0;
+    }
+    depth = std::clamp(depth, kOutputLevel + 1, levelCount);
+
+    // 从输出级反推每一级需要有效的范围: 输出级多留 1 纹素给 ImGui 的双线性采样
+    // 升采样逐级向下一级扩展，最深一级之后再沿降采样链扩展回 level 0
+    const int scale = 1 << (kOutputLevel + 1);
+    plans.resize(regions.size());
+    for (size_t i = 0; i < regions.size(); i++) {
+        const Rect&  r      = regions[i];
+        const Level& out    = levels[kOutputLevel];
+        Plan&        p      = plans[i];
+        Rect         padded = {r.x0 / scale - 1, r.y0 / scale - 1, (r.x1 + scale - 1) / scale + 1,
+                               (r.y1 + scale - 1) / scale + 1};
+        p.up[kOutputLevel] = Align(padded, out.w, out.h);
+        for (int k = kOutputLevel; k < depth - 1; k++) {
+            p.up[k + 1] = Align(UpSource(p.up[k]), levels[k + 1].w, levels[k + 1].h);
+        }
+        p.down[depth - 1] = p.up[depth - 1];
+        for (int k = depth - 1; k > 0; k--) {
+            p.down[k - 1] = Align(DownSource(p.down[k]), levels[k - 1].w, levels[k - 1].h);
+        }
+    }
+
+    // 先完成所有区域的降采样，再做升采样: 升采样原地覆盖，不能早于其他区域读取这一级的降采样结果
+    // 每级之后一个屏障，下一级 (以及最终的 ImGui 采样) 通过纹理读取结果
+    glActiveTexture(GL_TEXTURE0);
+    GLuint src = srcTex;
+    for (int k = 0; k < depth; k++) {
+        // level 0 的源纹理可能比源图像大 (帧图池按尺寸档位分配)，只读有效范围
+        glUseProgram(downProgram);
+        glUniform2i(uc.blurDown_uSrcMax, (k == 0 ? srcW : levels[k - 1].w) - 1, (k == 0 ? srcH : levels[k - 1].h) - 1);
+        for (const Plan& p : plans) {
+            Dispatch(downProgram, uc.blurDown_uOffset, src, levels[k], p.down[k]);
+        }
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+        src = levels[k].tex;
+    }
+    for (int k = depth - 2; k >= kOutputLevel; k--) {
+        for (const Plan& p : plans) {
+            Dispatch(upProgram, uc.blurUp_uOffset, levels[k + 1].tex, levels[k], p.up[k]);
+        }
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    }
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R11F_G11F_B10F);
+    regions.clear();
+    return levels[kOutputLevel].tex;
+}
+
+void RunBenchmark(Pyramid& pyramid, GLuint downProgram, GLuint upProgram, GLuint legacyProgram,
+                  const UniformCache& uc, GLuint vaoQuad, GLuint srcTex, int width, int height) {
+    const int kRepeats = 64;
+
+    BlurFramebuffer a, b;
+    a.Init(width / 6, height / 6);
+    b.Init(width / 6, height / 6);
+    GLuint query = 0;
+    glGenQueries(1, &query);
+
+    // 每种配置重复 kRepeats 次包在一个 GL_TIME_ELAPSED 查询里，取平均
+    auto timeMs = [&](const std::function<void()>& fn) {
+        fn(); // 预热 (着色器首次使用时驱动可能还会做额外编译)
+        glFinish();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        for (int i = 0; i < kRepeats; i++) {
+            fn();
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+        return (double)ns / 1.0e6 / kRepeats;
+    };
+
+    std::cout << "[BlurPyramid] Benchmark at " << width << "x" << height << ", " << kRepeats << " runs each"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (int s = 0; s <= 5; s++) {
+        float  strength = (float)s;
+        int    passes   = 0;
+        int    depth    = std::min(DepthForStrength(strength), pyramid.GetLevelCount());
+        double legacyMs =
+            timeMs([&] { passes = LegacyKawase(legacyProgram, uc, vaoQuad, srcTex, a, b, strength); });
+        double pyramidMs = timeMs([&] {
+            pyramid.AddRegion(0.0f, 0.0f, (float)width, (float)height);
+            pyramid.Run(downProgram, upProgram, uc, srcTex, depth);
+        });
+        // 典型情况: 只有调试面板 (450x600) 需要模糊背景
+        double panelMs = timeMs([&] {
+            pyramid.AddRegion(20.0f, 20.0f, 450.0f, 600.0f);
+            pyramid.Run(downProgram, upProgram, uc, srcTex, depth);
+        });
+        std::cout << "[BlurPyramid] strength " << s << ": kawase " << legacyMs << " ms (" << passes
+                  << " passes @1/6), pyramid " << pyramidMs << " ms full screen / " << panelMs
+                  << " ms one panel (depth " << depth << ")" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+
+    glDeleteQueries(1, &query);
+    glDeleteFramebuffers(1, &a.fbo);
+    glDeleteTextures(1, &a.tex);
+    glDeleteFramebuffers(1, &b.fbo);
+    glDeleteTextures(1, &b.tex);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+}
+
+} // namespace BlurPyramid
@@ -0,0 +1,77 @@
+#pragma once
+// 模糊金字塔 - 双重 Kawase (dual filter)：逐级降采样再逐级升采样，计算着色器 + 共享内存分块
+// 模糊半径由金字塔深度决定 (每加一级半径约翻倍)，各级像素总和不到全分辨率的 1/3，代价几乎与强度无关
+// 只计算 UI 上报的区域 (玻璃面板背后)，没有面板需要模糊背景时整个 pass 跳过
+
+#include <cstdint>
+#include <vector>
+
+struct UniformCache;
+
+namespace BlurPyramid {
+
+static constexpr int kMaxLevels   = 7;
+static constexpr int kOutputLevel = 1; // 升采样停在 1/4 分辨率 (level 0 为 1/2)，玻璃背景不需要更高精度
+static constexpr int kGroupSize   = 8; // 与着色器 local_size 一致
+
+// UI 模糊强度 (0 ~ 5) -> 金字塔深度 (3 ~ 6)
+int DepthForStrength(float strength);
+
+// 纹素矩形 [x0, x1) x [y0, y1)，OpenGL 纹理坐标 (左下角为原点)
+struct Rect {
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+
+    bool Empty() const { return x1 <= x0 || y1 <= y0; }
+};
+
+class Pyramid {
+  public:
+    // 按源图像 (主 FBO) 尺寸设置各级纹理，窗口尺寸或渲染缩放变化时重新调用
+    // 纹理按尺寸档位留有余量，逻辑尺寸只是左下角的子矩形，只有超出容量时才重新分配
+    // displayWidth / displayHeight 为 UI 坐标对应的窗口尺寸 (动态分辨率下源图像比窗口小)
+    void Init(int width, int height, int displayWidth, int displayHeight);
+
+    // UI 构建时上报需要模糊背景的矩形 (ImGui 屏幕坐标，左上角为原点)，每帧 Run 后清空
+    void AddRegion(float x, float y, float width, float height);
+    void ClearRegions() { regions.clear(); }
+    bool HasRegions() const { return !regions.empty(); }
+
+    // srcTex -> 降采样 depth 级 -> 升采样回 kOutputLevel，只覆盖本帧上报的区域
+    // 须在 UI 构建之后、绘制 UI 之前调用；没有区域时直接返回 0 (GL 线程)
+    GLuint Run(GLuint downProgram, GLuint upProgram, const UniformCache& uc, GLuint srcTex, int depth);
+
+    // 结果纹理 (固定为 kOutputLevel 级，供 ImGui 背景直接引用)
+    GLuint GetResult() const { return levels[kOutputLevel].tex; }
+    int    GetLevelCount() const { return levelCount; }
+
+    // 结果的归一化坐标 (0 ~ 1 对应逻辑尺寸) 换算为结果纹理的采样坐标
+    glm::vec2 GetResultUV(float u, float v) const;
+
+  private:
+    struct Level {
+        GLuint tex = 0;
+        int    w = 0, h = 0;       // 逻辑尺寸
+        int    capW = 0, capH = 0; // 分配尺寸
+    };
+    // 每个区域在各级需要有效的范围 (由输出级反推)
+    struct Plan {
+        Rect up[kMaxLevels];   // 升采样写入范围 (最深一级为降采样结果)
+        Rect down[kMaxLevels]; // 降采样写入范围
+    };
+    Level             levels[kMaxLevels];
+    int               levelCount = 0;
+    int               srcW = 0, srcH = 0;
+    int               capW = 0, capH = 0; // 各级容量对应的源尺寸 (超出时重新分配)
+    int               displayW = 0, displayH = 0;
+    std::vector<Rect> regions; // 源分辨率下的待模糊区域
+    std::vector<Plan> plans;
+
+    void Dispatch(GLuint program, GLint offsetLoc, GLuint src, const Level& dst, const Rect& rect);
+};
+
+// --bench-blur: 用 GPU 计时查询对比新实现与旧的 1/6 分辨率 Kawase ping-pong 在各模糊强度下的耗时，结果输出到日志
+// 旧实现 (帧缓冲和着色器 pBlur) 只为这个对比保留，主渲染路径不再使用
+void RunBenchmark(Pyramid& pyramid, GLuint downProgram, GLuint upProgram, GLuint legacyProgram,
+                  const UniformCache& uc, GLuint vaoQuad, GLuint srcTex, int width, int height);
+
+} // namespace BlurPyramid
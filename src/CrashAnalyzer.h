@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "BlurPyramid.h"
 #include "Localization.h"
 #include "md3/MD3.h"
 
@@ -358,7 +359,7 @@ inline void HandleFileDrop(const char* path) {
 }
 
 // Render crash analyzer window with optional blur background
-inline void Render(bool enableBlur = false, unsigned int blurTex = 0, unsigned int scrWidth = 0,
+inline void Render(bool enableBlur = false, BlurPyramid::Pyramid* blur = nullptr, unsigned int scrWidth = 0,
                    unsigned int scrHeight = 0, bool isDarkMode = true) {
     if (!g_state.windowOpen) {
         return;
@@ -383,10 +384,13 @@ inline void Render(bool enableBlur = false, unsigned int blurTex = 0, unsigned i
         ImVec2      size = ImGui::GetWindowSize();
         ImDrawList* dl   = ImGui::GetWindowDrawList();
 
-        if (enableBlur && blurTex != 0 && scrWidth > 0 && scrHeight > 0) {
+        if (enableBlur && blur && blur->GetResult() != 0 && scrWidth > 0 && scrHeight > 0) {
+            // Request the blurred backdrop only for this window's rectangle
+            blur->AddRegion(pos.x, pos.y, size.x, size.y);
             ImVec2 uv0 = ImVec2(pos.x / scrWidth, 1.0f - pos.y / scrHeight);
             ImVec2 uv1 = ImVec2((pos.x + size.x) / scrWidth, 1.0f - (pos.y + size.y) / scrHeight);
-            dl->AddImage((ImTextureID)(intptr_t)blurTex, pos, ImVec2(pos.x + size.x, pos.y + size.y), uv0, uv1);
+            dl->AddImage((ImTextureID)(intptr_t)blur->GetResult(), pos, ImVec2(pos.x + size.x, pos.y + size.y), uv0,
+                         uv1);
             ImU32 tintColor = isDarkMode ? IM_COL32(20, 20, 25, 180) : IM_COL32(245, 245, 255, 150);
             dl->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), tintColor, style.WindowRounding);
             ImU32 highlight = isDarkMode ? IM_COL32(255, 255, 255, 40) : IM_COL32(255, 255, 255, 120);
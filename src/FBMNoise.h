@@ -0,0 +1,42 @@
+#pragma once
+// FBM 噪声生成 - 整数哈希值噪声，AVX2/SSE4.1/标量三套实现，按行多线程并行
+// 晶格坐标可按周期回绕生成无缝平铺纹理，结果按参数哈希缓存到磁盘
+
+#include <cstdint>
+#include <vector>
+
+namespace FBMNoise {
+
+static constexpr int kMaxOctaves = 12;
+
+// 生成参数 (全部参与缓存键)
+struct Params {
+    int      width     = 512;
+    int      height    = 512;
+    int      octaves   = 5;    // 叠加层数 (1 ~ kMaxOctaves)
+    int      frequency = 16;   // 第一层横/纵向晶格数，整数保证平铺周期对齐
+    bool     tileable  = true; // 晶格按周期回绕，纹理上下左右无缝
+    uint32_t seed      = 0;
+};
+
+// SIMD 实现级别 (与 HandTracker 的 SIMDMode 用法一致: Auto 自动选择，强制级别不可用时逐级回退)
+enum class SIMDLevel { Auto, AVX2, SSE41, Scalar };
+
+// 生成 R8 噪声数据 (纯 CPU，可在工作线程调用)
+// threads: 工作线程数，0 表示使用全部硬件线程；结果与线程数和 SIMD 级别无关
+std::vector<unsigned char> Generate(const Params& params, SIMDLevel level = SIMDLevel::Auto, int threads = 0);
+
+// 带磁盘缓存的生成: 命中时直接读取 %LOCALAPPDATA%\ParticleSaturn\NoiseCache 下的缓存文件
+std::vector<unsigned char> GenerateCached(const Params& params);
+
+// 旧实现 (sinf 哈希、单线程、不可平铺)，仅用于基准对比
+std::vector<unsigned char> GenerateReference(int width, int height);
+
+// 当前 CPU 支持的最佳级别
+SIMDLevel   GetBestLevel();
+const char* GetLevelName(SIMDLevel level);
+
+// 微基准: 对比旧实现与各 SIMD 级别、单线程与多线程的耗时，并校验各级别输出一致 (--bench-fbm)
+void RunBenchmark();
+
+} // namespace FBMNoise
@@ -0,0 +1,110 @@
+// FillBudget.cpp - 点径预算实现
+
+#include "pch.h"
+
+#include "FillBudget.h"
+
+#include <cmath>
+
+namespace FillBudget {
+
+void Controller::Init() {
+    for (QueryFrame& q : queries) {
+        glGenQueries(1, &q.samples);
+        glGenQueries(1, &q.time);
+    }
+}
+
+uint8_t Controller::Encode(float value, float max) {
+    return (uint8_t)std::clamp((int)std::lround(value / max * 255.0f), 1, 255);
+}
+
+void Controller::BeginFrame(int pixels, bool frozen) {
+    current       = (current + 1) % kQueryFrames;
+    QueryFrame& q = queries[current];
+    if (q.pending) {
+        q.pending = false;
+        // 结果还没出来就放弃这一帧的样本，绝不等待 GPU
+        GLint available = 0;
+        glGetQueryObjectiv(q.time, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 samples = 0, ns = 0;
+            glGetQueryObjectui64v(q.samples, GL_QUERY_RESULT, &samples);
+            glGetQueryObjectui64v(q.time, GL_QUERY_RESULT, &ns);
+            Update((double)samples, (double)ns / 1.0e6, q.pixels, frozen);
+        }
+    }
+    q.pixels = pixels;
+    measured = false;
+}
+
+void Controller::BeginMeasure() {
+    QueryFrame& q = queries[current];
+    if (measured || !q.samples) {
+        return;
+    }
+    glBeginQuery(GL_SAMPLES_PASSED, q.samples);
+    glBeginQuery(GL_TIME_ELAPSED, q.time);
+    measuring = true;
+}
+
+void Controller::EndMeasure() {
+    if (!measuring) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glEndQuery(GL_SAMPLES_PASSED);
+    queries[current].pending = true;
+    measuring                = false;
+    measured                 = true;
+}
+
+void Controller::SetCodes(uint8_t sizeByte, uint8_t densityByte) {
+    sizeCode           = sizeByte;
+    densityCode        = densityByte;
+    sizeMax            = DecodeSize(sizeCode);
+    density            = DecodeDensity(densityCode);
+    stats.pointSizeMax = sizeMax;
+    stats.density      = density;
+}
+
+void Controller::Update(double fragments, double ms, int pixels, bool frozen) {
+    stats.fragments = fragments;
+    stats.fillMs    = ms;
+    stats.overdraw  = pixels > 0 ? fragments / pixels : 0.0;
+
+    // 每片段开销: 片段很少时计时主要是固定开销，不更新
+    if (fragments >= 10000.0) {
+        double ns        = std::max(ms * 1.0e6 / fragments, (double)kMinFragmentNs);
+        stats.fragmentNs = stats.fragmentNs > 0.0 ? stats.fragmentNs + (ns - stats.fragmentNs) * 0.1 : ns;
+    }
+    stats.allowed = stats.fragmentNs > 0.0 ? kBudgetMs * 1.0e6 / stats.fragmentNs : fragments * kRelaxRatio * 2.0;
+    double ratio  = stats.allowed / std::max(fragments, 1.0);
+    overBudget    = ratio < 1.0;
+    if (frozen) {
+        return;
+    }
+
+    if (overBudget) {
+        // 收紧: 每帧最多 10%，先稀疏大粒子，到下限后再缩小点径上限 (片段数约与点径平方成正比)
+        float step = (float)std::max(ratio, 0.9);
+        if (density > kMinDensity) {
+            density = std::max(kMinDensity, density * step);
+        } else {
+            sizeMax = std::max(kMinPointSize, sizeMax * sqrtf(step));
+        }
+    } else if (ratio > kRelaxRatio) {
+        // 放宽: 顺序与收紧相反，先恢复点径再恢复密度
+        if (sizeMax < kMaxPointSize) {
+            sizeMax = std::min(kMaxPointSize, sizeMax * 1.02f);
+        } else {
+            density = std::min(1.0f, density + 0.01f);
+        }
+    }
+    sizeCode           = Encode(sizeMax, kMaxPointSize);
+    densityCode        = Encode(density, 1.0f);
+    stats.pointSizeMax = GetPointSizeMax();
+    stats.density      = GetLargeDensity();
+}
+
+} // namespace FillBudget
@@ -0,0 +1,82 @@
+#pragma once
+// 点径预算 - 按实测的填充开销限制土星点精灵的点径，近景少量巨大的加法混合粒子不再拖垮帧率
+// 点精灵绘制外包一对查询: GL_SAMPLES_PASSED (写入的片段数，即过绘制) 和 GL_TIME_ELAPSED，
+// 几帧后非阻塞读取，得到每个片段的平均开销，再由填充预算推出本帧允许的片段数
+// 超出时先按序号哈希稀疏大粒子 (保留的粒子提高不透明度，总亮度不变)，再收紧点径上限；
+// 两者都到下限后才轮到 LOD 减少粒子数。回放时使用日志中记录的预算
+
+#include <cstdint>
+
+namespace FillBudget {
+
+static constexpr int   kQueryFrames   = 4;      // 查询轮转帧数 (结果延迟几帧读取，绝不等待 GPU)
+static constexpr float kBudgetMs      = 5.0f;   // 点精灵填充的 GPU 时间预算 (约为 60 Hz 帧时间的三分之一)
+static constexpr float kRelaxRatio    = 1.3f;   // 允许片段数超过实际片段数该倍数时才放宽 (滞后区间)
+static constexpr float kMaxPointSize  = 300.0f; // 点径上限的初始值和最大值 (1080p 像素，与原来的固定上限一致)
+static constexpr float kMinPointSize  = 64.0f;  // 点径上限的下限
+static constexpr float kMinDensity    = 0.35f;  // 大粒子保留比例的下限
+static constexpr float kMinFragmentNs = 0.01f;  // 每片段开销的下限 (避免片段很少时的计时噪声放大预算)
+
+struct Stats {
+    double overdraw     = 0.0; // 点精灵片段数 / 渲染目标像素数
+    double fillMs       = 0.0; // 点精灵绘制的 GPU 时间
+    double fragmentNs   = 0.0; // 每片段平均开销 (平滑)
+    double fragments    = 0.0; // 本次测量的片段数
+    double allowed      = 0.0; // 预算允许的片段数
+    float  pointSizeMax = kMaxPointSize;
+    float  density      = 1.0f;
+};
+
+class Controller {
+  public:
+    // 创建查询对象 (GL 线程)
+    void Init();
+
+    // 每帧开始: 读取已完成的最早一组查询并更新预算；pixels 为渲染目标像素数
+    // frozen 时只读取统计不调整预算 (回放使用日志中的预算)
+    void BeginFrame(int pixels, bool frozen);
+
+    // 包住点精灵绘制；每帧只测量第一次 (基准测试同一帧内会重复绘制)
+    void BeginMeasure();
+    void EndMeasure();
+
+    // 当前预算 (已按日志精度量化，录制与回放结果一致)
+    float GetPointSizeMax() const { return DecodeSize(sizeCode); }
+    float GetLargeDensity() const { return DecodeDensity(densityCode); }
+
+    // 填充超出预算且还能继续收紧: LOD 暂缓减少粒子数
+    bool IsLimiting() const { return overBudget && (density > kMinDensity || sizeMax > kMinPointSize); }
+
+    // 录制/回放 (0 表示旧日志中未记录，按不限制处理)
+    uint8_t GetSizeCode() const { return sizeCode; }
+    uint8_t GetDensityCode() const { return densityCode; }
+    void    SetCodes(uint8_t sizeByte, uint8_t densityByte);
+
+    const Stats& GetStats() const { return stats; }
+
+  private:
+    static float   DecodeSize(uint8_t code) { return code ? kMaxPointSize * code / 255.0f : kMaxPointSize; }
+    static float   DecodeDensity(uint8_t code) { return code ? code / 255.0f : 1.0f; }
+    static uint8_t Encode(float value, float max);
+
+    struct QueryFrame {
+        GLuint samples = 0, time = 0;
+        bool   pending = false;
+        int    pixels  = 0;
+    };
+
+    void Update(double fragments, double ms, int pixels, bool frozen);
+
+    QueryFrame queries[kQueryFrames];
+    int        current     = 0;
+    bool       measuring   = false;
+    bool       measured    = false; // 本帧已测量
+    bool       overBudget  = false;
+    float      sizeMax     = kMaxPointSize;
+    float      density     = 1.0f;
+    uint8_t    sizeCode    = 255;
+    uint8_t    densityCode = 255;
+    Stats      stats;
+};
+
+} // namespace FillBudget
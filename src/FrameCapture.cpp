@@ -0,0 +1,351 @@
+// FrameCapture.cpp - 帧捕获实现
+
+#include "pch.h"
+
+#include "FrameCapture.h"
+
+#include <stb_image_write.h>
+
+#include <cctype>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+
+namespace FrameCapture {
+
+namespace {
+
+// YUV4MPEG2，4:4:4 不降采样 (BT.601 有限范围)
+class Y4mEncoder : public Encoder {
+  public:
+    Y4mEncoder(const std::string& path, int frameRate) : file(path, std::ios::binary), fps(frameRate) {}
+
+    bool IsOpen() const { return file.is_open(); }
+
+    bool WriteFrame(const uint8_t* rgb, int width, int height, int repeat) override {
+        if (w == 0) {
+            w = width;
+            h = height;
+            file << "YUV4MPEG2 W" << w << " H" << h << " F" << fps << ":1 Ip A1:1 C444\n";
+            planes.resize((size_t)w * h * 3);
+        }
+        if (width != w || height != h) {
+            return false;
+        }
+        size_t   count = (size_t)w * h;
+        uint8_t* y     = planes.data();
+        uint8_t* u     = y + count;
+        uint8_t* v     = u + count;
+        for (size_t i = 0; i < count; i++) {
+            int r = rgb[i * 3], g = rgb[i * 3 + 1], b = rgb[i * 3 + 2];
+            y[i]  = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            u[i]  = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            v[i]  = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+        for (int k = 0; k < repeat; k++) {
+            file << "FRAME\n";
+            file.write((const char*)planes.data(), (std::streamsize)planes.size());
+        }
+        return file.good();
+    }
+
+  private:
+    std::ofstream        file;
+    int                  fps = kDefaultVideoFps;
+    int                  w = 0, h = 0;
+    std::vector<uint8_t> planes;
+};
+
+// PNG 序列: prefix_000000.png, prefix_000001.png, ...
+class PngSequenceEncoder : public Encoder {
+  public:
+    explicit PngSequenceEncoder(const std::string& pathPrefix) : prefix(pathPrefix) {}
+
+    bool WriteFrame(const uint8_t* rgb, int width, int height, int repeat) override {
+        for (int k = 0; k < repeat; k++) {
+            char suffix[32];
+            snprintf(suffix, sizeof(suffix), "_%06llu.png", (unsigned long long)index++);
+            if (!stbi_write_png((prefix + suffix).c_str(), width, height, 3, rgb, width * 3)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    std::string prefix;
+    uint64_t    index = 0;
+};
+
+} // namespace
+
+std::unique_ptr<Encoder> CreateEncoder(const std::string& path, int fps) {
+    std::string ext = path.size() >= 4 ? path.substr(path.size() - 4) : "";
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)tolower(c); });
+    if (ext == ".y4m") {
+        auto encoder = std::make_unique<Y4mEncoder>(path, fps);
+        if (!encoder->IsOpen()) {
+            return nullptr;
+        }
+        return encoder;
+    }
+    return std::make_unique<PngSequenceEncoder>(path);
+}
+
+std::string TimestampedPath(const char* prefix, const char* extension) {
+    std::time_t now = std::time(nullptr);
+    std::tm     local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "_%Y%m%d_%H%M%S", &local);
+    return std::string(prefix) + stamp + extension;
+}
+
+void Capturer::Init() {
+    worker = std::thread(&Capturer::WorkerLoop, this);
+}
+
+void Capturer::Shutdown() {
+    if (!worker.joinable()) {
+        return;
+    }
+    StopVideo();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+void Capturer::RequestScreenshot(const std::string& path) {
+    pendingScreenshot = path;
+}
+
+bool Capturer::StartVideo(const std::string& path, int fps) {
+    std::unique_ptr<Encoder> encoder = CreateEncoder(path, fps);
+    if (!encoder) {
+        std::cerr << "[FrameCapture] Cannot open " << path << std::endl;
+        return false;
+    }
+    Job job;
+    job.begin = std::move(encoder);
+    Push(std::move(job));
+    recording  = true;
+    videoFps   = std::clamp(fps, 1, 240);
+    videoStart = -1.0;
+    videoTaken = 0;
+    maxQueued  = 0;
+    std::cout << "[FrameCapture] Recording " << path << " at " << videoFps << " FPS" << std::endl;
+    return true;
+}
+
+void Capturer::StopVideo() {
+    if (!recording) {
+        return;
+    }
+    Job job;
+    job.end = true;
+    Push(std::move(job));
+    recording = false;
+    std::cout << "[FrameCapture] Recording stopped (" << videoTaken << " frames scheduled, " << dropped.load()
+              << " dropped)" << std::endl;
+}
+
+bool Capturer::WantsFrame(double time) {
+    videoDue = 0;
+    if (recording) {
+        if (videoStart < 0.0) {
+            videoStart = time;
+        }
+        // 到本帧为止应有的视频帧数；长时间没有渲染 (例如最小化) 时最多补一秒
+        uint64_t target = (uint64_t)((time - videoStart) * videoFps) + 1;
+        if (target > videoTaken) {
+            videoDue   = (int)std::min<uint64_t>(target - videoTaken, (uint64_t)videoFps);
+            videoTaken = target;
+        }
+    }
+    return videoDue > 0 || !pendingScreenshot.empty();
+}
+
+void Capturer::Readback(int width, int height) {
+    if (videoDue == 0 && pendingScreenshot.empty()) {
+        return;
+    }
+    int index = -1;
+    for (int i = 0; i < kRingSize && index < 0; i++) {
+        int candidate = (next + i) % kRingSize;
+        if (slots[candidate].state.load(std::memory_order_acquire) == kFree) {
+            index = candidate;
+        }
+    }
+    if (index < 0) {
+        // 编码跟不上: 丢弃本帧的视频帧，截图留到下一帧
+        dropped += videoDue;
+        videoDue = 0;
+        return;
+    }
+    next = (index + 1) % kRingSize;
+
+    // 容量不够时重建 (只在第一次或窗口变大时发生)；持久映射，编码线程直接读取
+    Slot&  slot  = slots[index];
+    size_t bytes = (size_t)width * height * 4;
+    if (slot.capacity < bytes) {
+        if (slot.buffer) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+        GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &slot.buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        glBufferStorage(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)bytes, nullptr, flags);
+        slot.mapped   = (uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)bytes, flags);
+        slot.capacity = slot.mapped ? bytes : 0;
+        if (!slot.mapped) {
+            std::cerr << "[FrameCapture] Failed to map readback buffer (" << width << "x" << height << ")"
+                      << std::endl;
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            dropped += videoDue;
+            videoDue = 0;
+            return;
+        }
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence      = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.width      = width;
+    slot.height     = height;
+    slot.repeat     = videoDue;
+    slot.screenshot = std::move(pendingScreenshot);
+    pendingScreenshot.clear();
+    slot.state.store(kReading, std::memory_order_relaxed);
+    reading.push_back(index);
+    videoDue = 0;
+}
+
+void Capturer::Poll() {
+    // 按提交顺序检查围栏，第一个未完成的之后都不检查 (视频帧保持顺序)
+    while (!reading.empty()) {
+        Slot&  slot   = slots[reading.front()];
+        GLenum status = glClientWaitSync(slot.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        slot.state.store(kEncoding, std::memory_order_relaxed);
+        queued++;
+        Job job;
+        job.slot = reading.front();
+        Push(std::move(job));
+        reading.pop_front();
+    }
+    maxQueued = std::max(maxQueued, (int)reading.size() + queued.load());
+}
+
+Stats Capturer::GetStats() const {
+    Stats s;
+    s.recording   = recording;
+    s.captured    = captured.load();
+    s.dropped     = dropped.load();
+    s.inFlight    = (int)reading.size();
+    s.queued      = queued.load();
+    s.maxQueued   = maxQueued;
+    s.encodeMs    = encodeMs.load();
+    s.screenshots = screenshots.load();
+    return s;
+}
+
+void Capturer::Push(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+void Capturer::WorkerLoop() {
+    std::unique_ptr<Encoder> encoder;
+    std::vector<uint8_t>     rgb;
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                break;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        if (job.begin) {
+            if (encoder) {
+                encoder->Finish();
+            }
+            encoder = std::move(job.begin);
+        } else if (job.end) {
+            if (encoder) {
+                encoder->Finish();
+                encoder.reset();
+            }
+        } else {
+            Encode(slots[job.slot], encoder.get(), rgb);
+        }
+    }
+    if (encoder) {
+        encoder->Finish();
+    }
+}
+
+void Capturer::Encode(Slot& slot, Encoder* encoder, std::vector<uint8_t>& rgb) {
+    auto start = std::chrono::steady_clock::now();
+
+    // 读回的行序自下而上且带 alpha: 翻转并转成紧密排列的 RGB
+    int w = slot.width, h = slot.height;
+    rgb.resize((size_t)w * h * 3);
+    for (int y = 0; y < h; y++) {
+        const uint8_t* src = slot.mapped + (size_t)(h - 1 - y) * w * 4;
+        uint8_t*       dst = rgb.data() + (size_t)y * w * 3;
+        for (int x = 0; x < w; x++) {
+            dst[x * 3]     = src[x * 4];
+            dst[x * 3 + 1] = src[x * 4 + 1];
+            dst[x * 3 + 2] = src[x * 4 + 2];
+        }
+    }
+    // 映射内存已经读完，段可以重新用于读回
+    int         repeat     = slot.repeat;
+    std::string screenshot = std::move(slot.screenshot);
+    slot.screenshot.clear();
+    slot.state.store(kFree, std::memory_order_release);
+
+    if (repeat > 0) {
+        if (encoder && encoder->WriteFrame(rgb.data(), w, h, repeat)) {
+            captured += repeat;
+        } else {
+            dropped += repeat;
+        }
+    }
+    if (!screenshot.empty()) {
+        if (stbi_write_png(screenshot.c_str(), w, h, 3, rgb.data(), w * 3)) {
+            screenshots++;
+            std::cout << "[FrameCapture] Screenshot saved: " << screenshot << std::endl;
+        } else {
+            std::cerr << "[FrameCapture] Failed to write " << screenshot << std::endl;
+        }
+    }
+
+    double ms  = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double avg = encodeMs.load();
+    encodeMs.store(avg > 0.0 ? avg + (ms - avg) * 0.1 : ms);
+    queued--;
+}
+
+} // namespace FrameCapture
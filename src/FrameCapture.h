@@ -0,0 +1,125 @@
+#pragma once
+// 帧捕获 - 截图和视频录制，不阻塞渲染线程
+// 合成之后 (UI 之前) 把默认帧缓冲 glReadPixels 到 PBO 环中的一段并插入围栏，之后每帧只检查围栏 (超时 0)
+// PBO 为持久映射 (GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)，完成的段直接交给编码线程读取，渲染线程不做拷贝
+// 编码线程翻转行序、去掉 alpha 后写 PNG 截图或交给视频编码器 (Y4M / PNG 序列，可扩展)
+// 所有段都在读回或编码中 (编码跟不上) 时丢弃该帧并计数；视频按固定帧率采样，渲染慢于采样率时重复写入同一帧，时间轴不变
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace FrameCapture {
+
+static constexpr int kRingSize        = 6;  // PBO 段数 (GPU 读回中 + 排队 + 编码中)，也是队列深度的上限
+static constexpr int kDefaultVideoFps = 30; // 视频采样帧率
+
+// 视频编码器接口: 输入为自上而下、紧密排列的 RGB8 图像 (编码线程调用)
+class Encoder {
+  public:
+    virtual ~Encoder() = default;
+
+    // 写入一帧 repeat 次 (渲染慢于采样率时补帧)，失败 (例如尺寸与第一帧不同) 返回 false
+    virtual bool WriteFrame(const uint8_t* rgb, int width, int height, int repeat) = 0;
+    virtual void Finish() {}
+};
+
+// 按路径选择编码器: *.y4m 为 YUV4MPEG2 (4:4:4，可直接交给 ffmpeg)，其他视为 PNG 序列的文件名前缀
+std::unique_ptr<Encoder> CreateEncoder(const std::string& path, int fps);
+
+// 当前目录下带时间戳的文件名，例如 screenshot_20250101_120000.png
+std::string TimestampedPath(const char* prefix, const char* extension);
+
+struct Stats {
+    bool     recording   = false;
+    uint64_t captured    = 0;   // 编码完成的帧数 (视频帧按采样计，含补帧)
+    uint64_t dropped     = 0;   // 没有空闲的段或编码失败而丢弃的帧数
+    int      inFlight    = 0;   // GPU 读回中的段数
+    int      queued      = 0;   // 等待或正在编码的帧数
+    int      maxQueued   = 0;   // 录制开始以来的最大队列深度 (inFlight + queued)
+    double   encodeMs    = 0.0; // 每帧编码耗时 (平滑)
+    uint64_t screenshots = 0;
+};
+
+class Capturer {
+  public:
+    // 启动编码线程 (GL 资源在第一次读回时按帧缓冲尺寸创建)
+    void Init();
+
+    // 停止录制、等待编码线程处理完已完成读回的帧后退出 (须在 GL 上下文销毁之前调用)
+    void Shutdown();
+
+    // 下一次读回的帧保存为 PNG
+    void RequestScreenshot(const std::string& path);
+
+    // 开始 / 停止录制视频 (从下一帧开始按 fps 采样)
+    bool StartVideo(const std::string& path, int fps);
+    void StopVideo();
+    bool IsRecording() const { return recording; }
+
+    // 本帧是否需要读回 (有截图请求，或到了视频的采样时间)
+    // time 为帧时间 (回放时取日志中的时间，视频的采样与录制时一致)
+    bool WantsFrame(double time);
+
+    // 读回当前绑定的默认帧缓冲 (capture pass 中调用，GL 线程)；没有空闲的段时丢弃
+    void Readback(int width, int height);
+
+    // 每帧调用: 检查围栏，完成读回的段交给编码线程 (从不等待 GPU)
+    void Poll();
+
+    Stats GetStats() const;
+
+  private:
+    enum SlotState : int { kFree, kReading, kEncoding };
+
+    struct Slot {
+        GLuint           buffer   = 0;
+        uint8_t*         mapped   = nullptr;
+        size_t           capacity = 0;
+        GLsync           fence    = nullptr;
+        std::atomic<int> state{kFree};
+        int              width = 0, height = 0;
+        int              repeat = 0; // 视频写入次数 (0 表示不属于视频)
+        std::string      screenshot; // 截图路径 (空表示没有截图)
+    };
+
+    // 编码线程的任务: 一帧图像，或开始 / 结束录制
+    struct Job {
+        int                      slot = -1;
+        std::unique_ptr<Encoder> begin; // 非空: 切换到这个编码器
+        bool                     end = false;
+    };
+
+    void Push(Job job);
+    void WorkerLoop();
+    void Encode(Slot& slot, Encoder* encoder, std::vector<uint8_t>& rgb);
+
+    Slot            slots[kRingSize];
+    std::deque<int> reading;  // GPU 读回中的段 (按提交顺序，完成后依次交给编码线程)
+    int             next = 0; // 下一次读回优先尝试的段
+    std::string     pendingScreenshot;
+    bool            recording  = false;
+    int             videoFps   = kDefaultVideoFps;
+    double          videoStart = -1.0; // 第一次采样的帧时间 (< 0 表示下一帧开始)
+    uint64_t        videoTaken = 0;    // 已经安排读回的视频帧数 (含补帧)
+    int             videoDue   = 0;    // 本帧需要写入的视频帧数
+
+    std::thread             worker;
+    std::mutex              mutex;
+    std::condition_variable wake;
+    std::deque<Job>         jobs;
+    bool                    stopping = false;
+
+    std::atomic<uint64_t> captured{0}, dropped{0}, screenshots{0};
+    std::atomic<int>      queued{0};
+    std::atomic<double>   encodeMs{0.0}; // 只由编码线程写入
+    int                   maxQueued = 0;
+};
+
+} // namespace FrameCapture
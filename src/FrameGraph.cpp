@@ -0,0 +1,333 @@
+// FrameGraph.cpp - 帧图实现
+
+#include "pch.h"
+
+#include "FrameGraph.h"
+
+namespace FrameGraph {
+
+int Capacity(int size) {
+    size = std::max(1, size);
+    return (size + size / kHeadroomDiv + kSizeAlign - 1) / kSizeAlign * kSizeAlign;
+}
+
+namespace {
+
+// 池纹理能否承载该请求: 格式一致、容量足够，且不会为很小的请求占用过大的纹理
+bool Fits(const TextureDesc& capacity, const TextureDesc& desc) {
+    if (capacity.format != desc.format || capacity.depthStencil != desc.depthStencil ||
+        capacity.width < desc.width || capacity.height < desc.height) {
+        return false;
+    }
+    int64_t area    = (int64_t)capacity.width * capacity.height;
+    int64_t request = (int64_t)std::max(1, desc.width) * std::max(1, desc.height);
+    return area <= request * kMaxWaste ||
+           (capacity.width <= Capacity(desc.width) && capacity.height <= Capacity(desc.height));
+}
+
+} // namespace
+
+Graph::Node& Graph::Node::Read(ResourceId id) {
+    if (readCount < kMaxPassEdges) {
+        reads[readCount++] = id;
+    }
+    return *this;
+}
+
+Graph::Node& Graph::Node::Write(ResourceId id) {
+    if (writeCount < kMaxPassEdges) {
+        writes[writeCount++] = id;
+    }
+    return *this;
+}
+
+ResourceId Graph::CreateTexture(const char* name, const TextureDesc& desc) {
+    Resource r;
+    r.name      = name;
+    r.desc      = desc;
+    r.transient = true;
+    resources.push_back(r);
+    return (ResourceId)resources.size() - 1;
+}
+
+ResourceId Graph::Import(const char* name, GLuint texture, GLuint framebuffer, bool retained) {
+    Resource r;
+    r.name        = name;
+    r.retained    = retained;
+    r.texture     = texture;
+    r.framebuffer = framebuffer;
+    resources.push_back(r);
+    return (ResourceId)resources.size() - 1;
+}
+
+PassId Graph::AddPass(const char* name, std::function<void()> execute) {
+    passes.push_back({name, std::move(execute)});
+    PassStats s;
+    s.name = name;
+    stats.push_back(s);
+    return (PassId)passes.size() - 1;
+}
+
+void Graph::SetDesc(ResourceId id, const TextureDesc& desc) {
+    resources[id].desc = desc;
+}
+
+void Graph::SetImported(ResourceId id, GLuint texture, GLuint framebuffer) {
+    resources[id].texture     = texture;
+    resources[id].framebuffer = framebuffer;
+}
+
+int Graph::Acquire(const TextureDesc& desc) {
+    // 可用的池纹理中取容量最小的一个 (同尺寸的请求总是命中同一个)
+    int     best     = -1;
+    int64_t bestArea = 0;
+    for (size_t i = 0; i < pool.size(); i++) {
+        const TextureDesc& c    = pool[i].desc;
+        int64_t            area = (int64_t)c.width * c.height;
+        if (!pool[i].inUse && Fits(c, desc) && (best < 0 || area < bestArea)) {
+            best     = (int)i;
+            bestArea = area;
+        }
+    }
+    if (best >= 0) {
+        pool[best].inUse         = true;
+        pool[best].usedThisFrame = true;
+        return best;
+    }
+
+    Physical p;
+    p.desc        = desc;
+    p.desc.width  = Capacity(desc.width);
+    p.desc.height = Capacity(desc.height);
+    glGenTextures(1, &p.texture);
+    glBindTexture(GL_TEXTURE_2D, p.texture);
+    // 不可变存储: 同一纹理既可作为渲染目标也可绑定为计算着色器的 image
+    glTexStorage2D(GL_TEXTURE_2D, 1, desc.format, p.desc.width, p.desc.height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glGenFramebuffers(1, &p.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, p.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, p.texture, 0);
+    if (desc.depthStencil) {
+        glGenRenderbuffers(1, &p.depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, p.depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, p.desc.width, p.desc.height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, p.depth);
+    }
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "[FrameGraph] FBO incomplete (" << p.desc.width << "x" << p.desc.height << "), status: 0x"
+                  << std::hex << status << std::dec << std::endl;
+        glDeleteFramebuffers(1, &p.framebuffer);
+        glDeleteTextures(1, &p.texture);
+        if (p.depth) {
+            glDeleteRenderbuffers(1, &p.depth);
+        }
+        return -1;
+    }
+
+    std::cout << "[FrameGraph] Pool allocated " << p.desc.width << "x" << p.desc.height << " for " << desc.width
+              << "x" << desc.height << (desc.depthStencil ? " + depth" : "") << " (" << pool.size() + 1
+              << " targets)" << std::endl;
+    p.inUse         = true;
+    p.usedThisFrame = true;
+    pool.push_back(p);
+    allocations++;
+    return (int)pool.size() - 1;
+}
+
+bool Graph::Prewarm(ResourceId id) {
+    int index = Acquire(resources[id].desc);
+    if (index < 0) {
+        return false;
+    }
+    pool[index].inUse = false;
+    return true;
+}
+
+void Graph::TrimPool() {
+    // 连续闲置太久，或者已经没有任何资源能用上这个容量 (例如窗口缩小很多后的旧尺寸) 的纹理立即释放
+    for (size_t i = 0; i < pool.size();) {
+        Physical& p  = pool[i];
+        p.idleFrames = p.usedThisFrame ? 0 : p.idleFrames + 1;
+        bool wanted  = false;
+        for (const Resource& r : resources) {
+            wanted = wanted || (r.transient && Fits(p.desc, r.desc));
+        }
+        if (!p.inUse && (!wanted || p.idleFrames > kPoolIdleFrames)) {
+            glDeleteFramebuffers(1, &p.framebuffer);
+            glDeleteTextures(1, &p.texture);
+            if (p.depth) {
+                glDeleteRenderbuffers(1, &p.depth);
+            }
+            pool.erase(pool.begin() + i);
+            continue;
+        }
+        p.usedThisFrame = false;
+        i++;
+    }
+}
+
+void Graph::BeginFrame() {
+    // 在帧开始时整理池: 上一帧的池索引到这里才失效
+    TrimPool();
+    nodeCount = 0;
+}
+
+Graph::Node& Graph::Use(PassId pass) {
+    if (nodeCount == (int)nodes.size()) {
+        nodes.emplace_back();
+    }
+    Node& n = nodes[nodeCount++];
+    n       = Node();
+    n.pass  = pass;
+    return n;
+}
+
+void Graph::ReadTimers(TimerFrame& timer) {
+    if (!timer.pending) {
+        return;
+    }
+    timer.pending = false;
+    // 结果还没出来就放弃这一帧的样本，绝不等待 GPU
+    GLint available = 0;
+    glGetQueryObjectiv(timer.queries[timer.count * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return;
+    }
+    // 整帧耗时取各 pass 之和: pass 之间 (以及帧首尾) GPU 等待 CPU 提交的空闲不计入
+    double total = 0.0;
+    for (int k = 0; k < timer.count; k++) {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(timer.queries[k * 2], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(timer.queries[k * 2 + 1], GL_QUERY_RESULT, &end);
+        float      ms = (float)((double)(end - begin) / 1.0e6);
+        PassStats& s  = stats[timer.passes[k]];
+        s.gpuMs       = (s.gpuMs == 0.0f) ? ms : s.gpuMs * 0.9f + ms * 0.1f;
+        total += ms;
+    }
+    frameGpuMs = (float)total;
+    frameGpuSerial++;
+}
+
+void Graph::Execute() {
+    // 剔除: 倒序扫描，写入保留资源或者写入后面存活 pass 所读资源的 pass 才存活
+    needed.assign(resources.size(), 0);
+    for (int i = nodeCount - 1; i >= 0; i--) {
+        Node& n = nodes[i];
+        n.live  = false;
+        for (int w = 0; w < n.writeCount; w++) {
+            n.live = n.live || resources[n.writes[w]].retained || needed[n.writes[w]];
+        }
+        if (n.live) {
+            for (int r = 0; r < n.readCount; r++) {
+                needed[n.reads[r]] = 1;
+            }
+        }
+    }
+
+    // 瞬态资源的生命周期: 第一次和最后一次被存活 pass 使用的位置
+    for (Resource& r : resources) {
+        r.first    = -1;
+        r.last     = -1;
+        r.physical = -1;
+    }
+    auto touch = [&](ResourceId id, int i) {
+        Resource& r = resources[id];
+        if (r.transient) {
+            r.first = (r.first < 0) ? i : r.first;
+            r.last  = i;
+        }
+    };
+    for (int i = 0; i < nodeCount; i++) {
+        const Node& n = nodes[i];
+        if (n.live) {
+            for (int k = 0; k < n.readCount; k++) {
+                touch(n.reads[k], i);
+            }
+            for (int k = 0; k < n.writeCount; k++) {
+                touch(n.writes[k], i);
+            }
+        }
+    }
+
+    // GPU 计时: 先取回 kTimerFrames 帧之前同一组查询的结果，再复用这组查询
+    TimerFrame& timer = timers[frameIndex % kTimerFrames];
+    ReadTimers(timer);
+    if ((int)timer.queries.size() < nodeCount * 2) {
+        size_t old = timer.queries.size();
+        timer.queries.resize(nodeCount * 2);
+        timer.passes.resize(nodeCount);
+        glGenQueries((GLsizei)(timer.queries.size() - old), timer.queries.data() + old);
+    }
+    timer.count = 0;
+    for (PassStats& s : stats) {
+        s.executed = false;
+        s.culled   = false;
+    }
+
+    // 按声明顺序执行存活的 pass: 瞬态资源在第一次使用前分配，最后一次使用后归还池 (后面的同规格资源可复用)
+    auto forEachEdge = [](const Node& n, auto&& fn) {
+        for (int k = 0; k < n.readCount; k++) {
+            fn(n.reads[k]);
+        }
+        for (int k = 0; k < n.writeCount; k++) {
+            fn(n.writes[k]);
+        }
+    };
+    for (int i = 0; i < nodeCount; i++) {
+        const Node& n = nodes[i];
+        if (!n.live) {
+            stats[n.pass].culled = true;
+            continue;
+        }
+        forEachEdge(n, [&](ResourceId id) {
+            Resource& r = resources[id];
+            if (r.transient && r.first == i && r.physical < 0) {
+                r.physical = Acquire(r.desc);
+            }
+        });
+
+        glQueryCounter(timer.queries[timer.count * 2], GL_TIMESTAMP);
+        passes[n.pass].execute();
+        glQueryCounter(timer.queries[timer.count * 2 + 1], GL_TIMESTAMP);
+        timer.passes[timer.count++] = n.pass;
+        stats[n.pass].executed = true;
+
+        forEachEdge(n, [&](ResourceId id) {
+            Resource& r = resources[id];
+            if (r.transient && r.last == i && r.physical >= 0) {
+                pool[r.physical].inUse = false;
+            }
+        });
+    }
+    timer.pending = timer.count > 0;
+    frameIndex++;
+}
+
+GLuint Graph::GetTexture(ResourceId id) const {
+    const Resource& r = resources[id];
+    if (r.transient) {
+        return r.physical >= 0 ? pool[r.physical].texture : 0;
+    }
+    return r.texture;
+}
+
+GLuint Graph::GetFramebuffer(ResourceId id) const {
+    const Resource& r = resources[id];
+    if (r.transient) {
+        return r.physical >= 0 ? pool[r.physical].framebuffer : 0;
+    }
+    return r.framebuffer;
+}
+
+TextureDesc Graph::GetAllocatedDesc(ResourceId id) const {
+    const Resource& r = resources[id];
+    return (r.transient && r.physical >= 0) ? pool[r.physical].desc : r.desc;
+}
+
+} // namespace FrameGraph
@@ -0,0 +1,153 @@
+#pragma once
+// 帧图 - 每帧按执行顺序声明各 pass 读写的资源，自动剔除结果无人使用的 pass
+// 瞬态渲染目标从池中分配，生命周期不重叠的同规格目标共用同一块显存 (别名)
+// 池纹理按尺寸档位多分配一些容量，逻辑尺寸只是其中左下角的子矩形: 尺寸小幅变化 (动态分辨率、窗口调整) 时直接复用
+// pass 的执行函数只在启动时注册一次，每帧只重新声明依赖 (不分配内存)；每个执行的 pass 前后插入 GPU 时间戳
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace FrameGraph {
+
+using ResourceId = int;
+using PassId     = int;
+
+static constexpr int kMaxPassEdges   = 4;   // 每个 pass 最多读 / 写的资源数
+static constexpr int kTimerFrames    = 4;   // GPU 时间戳查询延迟读取的帧数 (避免等待 GPU)
+static constexpr int kPoolIdleFrames = 120; // 池中纹理连续这么多帧未使用后释放
+static constexpr int kSizeAlign      = 128; // 池纹理的宽高按该粒度向上取整 (尺寸档位)
+static constexpr int kHeadroomDiv    = 8;   // 新分配的纹理在请求尺寸上多留 1/kHeadroomDiv 的余量
+static constexpr int kMaxWaste       = 2;   // 复用时容量面积最多为请求面积的这么多倍 (否则另行分配)
+
+struct TextureDesc {
+    int    width        = 0;
+    int    height       = 0;
+    GLenum format       = GL_R11F_G11F_B10F;
+    bool   depthStencil = false; // 附带 DEPTH24_STENCIL8 渲染缓冲
+
+    bool operator==(const TextureDesc& o) const {
+        return width == o.width && height == o.height && format == o.format && depthStencil == o.depthStencil;
+    }
+};
+
+// 新分配时的容量: 请求尺寸加余量后取整到尺寸档位
+// 自行管理、随场景尺寸变化的渲染资源 (模糊金字塔、累积历史等) 也按它分配，与池纹理一样只在超出容量时重新分配
+int Capacity(int size);
+
+// 每个注册 pass 的统计 (调试面板显示)
+struct PassStats {
+    const char* name     = "";
+    float       gpuMs    = 0.0f; // 平滑后的 GPU 耗时
+    bool        executed = false;
+    bool        culled   = false; // 本帧声明了但结果无人使用
+};
+
+class Graph {
+  public:
+    // 本帧的一个 pass 实例，链式声明读写
+    struct Node {
+        PassId     pass = -1;
+        ResourceId reads[kMaxPassEdges];
+        ResourceId writes[kMaxPassEdges];
+        int        readCount  = 0;
+        int        writeCount = 0;
+        bool       live       = false;
+
+        Node& Read(ResourceId id);
+        Node& Write(ResourceId id);
+    };
+
+    // GL 对象随上下文一起销毁 (与其他渲染资源一致，不在析构时调用 GL)
+    Graph() = default;
+    Graph(const Graph&)            = delete;
+    Graph& operator=(const Graph&) = delete;
+
+    // ---- 注册 (启动时) ----
+
+    // 瞬态纹理: 每帧从池中分配，内容只在本帧内有效
+    ResourceId CreateTexture(const char* name, const TextureDesc& desc);
+
+    // 外部资源 (默认帧缓冲、星空缓存层、粒子缓冲等)
+    // retained 为 true 表示内容在帧外仍被使用，写入它的 pass 永远不会被剔除
+    ResourceId Import(const char* name, GLuint texture, GLuint framebuffer, bool retained);
+
+    PassId AddPass(const char* name, std::function<void()> execute);
+
+    void SetDesc(ResourceId id, const TextureDesc& desc);
+    void SetImported(ResourceId id, GLuint texture, GLuint framebuffer);
+
+    // 预先分配瞬态纹理并检查 FBO 完整性 (启动时用于报告显卡不支持的格式)
+    bool Prewarm(ResourceId id);
+
+    // ---- 每帧 ----
+
+    void  BeginFrame();
+    Node& Use(PassId pass); // 按执行顺序声明本帧的 pass
+    void  Execute();        // 剔除、分配瞬态资源、执行、回收
+
+    // 执行期间 (以及 Execute 之后到下一次 BeginFrame 之前) 查询物理资源
+    GLuint GetTexture(ResourceId id) const;
+    GLuint GetFramebuffer(ResourceId id) const;
+
+    // 瞬态资源实际分配的纹理尺寸 (不小于逻辑尺寸)，采样方按逻辑尺寸 / 该尺寸缩放纹理坐标
+    // 外部资源和未分配时返回逻辑尺寸
+    TextureDesc GetAllocatedDesc(ResourceId id) const;
+
+    const std::vector<PassStats>& GetStats() const { return stats; }
+    size_t                        GetPoolSize() const { return pool.size(); }
+    uint64_t                      GetPoolAllocations() const { return allocations; } // 累计分配次数
+
+    // 最近取回的一整帧的 GPU 耗时 (各 pass 之和，未平滑，延迟 kTimerFrames 帧)；序号每取回一帧加 1
+    // 结果未就绪的帧被跳过，统计方按序号变化记录样本，避免重复计数
+    float    GetFrameGpuMs() const { return frameGpuMs; }
+    uint64_t GetFrameGpuSerial() const { return frameGpuSerial; }
+
+  private:
+    struct Resource {
+        const char* name = "";
+        TextureDesc desc;
+        bool        transient   = false;
+        bool        retained    = false;
+        GLuint      texture     = 0; // 外部资源
+        GLuint      framebuffer = 0;
+        int         physical    = -1; // 瞬态资源本帧分配到的池索引
+        int         first = -1, last = -1;
+    };
+    struct Physical {
+        TextureDesc desc; // 容量 (按尺寸档位取整)
+        GLuint      texture = 0, framebuffer = 0, depth = 0;
+        bool        inUse         = false;
+        bool        usedThisFrame = false;
+        int         idleFrames    = 0;
+    };
+    struct Pass {
+        const char*           name = "";
+        std::function<void()> execute;
+    };
+    struct TimerFrame {
+        std::vector<GLuint> queries; // 每个执行的 pass 前后各一个时间戳 (2k 为开始，2k + 1 为结束)
+        std::vector<PassId> passes;
+        int                 count   = 0;
+        bool                pending = false;
+    };
+
+    std::vector<Resource>  resources;
+    std::vector<Physical>  pool;
+    std::vector<Pass>      passes;
+    std::vector<PassStats> stats;
+    std::vector<Node>      nodes; // 本帧声明的 pass (容量复用)
+    int                    nodeCount = 0;
+    std::vector<char>      needed; // 剔除时的资源标记
+    TimerFrame             timers[kTimerFrames];
+    uint64_t               frameIndex     = 0;
+    uint64_t               allocations    = 0;
+    float                  frameGpuMs     = 0.0f;
+    uint64_t               frameGpuSerial = 0;
+
+    int  Acquire(const TextureDesc& desc);
+    void ReadTimers(TimerFrame& timer);
+    void TrimPool();
+};
+
+} // namespace FrameGraph
@@ -0,0 +1,156 @@
+// FramePacer.cpp - 帧节奏控制与输入锁存实现
+
+#include "pch.h"
+
+#include "FramePacer.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+namespace FramePacer {
+
+void Pacer::Init(int refreshHz) {
+    period = 1.0 / std::clamp(refreshHz > 0 ? refreshHz : 60, 24, 500);
+    for (double& c : costs) {
+        c = period * 0.5;
+    }
+#ifdef _WIN32
+    timerPeriodRaised = timeBeginPeriod(1) == TIMERR_NOERROR;
+#endif
+    std::cout << "[FramePacer] Refresh " << 1.0 / period << " Hz" << std::endl;
+}
+
+Pacer::~Pacer() {
+#ifdef _WIN32
+    if (timerPeriodRaised) {
+        timeEndPeriod(1);
+    }
+#endif
+}
+
+double Pacer::PredictCost() const {
+    double worst = 0.0;
+    for (double c : costs) {
+        worst = std::max(worst, c);
+    }
+    return worst + kMarginMs / 1000.0;
+}
+
+void Pacer::WaitForFrameStart(bool enabled) {
+    double now      = glfwGetTime();
+    stats.pacing    = enabled && lastVblank > 0.0;
+    stats.sleepMs   = 0.0;
+    stats.costMs    = PredictCost() * 1000.0;
+    stats.refreshMs = period * 1000.0;
+    if (stats.pacing) {
+        // 来不及赶上的 vblank 跳过: 立即开始也会错过，不如睡到下一个周期的最晚开始时间
+        double cost = PredictCost();
+        double next = lastVblank + period;
+        while (next - cost < now) {
+            next += period;
+        }
+        double start = next - cost;
+        for (double remain = start - now; remain > 0.0; remain = start - glfwGetTime()) {
+            if (remain > kSpinMs / 1000.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(remain - kSpinMs / 1000.0));
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        stats.sleepMs = (start - now) * 1000.0;
+    }
+    frameStart = glfwGetTime();
+}
+
+void Pacer::MarkSubmitted() {
+    submitTime = glfwGetTime();
+}
+
+void Pacer::MarkPresented(bool enabled, double gpuMs, double inputTime) {
+    if (enabled) {
+        glFinish();
+    }
+    double now = glfwGetTime();
+
+    if (enabled) {
+        // 间隔接近整数个周期时 (掉帧时为 2、3 个) 缓慢修正周期估计
+        if (lastVblank > 0.0) {
+            double interval = now - lastVblank;
+            double n        = std::round(interval / period);
+            if (n >= 1.0 && fabs(interval - n * period) < period * 0.1) {
+                period += (interval / n - period) * 0.05;
+            }
+        }
+        lastVblank = now;
+    } else {
+        lastVblank = 0.0;
+    }
+
+    // CPU 与 GPU 部分重叠，直接相加偏保守 (宁可早醒也不错过 vblank)
+    costs[costIndex] = (submitTime - frameStart) + gpuMs / 1000.0;
+    costIndex        = (costIndex + 1) % kCostWindow;
+
+    if (inputTime > 0.0) {
+        double ms        = (now - inputTime) * 1000.0;
+        stats.latencyMs  = stats.latencyMs > 0.0 ? stats.latencyMs + (ms - stats.latencyMs) * 0.1 : ms;
+        latencyWindowMax = std::max(latencyWindowMax, ms);
+    }
+    if (now - latencyWindowStart >= 1.0) {
+        stats.latencyMax   = latencyWindowMax;
+        latencyWindowMax   = 0.0;
+        latencyWindowStart = now;
+    }
+}
+
+void InputLatch::Init() {
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    stride = ((GLsizeiptr)sizeof(Block) + alignment - 1) / alignment * alignment;
+
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferStorage(GL_UNIFORM_BUFFER, stride * kFramesInFlight, nullptr, flags);
+    mapped = (char*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, stride * kFramesInFlight, flags);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    Block identity = {glm::mat4(1.f), 1.0f, {}};
+    for (int i = 0; mapped && i < kFramesInFlight; i++) {
+        std::memcpy(mapped + stride * i, &identity, sizeof(identity));
+    }
+}
+
+void InputLatch::BeginFrame() {
+    frame = (frame + 1) % kFramesInFlight;
+    if (fences[frame]) {
+        glClientWaitSync(fences[frame], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        glDeleteSync(fences[frame]);
+        fences[frame] = nullptr;
+    }
+    Bind();
+}
+
+void InputLatch::Bind() const {
+    glBindBufferRange(GL_UNIFORM_BUFFER, kLatchBinding, buffer, stride * frame, sizeof(Block));
+}
+
+void InputLatch::Write(const glm::mat4& model, float scale) {
+    if (!mapped) {
+        return;
+    }
+    Block block = {model, scale, {}};
+    std::memcpy(mapped + stride * frame, &block, sizeof(block));
+}
+
+void InputLatch::EndFrame() {
+    fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+} // namespace FramePacer
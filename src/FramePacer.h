@@ -0,0 +1,91 @@
+#pragma once
+// 帧节奏控制 - 预测下一次 vblank，睡眠到最晚的安全开始时间再开始一帧，缩短输入到显示的延迟
+// VSync 下原来的循环在 swap 返回后立即开始下一帧，帧开始时读取的手部数据要过一到两个刷新周期才显示
+// 开启后 swap 之后 glFinish 与显示同步 (得到 vblank 相位)，帧开始时间 = 下一次 vblank - 预测帧耗时 - 余量
+// 输入锁存: 土星姿态写入持久映射的 uniform 缓冲，提交前用最新的手部样本覆盖，GPU 执行时才读取
+
+#include <cstdint>
+
+namespace FramePacer {
+
+static constexpr int    kFramesInFlight = 3;   // 锁存缓冲的段数 (与 PlanetSystem 相同的三段轮转)
+static constexpr GLuint kLatchBinding   = 0;   // LatchedInput uniform 块的绑定点 (与着色器一致)
+static constexpr double kMarginMs       = 1.5; // 预测帧耗时之外的安全余量
+static constexpr double kSpinMs         = 1.0; // 睡眠的最后一段改为让出时间片轮询 (系统睡眠粒度约 1 ms)
+static constexpr int    kCostWindow     = 32;  // 预测帧耗时取最近 N 帧的最大值
+
+struct Stats {
+    bool   pacing     = false;
+    double refreshMs  = 0.0; // 按实际 vblank 间隔修正后的刷新周期
+    double costMs     = 0.0; // 预测帧耗时 (CPU 提交 + GPU，含余量)
+    double sleepMs    = 0.0; // 本帧开始前的睡眠
+    double latencyMs  = 0.0; // 输入到显示的延迟 (平滑)
+    double latencyMax = 0.0; // 最近一秒的最大延迟
+};
+
+class Pacer {
+  public:
+    // refreshHz: 显示器刷新率，之后按测得的 vblank 间隔修正；Windows 下把系统计时器精度提高到 1 ms
+    void Init(int refreshHz);
+    ~Pacer();
+
+    // 帧开始前调用: enabled 时睡眠到 下一次赶得上的 vblank - 预测帧耗时，返回后再读取输入
+    void WaitForFrameStart(bool enabled);
+
+    // 本帧命令全部提交后、swap 之前调用
+    void MarkSubmitted();
+
+    // swap 返回后调用: enabled 时 glFinish 等待显示完成并记录 vblank 相位 (未开启时以 swap 返回近似显示时间)
+    // gpuMs 为本帧 GPU 耗时，inputTime 为显示的手部样本的采样时间 (glfwGetTime，<= 0 表示没有样本)
+    void MarkPresented(bool enabled, double gpuMs, double inputTime);
+
+    const Stats& GetStats() const { return stats; }
+
+  private:
+    double PredictCost() const;
+
+    Stats  stats;
+    double period             = 1.0 / 60.0;
+    double lastVblank         = 0.0; // 0 表示相位未知 (刚开启或未开启)
+    double frameStart         = 0.0;
+    double submitTime         = 0.0;
+    double costs[kCostWindow] = {};
+    int    costIndex          = 0;
+    double latencyWindowStart = 0.0;
+    double latencyWindowMax   = 0.0;
+    bool   timerPeriodRaised  = false;
+};
+
+// 土星姿态锁存 (与 VertexSaturn / ComputeSplatBin 的 LatchedInput 块布局一致)
+class InputLatch {
+  public:
+    // 创建持久一致映射的 uniform 缓冲 (GL 线程)
+    void Init();
+
+    // 每帧开始: 切换到下一段 (等待 GPU 读完三帧前写入的数据) 并绑定到 kLatchBinding
+    void BeginFrame();
+
+    // 重新绑定本帧的段 (其他模块临时占用 kLatchBinding 之后)
+    void Bind() const;
+
+    // 写入本帧的模型矩阵和粒子缩放，提交后再次调用会覆盖 GPU 尚未执行的读取
+    void Write(const glm::mat4& model, float scale);
+
+    // swap 之后: 为本帧的段插入围栏
+    void EndFrame();
+
+  private:
+    struct Block {
+        glm::mat4 model;
+        float     scale;
+        float     pad[3]; // std140: 块大小按 vec4 对齐
+    };
+
+    GLuint     buffer                  = 0;
+    char*      mapped                  = nullptr;
+    GLsizeiptr stride                  = 0; // 按 GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 对齐
+    GLsync     fences[kFramesInFlight] = {};
+    int        frame                   = 0;
+};
+
+} // namespace FramePacer
@@ -0,0 +1,136 @@
+// FrameStats.cpp - 帧时间统计实现
+
+#include "pch.h"
+
+#include "FrameStats.h"
+
+#include <bit>
+#include <cmath>
+
+namespace FrameStats {
+
+namespace {
+
+static constexpr uint32_t kMaxMicros = (uint32_t)kSubBuckets << kMaxExponent;
+
+// 累计计数中第一个达到 ceil(q * count) 的桶
+double Percentile(const uint64_t* counts, uint64_t total, double q, uint32_t maxUs) {
+    uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(q * (double)total));
+    uint64_t seen   = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(Histogram::BucketValue(i), maxUs) / 1000.0;
+        }
+    }
+    return maxUs / 1000.0;
+}
+
+} // namespace
+
+int Histogram::BucketIndex(uint32_t us) {
+    us = std::min(us, kMaxMicros - 1);
+    // 位数超过 kSubBucketBits 的部分右移掉，保留最高的 kSubBucketBits 位 (最高位为 1，落在 [32, 64))
+    int bits     = 32 - std::countl_zero(us);
+    int exponent = std::max(0, bits - kSubBucketBits);
+    return exponent * (kSubBuckets / 2) + (int)(us >> exponent);
+}
+
+uint32_t Histogram::BucketValue(int index) {
+    if (index < kSubBuckets) {
+        return (uint32_t)index;
+    }
+    int      exponent = index / (kSubBuckets / 2) - 1;
+    uint32_t lower    = (uint32_t)(index - exponent * (kSubBuckets / 2)) << exponent;
+    return lower + ((1u << exponent) >> 1);
+}
+
+void Histogram::Record(double ms) {
+    uint32_t us = (uint32_t)std::clamp(ms * 1000.0 + 0.5, 0.0, (double)(kMaxMicros - 1));
+    counts[BucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    sumUs.fetch_add(us, std::memory_order_relaxed);
+    uint32_t prevMax = maxUs.load(std::memory_order_relaxed);
+    while (us > prevMax && !maxUs.compare_exchange_weak(prevMax, us, std::memory_order_relaxed)) {
+    }
+}
+
+void Histogram::Reset() {
+    for (std::atomic<uint32_t>& c : counts) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    sumUs.store(0, std::memory_order_relaxed);
+    maxUs.store(0, std::memory_order_relaxed);
+}
+
+void Histogram::Accumulate(uint64_t* out, uint64_t& sum, uint32_t& max) const {
+    for (int i = 0; i < kBucketCount; i++) {
+        out[i] += counts[i].load(std::memory_order_relaxed);
+    }
+    sum += sumUs.load(std::memory_order_relaxed);
+    max = std::max(max, maxUs.load(std::memory_order_relaxed));
+}
+
+Summary Summarize(const uint64_t* counts, uint64_t sumUs, uint32_t maxUs) {
+    Summary s;
+    for (int i = 0; i < kBucketCount; i++) {
+        s.count += counts[i];
+    }
+    if (s.count == 0) {
+        return s;
+    }
+    s.mean = (double)sumUs / (double)s.count / 1000.0;
+    s.p50  = Percentile(counts, s.count, 0.50, maxUs);
+    s.p95  = Percentile(counts, s.count, 0.95, maxUs);
+    s.p99  = Percentile(counts, s.count, 0.99, maxUs);
+    s.max  = maxUs / 1000.0;
+    return s;
+}
+
+void Tracker::Record(double ms, double now) {
+    // 进入新的时间片时清空该槽位上 kSliceCount 片之前的数据
+    int64_t id   = (int64_t)std::floor(now / kSliceSeconds) + 1;
+    int     slot = (int)(id % kSliceCount);
+    if (sliceIds[slot] != id) {
+        slices[slot].Reset();
+        sliceIds[slot] = id;
+    }
+    slices[slot].Record(ms);
+    total.Record(ms);
+    recent[recentNext] = (float)ms;
+    recentNext         = (recentNext + 1) % kPlotFrames;
+}
+
+Summary Tracker::GetWindow(double seconds, double now) const {
+    int64_t  id     = (int64_t)std::floor(now / kSliceSeconds) + 1;
+    int64_t  oldest = id - (int64_t)std::ceil(std::min(seconds, kMaxWindow) / kSliceSeconds);
+
+    uint64_t counts[kBucketCount] = {};
+    uint64_t sumUs                = 0;
+    uint32_t maxUs                = 0;
+    for (int i = 0; i < kSliceCount; i++) {
+        if (sliceIds[i] > oldest && sliceIds[i] <= id) {
+            slices[i].Accumulate(counts, sumUs, maxUs);
+        }
+    }
+    return Summarize(counts, sumUs, maxUs);
+}
+
+Summary Tracker::GetTotal() const {
+    uint64_t counts[kBucketCount] = {};
+    uint64_t sumUs                = 0;
+    uint32_t maxUs                = 0;
+    total.Accumulate(counts, sumUs, maxUs);
+    return Summarize(counts, sumUs, maxUs);
+}
+
+void Recorder::Report(const char* title) const {
+    static const char* const names[kMetricCount] = {"frame", "cpu", "gpu"};
+    std::cout << "[FrameStats] " << title << " (ms, p50 / p95 / p99 / max / mean):" << std::endl;
+    for (int m = 0; m < kMetricCount; m++) {
+        Summary s = trackers[m].GetTotal();
+        std::cout << "[FrameStats]   " << names[m] << ": " << s.p50 << " / " << s.p95 << " / " << s.p99 << " / "
+                  << s.max << " / " << s.mean << " (" << s.count << " samples)" << std::endl;
+    }
+}
+
+} // namespace FrameStats
@@ -0,0 +1,93 @@
+#pragma once
+// 帧时间统计 - 固定内存的对数分桶直方图 (HDR Histogram 的做法)，给出 p50 / p95 / p99 / 最大值
+// 平均帧率会把偶发的长帧摊平 (60 帧里有一帧 50 ms，平均仍有 57 FPS)，卡顿要看尾部分位数
+// 样本按微秒落桶: 64 µs 以下每微秒一个桶，之后每个 2 的幂区间分 32 个桶，相对误差不超过 1/32，上限约 4 s
+// 计数为原子变量 (relaxed)，记录时不加锁、不分配内存；其他线程读取时得到近似一致的快照
+// 滑动窗口: 按时间切成 kSliceSeconds 的片，每片一个直方图，查询时合并最近若干片；另外保留整个会话的累计直方图
+// 帧间隔 (呈现到呈现)、CPU 耗时 (帧开始到提交) 和 GPU 耗时 (帧图时间戳) 分开统计，CPU 受限和 GPU 受限的对策不同
+
+#include <atomic>
+#include <cstdint>
+
+namespace FrameStats {
+
+static constexpr int    kSubBucketBits = 6;  // 线性区 64 个桶，之后每个 2 的幂区间 32 个
+static constexpr int    kSubBuckets    = 1 << kSubBucketBits;
+static constexpr int    kMaxExponent   = 16; // 最大 64 << 16 µs (约 4.2 s)，更长的计入最后一个桶
+static constexpr int    kBucketCount   = (kMaxExponent + 2) * (kSubBuckets / 2);
+static constexpr double kSliceSeconds  = 0.25; // 滑动窗口的时间粒度
+static constexpr int    kSliceCount    = 41;   // 最长窗口 10 s (另加一片正在写入的)
+static constexpr double kMaxWindow     = (kSliceCount - 1) * kSliceSeconds;
+static constexpr int    kPlotFrames    = 240; // 调试面板曲线保留的帧数
+
+enum class Metric : uint8_t { Frame, Cpu, Gpu };
+static constexpr int kMetricCount = 3;
+
+// 分位数摘要 (毫秒，精度为桶宽)
+struct Summary {
+    uint64_t count = 0;
+    double   mean  = 0.0;
+    double   p50   = 0.0;
+    double   p95   = 0.0;
+    double   p99   = 0.0;
+    double   max   = 0.0;
+};
+
+class Histogram {
+  public:
+    Histogram() { Reset(); }
+
+    void Record(double ms);
+    void Reset();
+
+    // 累加到 counts (kBucketCount 个)，用于合并多个时间片
+    void Accumulate(uint64_t* counts, uint64_t& sumUs, uint32_t& maxUs) const;
+
+    static int      BucketIndex(uint32_t us);
+    static uint32_t BucketValue(int index); // 桶的代表值 (区间中点，微秒)
+
+  private:
+    std::atomic<uint32_t> counts[kBucketCount];
+    std::atomic<uint64_t> sumUs;
+    std::atomic<uint32_t> maxUs;
+};
+
+// 由合并后的计数计算摘要
+Summary Summarize(const uint64_t* counts, uint64_t sumUs, uint32_t maxUs);
+
+// 单个指标: 滑动窗口 + 会话累计 + 最近若干帧的曲线
+// 只允许一个线程记录 (时间片轮换时会清空旧片)，读取可以在任意线程
+class Tracker {
+  public:
+    void Record(double ms, double now);
+
+    // 最近 seconds 秒 (按时间片取整，最多 kMaxWindow)
+    Summary GetWindow(double seconds, double now) const;
+    Summary GetTotal() const;
+
+    // 最近 kPlotFrames 个样本 (环形，ImGui::PlotLines 的 values_offset 传 GetRecentOffset)
+    const float* GetRecent() const { return recent; }
+    int          GetRecentOffset() const { return recentNext; }
+
+  private:
+    Histogram slices[kSliceCount];
+    int64_t   sliceIds[kSliceCount] = {}; // 每片对应的时间片编号 (floor(now / kSliceSeconds) + 1，0 表示空)
+    Histogram total;
+    float     recent[kPlotFrames] = {};
+    int       recentNext          = 0;
+};
+
+class Recorder {
+  public:
+    void Record(Metric metric, double ms, double now) { trackers[(int)metric].Record(ms, now); }
+
+    const Tracker& Get(Metric metric) const { return trackers[(int)metric]; }
+
+    // 整个会话各指标的分位数 (回放结束或退出时输出到日志，作为基准测试报告)
+    void Report(const char* title) const;
+
+  private:
+    Tracker trackers[kMetricCount];
+};
+
+} // namespace FrameStats
@@ -0,0 +1,153 @@
+// GpuBudget.cpp - GPU 时间预算控制器实现
+
+#include "pch.h"
+
+#include "GpuBudget.h"
+
+#include <cmath>
+
+namespace GpuBudget {
+
+namespace {
+
+// 单位开销的割线估计: 与旧值各占一半，单次变化不超过 4 倍 (一次测量的噪声不至于让模型失控)
+double BlendCost(double current, double measured) {
+    return std::clamp(current + (measured - current) * 0.5, current * 0.25, current * 4.0);
+}
+
+} // namespace
+
+void Controller::Init(unsigned int minParticles, unsigned int maxParticles) {
+    minCount = minParticles;
+    maxCount = maxParticles;
+}
+
+void Controller::AddSample(double gpuMs) {
+    if (settle > 0) {
+        settle--;
+        return;
+    }
+    if (sampleCount < kWindowSamples) {
+        samples[sampleCount++] = (float)gpuMs;
+    }
+}
+
+void Controller::Solve(double ms, int windowPixels, unsigned int& particles, float& pixelRatio) const {
+    double fullMegapixels = windowPixels / 1.0e6;
+    double available      = ms - stats.baseMs;
+    // 全分辨率下放得下最少的粒子: 只调粒子数
+    double millions = (available - stats.pixelMs * fullMegapixels) / stats.particleMs;
+    if (millions * 1.0e6 >= minCount) {
+        particles  = (unsigned int)std::min(millions * 1.0e6, (double)maxCount);
+        pixelRatio = kMaxPixelRatio;
+        return;
+    }
+    // 粒子数已到下限: 剩余预算决定场景像素数 (与 pixelRatio 的平方成正比)
+    double megapixels = (available - stats.particleMs * minCount / 1.0e6) / stats.pixelMs;
+    double ratio      = std::sqrt(std::max(megapixels, 0.0) / std::max(fullMegapixels, 1.0e-6));
+    particles         = minCount;
+    pixelRatio        = (float)std::clamp(ratio, (double)kMinPixelRatio, (double)kMaxPixelRatio);
+}
+
+bool Controller::Update(double refreshMs, int windowPixels, bool allowDegrade, unsigned int& particles,
+                        float& pixelRatio) {
+    stats.budgetMs = refreshMs * kBudgetRatio;
+
+    // 配置变化后先前的样本作废，等待时间戳延迟过去
+    if (particles != lastCount || pixelRatio != lastRatio || windowPixels != lastPixels) {
+        lastCount   = particles;
+        lastRatio   = pixelRatio;
+        lastPixels  = windowPixels;
+        sampleCount = 0;
+        settle      = kSettleSamples;
+        return false;
+    }
+    if (sampleCount < kWindowSamples || windowPixels <= 0) {
+        return false;
+    }
+    float sorted[kWindowSamples];
+    std::copy(samples, samples + kWindowSamples, sorted);
+    std::nth_element(sorted, sorted + kWindowSamples / 2, sorted + kWindowSamples);
+    double ms        = sorted[kWindowSamples / 2];
+    sampleCount      = 0;
+    stats.measuredMs = ms;
+    if (ms <= 0.0) {
+        return false;
+    }
+
+    // 更新代价模型
+    double millions   = particles / 1.0e6;
+    double megapixels = windowPixels * (double)pixelRatio * pixelRatio / 1.0e6;
+    if (!stats.modelReady) {
+        // 初值: 按经验把实测耗时分给粒子和像素，之后由割线修正
+        stats.particleMs = std::max(ms * 0.5 / millions, 1.0e-3);
+        stats.pixelMs    = std::max(ms * 0.3 / megapixels, 1.0e-3);
+        stats.modelReady = true;
+    } else if (prevMs > 0.0) {
+        bool countChanged  = std::fabs(millions - prevMillions) >= millions * kMinSecantRatio;
+        bool pixelsChanged = std::fabs(megapixels - prevMegapixels) >= megapixels * kMinSecantRatio;
+        // 两者同时变化时无法区分各自的贡献，不更新
+        if (countChanged && !pixelsChanged) {
+            double cost = (ms - prevMs) / (millions - prevMillions);
+            if (cost > 0.0) {
+                stats.particleMs = BlendCost(stats.particleMs, cost);
+            }
+        } else if (pixelsChanged && !countChanged) {
+            double cost = (ms - prevMs) / (megapixels - prevMegapixels);
+            if (cost > 0.0) {
+                stats.pixelMs = BlendCost(stats.pixelMs, cost);
+            }
+        }
+    }
+    // 固定开销按当前工作点校准；单位开销估计过大 (固定开销为负) 时等比缩小
+    double variable = stats.particleMs * millions + stats.pixelMs * megapixels;
+    if (variable > ms) {
+        double scale     = ms / variable;
+        stats.particleMs = stats.particleMs * scale;
+        stats.pixelMs    = stats.pixelMs * scale;
+        variable         = ms;
+    }
+    stats.baseMs   = ms - variable;
+    prevMs         = ms;
+    prevMillions   = millions;
+    prevMegapixels = megapixels;
+
+    // 决策: 超出预算直接降到目标，明显低于目标时向目标走一部分
+    double       target   = stats.budgetMs * kTargetRatio;
+    unsigned int newCount = particles;
+    float        newRatio = pixelRatio;
+    stats.overBudget      = ms > stats.budgetMs;
+    if (stats.overBudget && allowDegrade) {
+        Solve(target, windowPixels, newCount, newRatio);
+        newCount = std::min(newCount, particles);
+        newRatio = std::min(newRatio, pixelRatio);
+    } else if (ms < target * kUpgradeRatio) {
+        Solve(ms + (target - ms) * kUpgradeGain, windowPixels, newCount, newRatio);
+        newCount = std::max(newCount, particles);
+        newRatio = std::max(newRatio, pixelRatio);
+    }
+
+    // 过小的调整不值得重建渲染目标或重新计算密度补偿 (到达上下限的除外)
+    newRatio = std::round(newRatio * 100.0f) / 100.0f;
+    if (std::fabs(newRatio - pixelRatio) < kMinStep && newRatio != kMinPixelRatio && newRatio != kMaxPixelRatio) {
+        newRatio = pixelRatio;
+    }
+    bool countBound = newCount == minCount || newCount == maxCount;
+    if (std::fabs((double)newCount - particles) < particles * kMinStep && !countBound) {
+        newCount = particles;
+    }
+    if (newCount == particles && newRatio == pixelRatio) {
+        return false;
+    }
+    std::cout << "[GpuBudget] " << ms << " ms (budget " << stats.budgetMs << " ms): particles " << particles << " -> "
+              << newCount << ", pixel ratio " << pixelRatio << " -> " << newRatio << std::endl;
+    particles   = newCount;
+    pixelRatio  = newRatio;
+    lastCount   = particles;
+    lastRatio   = pixelRatio;
+    sampleCount = 0;
+    settle      = kSettleSamples;
+    return true;
+}
+
+} // namespace GpuBudget
@@ -0,0 +1,68 @@
+#pragma once
+// GPU 时间预算 - 动态 LOD 的闭环控制器，输入为帧图时间戳测得的整帧 GPU 耗时，而不是帧间隔
+// 帧间隔在 VSync 下被钳在刷新周期上，分不清 "GPU 刚好跑满" 和 "GPU 很闲、在等 vblank"；GPU 耗时两种情况都如实反映
+// 代价模型: GPU 耗时 ≈ 固定开销 + 每百万粒子开销 × 粒子数 + 每百万像素开销 × 场景像素数
+// 只有粒子数 (或只有像素数) 变化时，用变化前后的实测差值估计对应的单位开销 (割线)；固定开销每次按实测值校准，
+// 模型始终经过当前工作点，相当于积分项，模型的误差不会积累成稳态偏差
+// 决策时由模型直接解出目标耗时对应的粒子数和 pixelRatio，一步到位，不再按固定步长来回试探
+// 超出预算立即降到目标；低于目标足够多才提质，且只走差距的一部分 (比例项)，避免模型偏差造成过冲震荡
+// 顺序与原来相同: 降质先减粒子数、到下限后再降分辨率，提质反之
+
+#include <cstdint>
+
+namespace GpuBudget {
+
+static constexpr double kBudgetRatio    = 0.85;  // 预算为刷新周期的该比例 (留给 CPU 提交、合成器和抖动)
+static constexpr double kTargetRatio    = 0.9;   // 调整时瞄准预算的该比例
+static constexpr double kUpgradeRatio   = 0.8;   // 实测低于目标的该比例才提质 (滞后区间)
+static constexpr double kUpgradeGain    = 0.5;   // 提质时走向模型解的比例
+static constexpr int    kSettleSamples  = 6;     // 配置变化后丢弃的样本数 (帧图时间戳延迟 kTimerFrames 帧取回)
+static constexpr int    kWindowSamples  = 8;     // 每次决策使用的样本数 (取中位数，不受偶发长帧影响)
+static constexpr double kMinSecantRatio = 0.05;  // 粒子数或像素数至少变化该比例才更新单位开销 (否则差值主要是噪声)
+static constexpr float  kMinPixelRatio  = 0.7f;  // 动态分辨率的下限
+static constexpr float  kMaxPixelRatio  = 1.0f;
+static constexpr float  kMinStep        = 0.01f; // 粒子数变化小于该比例、pixelRatio 变化小于该值时不调整
+
+struct Stats {
+    double budgetMs   = 0.0; // 本帧预算
+    double measuredMs = 0.0; // 最近一次决策使用的 GPU 耗时 (中位数)
+    double baseMs     = 0.0; // 模型: 固定开销
+    double particleMs = 0.0; // 模型: 每百万粒子开销
+    double pixelMs    = 0.0; // 模型: 每百万像素开销
+    bool   modelReady = false;
+    bool   overBudget = false;
+};
+
+class Controller {
+  public:
+    void Init(unsigned int minParticles, unsigned int maxParticles);
+
+    // 帧图取回新的一帧 GPU 耗时时调用 (按序号去重)
+    void AddSample(double gpuMs);
+
+    // 每帧调用: refreshMs 为刷新周期，windowPixels 为窗口像素数 (pixelRatio 为 1 时的场景像素数)
+    // allowDegrade 为 false 时不降质 (点径预算正在收紧)；particles / pixelRatio 为当前值，需要调整时改写并返回 true
+    // 粒子数、pixelRatio 或窗口尺寸被外部改变 (回放、调整窗口) 时丢弃旧样本，重新等待稳定
+    bool Update(double refreshMs, int windowPixels, bool allowDegrade, unsigned int& particles, float& pixelRatio);
+
+    const Stats& GetStats() const { return stats; }
+
+  private:
+    // 当前模型下耗时为 ms 的配置 (按降质顺序)
+    void Solve(double ms, int windowPixels, unsigned int& particles, float& pixelRatio) const;
+
+    unsigned int minCount = 0, maxCount = 0;
+
+    float        samples[kWindowSamples] = {};
+    int          sampleCount             = 0;
+    int          settle                  = kSettleSamples;
+    unsigned int lastCount               = 0; // 当前样本对应的配置
+    float        lastRatio               = 0.0f;
+    int          lastPixels              = 0;
+    double       prevMs                  = 0.0; // 上一个配置的实测耗时 (割线估计用，0 表示没有)
+    double       prevMillions            = 0.0; // 上一个配置的粒子数 (百万)
+    double       prevMegapixels          = 0.0; // 上一个配置的场景像素数 (百万)
+    Stats        stats;
+};
+
+} // namespace GpuBudget
@@ -0,0 +1,133 @@
+// InputRecorder.cpp - 输入录制/回放实现
+
+#include "pch.h"
+
+#include <cstring>
+
+#include "InputRecorder.h"
+
+static const char kMagic[4] = {'P', 'S', 'I', 'R'};
+
+bool InputRecorder::BeginRecord(const std::string& logPath, uint32_t seed) {
+    Close();
+    file.open(logPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[InputRecorder] Failed to open for writing: " << logPath << std::endl;
+        return false;
+    }
+
+    InputLogHeader header = {};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version      = kVersion;
+    header.particleSeed = seed;
+    file.write((const char*)&header, sizeof(header));
+
+    mode         = Mode::Record;
+    path         = logPath;
+    particleSeed = seed;
+    frameCount   = 0;
+    startTime    = std::chrono::steady_clock::now();
+    std::cout << "[InputRecorder] Recording to " << logPath << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+bool InputRecorder::BeginReplay(const std::string& logPath) {
+    Close();
+    file.open(logPath, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[InputRecorder] Failed to open for reading: " << logPath << std::endl;
+        return false;
+    }
+
+    InputLogHeader header = {};
+    file.read((char*)&header, sizeof(header));
+    if (!file || memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        std::cerr << "[InputRecorder] Invalid or unsupported log: " << logPath << std::endl;
+        file.close();
+        return false;
+    }
+
+    mode         = Mode::Replay;
+    path         = logPath;
+    particleSeed = header.particleSeed;
+    frameCount   = 0;
+    startTime    = std::chrono::steady_clock::now();
+    std::cout << "[InputRecorder] Replaying " << logPath << " (seed " << particleSeed << ")" << std::endl;
+    return true;
+}
+
+void InputRecorder::Write(const InputFrame& frame) {
+    if (mode != Mode::Record) {
+        return;
+    }
+    file.write((const char*)&frame, sizeof(frame));
+    frameCount++;
+}
+
+bool InputRecorder::Read(InputFrame& frame) {
+    if (mode != Mode::Replay) {
+        return false;
+    }
+    file.read((char*)&frame, sizeof(frame));
+    if (file.gcount() != sizeof(frame)) {
+        return false;
+    }
+    frameCount++;
+    return true;
+}
+
+void InputRecorder::Close() {
+    if (mode == Mode::Off) {
+        return;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (mode == Mode::Record) {
+        file.flush();
+        std::cout << "[InputRecorder] Recorded " << frameCount << " frames ("
+                  << (frameCount * sizeof(InputFrame) + sizeof(InputLogHeader)) / 1024 << " KB) to " << path
+                  << std::endl;
+    } else {
+        // 回放报告: 实际墙钟耗时，用于在不同机器上对比同一会话的性能
+        double avgMs = frameCount > 0 ? elapsed * 1000.0 / frameCount : 0.0;
+        std::cout << "[InputRecorder] Replayed " << frameCount << " frames in " << elapsed << " s (avg " << avgMs
+                  << " ms/frame, " << (avgMs > 0.0 ? 1000.0 / avgMs : 0.0) << " FPS)" << std::endl;
+    }
+
+    file.close();
+    mode = Mode::Off;
+}
+
+void InputRecorder::PackHand(const HandState& hand, InputFrame& frame) {
+    frame.hasHand   = hand.hasHand ? 1 : 0;
+    frame.handScale = hand.scale;
+    frame.handRotX  = hand.rotX;
+    frame.handRotY  = hand.rotY;
+}
+
+HandState InputRecorder::UnpackHand(const InputFrame& frame) {
+    HandState hand;
+    hand.hasHand = frame.hasHand != 0;
+    hand.scale   = frame.handScale;
+    hand.rotX    = frame.handRotX;
+    hand.rotY    = frame.handRotY;
+    return hand;
+}
+
+void InputRecorder::PackLatch(bool latched, const HandState& hand, InputFrame& frame) {
+    frame.latched    = latched ? 1 : 0;
+    frame.latchScale = latched ? hand.scale : 0.0f;
+    frame.latchRotX  = latched ? hand.rotX : 0.0f;
+    frame.latchRotY  = latched ? hand.rotY : 0.0f;
+}
+
+bool InputRecorder::UnpackLatch(const InputFrame& frame, HandState& hand) {
+    if (!frame.latched) {
+        return false;
+    }
+    hand.hasHand = true;
+    hand.scale   = frame.latchScale;
+    hand.rotX    = frame.latchRotX;
+    hand.rotY    = frame.latchRotY;
+    return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+// 输入录制/回放 - 记录每帧输入到紧凑二进制日志，用于确定性性能复现
+// 录制: ParticleSaturn.exe --record session.psr
+// 回放: ParticleSaturn.exe --replay session.psr
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "Utils.h" // HandState
+
+// 按键位掩码 (与主循环的按键防抖逻辑对应)
+enum InputKeyBits : uint8_t {
+    INPUT_KEY_F3     = 1 << 0,
+    INPUT_KEY_B      = 1 << 1,
+    INPUT_KEY_F11    = 1 << 2,
+    INPUT_KEY_ESCAPE = 1 << 3,
+    INPUT_KEY_F9     = 1 << 4, // 开始 / 停止录制视频
+    INPUT_KEY_F12    = 1 << 5, // 截图
+};
+
+// 单帧输入记录 (磁盘格式，49 字节，小端序)
+// 手部数据按原始 float 保存，回放结果与录制时逐位一致
+// 帧开始的手部样本和提交前锁存的样本分别记录: 回放时按同样的顺序插值，粒子模拟和姿态都与录制时一致
+#pragma pack(push, 1)
+struct InputFrame {
+    float    time;          // 帧开始时间 (秒)，回放时替代 glfwGetTime()
+    float    dt;            // 帧间隔
+    uint16_t width;         // 帧缓冲宽度
+    uint16_t height;        // 帧缓冲高度
+    uint32_t particleCount; // LOD: 活跃粒子数
+    float    pixelRatio;    // LOD: 像素比例
+    float    handScale;     // HandState.scale
+    float    handRotX;      // HandState.rotX
+    float    handRotY;      // HandState.rotY
+    uint8_t  hasHand;       // HandState.hasHand
+    uint8_t  keys;          // InputKeyBits
+    uint8_t  fillSize;      // FillBudget: 点径上限 (量化，0 = 未记录)
+    uint8_t  fillDensity;   // FillBudget: 大粒子保留比例 (量化，0 = 未记录)
+    uint8_t  latched;       // 提交前锁存了更新的手部样本 (FramePacer::InputLatch)
+    float    latchScale;    // 锁存样本的 HandState.scale
+    float    latchRotX;     // 锁存样本的 HandState.rotX
+    float    latchRotY;     // 锁存样本的 HandState.rotY
+};
+#pragma pack(pop)
+static_assert(sizeof(InputFrame) == 49, "InputFrame must stay 49 bytes (on-disk format)");
+
+// 日志文件头
+#pragma pack(push, 1)
+struct InputLogHeader {
+    char     magic[4];     // "PSIR"
+    uint32_t version;      // 格式版本
+    uint32_t particleSeed; // 粒子初始化种子 (回放时复用，保证初始状态一致)
+    uint32_t reserved;
+};
+#pragma pack(pop)
+
+class InputRecorder {
+  public:
+    enum class Mode { Off, Record, Replay };
+
+    static constexpr uint32_t kVersion = 2; // 2: 记录提交前锁存的手部样本
+
+    // 开始录制，失败返回 false
+    bool BeginRecord(const std::string& path, uint32_t particleSeed);
+
+    // 开始回放，失败返回 false (文件不存在或格式不匹配)
+    bool BeginReplay(const std::string& path);
+
+    // 录制一帧 (仅 Record 模式有效)
+    void Write(const InputFrame& frame);
+
+    // 读取下一帧 (仅 Replay 模式有效)，日志结束时返回 false
+    bool Read(InputFrame& frame);
+
+    // 关闭日志并输出统计
+    void Close();
+
+    Mode     GetMode() const { return mode; }
+    bool     IsRecording() const { return mode == Mode::Record; }
+    bool     IsReplaying() const { return mode == Mode::Replay; }
+    uint32_t GetParticleSeed() const { return particleSeed; }
+    uint64_t GetFrameCount() const { return frameCount; }
+
+    // HandState 与磁盘格式互转
+    static void      PackHand(const HandState& hand, InputFrame& frame);
+    static HandState UnpackHand(const InputFrame& frame);
+    // 提交前锁存的样本 (只在锁存时有手)；UnpackLatch 在这一帧没有锁存时返回 false
+    static void PackLatch(bool latched, const HandState& hand, InputFrame& frame);
+    static bool UnpackLatch(const InputFrame& frame, HandState& hand);
+
+    ~InputRecorder() { Close(); }
+
+  private:
+    Mode                                  mode         = Mode::Off;
+    uint32_t                              particleSeed = 0;
+    uint64_t                              frameCount   = 0;
+    std::string                           path;
+    std::fstream                          file;
+    std::chrono::steady_clock::time_point startTime; // 用于回放结束时报告实际耗时
+};
@@ -134,6 +134,7 @@ struct Strings {
     const char* particles;
     const char* pixelRatio;
     const char* resolution;
+    const char* renderResolution;
     const char* handDetected;
     const char* yes;
     const char* no;
@@ -143,6 +144,9 @@ struct Strings {
     const char* animationRotY;
     const char* showCameraDebug;
     const char* darkMode;
+    const char* temporalAccum;
+    const char* particleSplat;
+    const char* saturnImpostor;
     const char* glassBlur;
     const char* blurStrength;
     const char* backdrop;
@@ -160,11 +164,56 @@ struct Strings {
     const char* simdScalar;
     const char* simdCurrent;
 
+    // Particle backend
+    const char* particleBackend;
+    const char* backendPointSprite;
+    const char* backendInstancedQuad;
+    const char* backendGeometryQuad;
+
     // VSync
     const char* vsync;
     const char* vsyncOff;
     const char* vsyncOn;
     const char* vsyncAdaptive;
+    const char* framePacing;
+    const char* inputLatency;
+    const char* paceWait;
+
+    // Power saving
+    const char* powerSaving;
+    const char* powerUsage;
+    const char* powerActive;
+    const char* powerUnfocused;
+    const char* powerOccluded;
+    const char* powerMinimized;
+
+    // Frame capture
+    const char* videoRecording;
+    const char* captureFrames;
+    const char* captureQueue;
+
+    // Input record/replay
+    const char* inputRecording;
+    const char* inputReplaying;
+
+    // Frame graph
+    const char* passTimings;
+    const char* passCulled;
+
+    // Frame time statistics
+    const char* frameTimes;
+    const char* frameInterval;
+    const char* cpuTime;
+    const char* gpuTime;
+
+    // GPU budget (dynamic LOD)
+    const char* gpuBudget;
+    const char* lodCostModel;
+
+    // Fill budget
+    const char* spriteOverdraw;
+    const char* pointSizeBudget;
+    const char* impostorActive;
 };
 
 // Chinese strings
@@ -293,6 +342,7 @@ inline const Strings& GetChinese() {
         .particles           = "粒子数",
         .pixelRatio          = "像素比例",
         .resolution          = "分辨率",
+        .renderResolution    = "渲染分辨率",
         .handDetected        = "检测到手势",
         .yes                 = "是",
         .no                  = "否",
@@ -302,6 +352,9 @@ inline const Strings& GetChinese() {
         .animationRotY       = "动画旋转Y",
         .showCameraDebug     = "显示摄像头调试窗口",
         .darkMode            = "深色模式",
+        .temporalAccum       = "粒子时间累积",
+        .particleSplat       = "小粒子计算光栅化",
+        .saturnImpostor      = "土星远景替身",
         .glassBlur           = "玻璃模糊",
         .blurStrength        = "模糊强度",
         .backdrop            = "背景",
@@ -319,11 +372,56 @@ inline const Strings& GetChinese() {
         .simdScalar      = "标量",
         .simdCurrent     = "当前实现",
 
+        // Particle backend
+        .particleBackend      = "粒子图元 (首次启动时自动选择)",
+        .backendPointSprite   = "点精灵",
+        .backendInstancedQuad = "实例化四边形",
+        .backendGeometryQuad  = "几何着色器四边形",
+
         // VSync
         .vsync         = "垂直同步",
         .vsyncOff      = "关闭",
         .vsyncOn       = "开启",
         .vsyncAdaptive = "自适应",
+        .framePacing   = "帧节奏控制 (降低输入延迟)",
+        .inputLatency  = "输入延迟 (平均 / 最大)",
+        .paceWait      = "帧前等待",
+
+        // Power saving
+        .powerSaving    = "省电模式 (最小化 / 遮挡 / 失去焦点)",
+        .powerUsage     = "各状态占用",
+        .powerActive    = "前台",
+        .powerUnfocused = "失去焦点",
+        .powerOccluded  = "被遮挡",
+        .powerMinimized = "最小化",
+
+        // Frame capture
+        .videoRecording = "录制视频 (F9，截图 F12)",
+        .captureFrames  = "已捕获 / 丢弃帧",
+        .captureQueue   = "读回 + 编码队列 (最大) / 编码耗时",
+
+        // Input record/replay
+        .inputRecording = "正在录制输入",
+        .inputReplaying = "正在回放输入",
+
+        // Frame graph
+        .passTimings = "各阶段 GPU 耗时",
+        .passCulled  = "已剔除",
+
+        // Frame time statistics
+        .frameTimes    = "帧时间 p50 / p95 / p99 / 最大 (最近 10 秒)",
+        .frameInterval = "帧间隔",
+        .cpuTime       = "CPU",
+        .gpuTime       = "GPU",
+
+        // GPU budget (dynamic LOD)
+        .gpuBudget    = "GPU 耗时 / 预算",
+        .lodCostModel = "代价模型 (固定 + 每百万粒子 + 每百万像素)",
+
+        // Fill budget
+        .spriteOverdraw  = "点精灵过绘制",
+        .pointSizeBudget = "点径上限 / 大粒子密度",
+        .impostorActive  = "土星替身绘制中 (屏幕直径)",
     };
     return zh;
 }
@@ -454,6 +552,7 @@ inline const Strings& GetEnglish() {
         .particles           = "Particles",
         .pixelRatio          = "Pixel Ratio",
         .resolution          = "Resolution",
+        .renderResolution    = "Render Resolution",
         .handDetected        = "Hand Detected",
         .yes                 = "Yes",
         .no                  = "No",
@@ -463,6 +562,9 @@ inline const Strings& GetEnglish() {
         .animationRotY       = "Animation RotY",
         .showCameraDebug     = "Show Camera Debug Window",
         .darkMode            = "Dark Mode",
+        .temporalAccum       = "Temporal Accumulation",
+        .particleSplat       = "Compute Splatting",
+        .saturnImpostor      = "Saturn Impostor",
         .glassBlur           = "Glass Blur",
         .blurStrength        = "Blur Strength",
         .backdrop            = "Backdrop",
@@ -480,11 +582,56 @@ inline const Strings& GetEnglish() {
         .simdScalar      = "Scalar",
         .simdCurrent     = "Current Impl",
 
+        // Particle backend
+        .particleBackend      = "Particle Primitive (auto-selected on first launch)",
+        .backendPointSprite   = "Point Sprites",
+        .backendInstancedQuad = "Instanced Quads",
+        .backendGeometryQuad  = "Geometry Shader Quads",
+
         // VSync
         .vsync         = "VSync",
         .vsyncOff      = "Off",
         .vsyncOn       = "On",
         .vsyncAdaptive = "Adaptive",
+        .framePacing   = "Frame Pacing (Low Latency)",
+        .inputLatency  = "Input Latency (avg / max)",
+        .paceWait      = "Pre-frame Wait",
+
+        // Power saving
+        .powerSaving    = "Power Saving (minimized / occluded / unfocused)",
+        .powerUsage     = "Usage by State",
+        .powerActive    = "Active",
+        .powerUnfocused = "Unfocused",
+        .powerOccluded  = "Occluded",
+        .powerMinimized = "Minimized",
+
+        // Frame capture
+        .videoRecording = "Record Video (F9, screenshot F12)",
+        .captureFrames  = "Captured / Dropped Frames",
+        .captureQueue   = "Readback + Encode Queue (max) / Encode Time",
+
+        // Input record/replay
+        .inputRecording = "Recording Input",
+        .inputReplaying = "Replaying Input",
+
+        // Frame graph
+        .passTimings = "Pass GPU Time",
+        .passCulled  = "culled",
+
+        // Frame time statistics
+        .frameTimes    = "Frame Time p50 / p95 / p99 / max (last 10 s)",
+        .frameInterval = "Frame",
+        .cpuTime       = "CPU",
+        .gpuTime       = "GPU",
+
+        // GPU budget (dynamic LOD)
+        .gpuBudget    = "GPU Time / Budget",
+        .lodCostModel = "Cost Model (fixed + per M particles + per MP)",
+
+        // Fill budget
+        .spriteOverdraw  = "Sprite Overdraw",
+        .pointSizeBudget = "Point Size Cap / Large Density",
+        .impostorActive  = "Saturn Impostor (screen diameter)",
     };
     return en;
 }
@@ -8,14 +8,33 @@
 #endif
 
 #include "AppState.h"
+#include "BlurPyramid.h"
 #include "CrashAnalyzer.h"
 #include "DebugLog.h"
 #include "ErrorHandler.h"
+#include "FBMNoise.h"
+#include "FillBudget.h"
+#include "FrameCapture.h"
+#include "FramePacer.h"
+#include "FrameGraph.h"
+#include "FrameStats.h"
+#include "GpuBudget.h"
 #include "HandTracker.h"
+#include "InputRecorder.h"
 #include "Localization.h"
+#include "ParticleBackend.h"
 #include "ParticleSystem.h"
+#include "PlanetSystem.h"
+#include "PointSplat.h"
+#include "PowerMode.h"
 #include "Renderer.h"
+#include "SaturnImpostor.h"
 #include "Shaders.h"
+#include "SoftRenderer.h"
+#include "StarCatalog.h"
+#include "StarField.h"
+#include "StartupGraph.h"
+#include "TemporalAccum.h"
 #include "UIManager.h"
 #include "Utils.h"
 #include "WindowManager.h"
@@ -32,7 +51,88 @@ void DropCallback(GLFWwindow* window, int count, const char** paths) {
     }
 }
 
-int main() {
+// 启动手部追踪 (加载模型并创建追踪线程)，不等待摄像头就绪，返回是否成功启动
+// 摄像头打开和模型加载在追踪线程中进行，主循环轮询 IsTrackerInitComplete() 后调用 FinishHandTracking()
+static bool StartHandTracking() {
+#ifdef EMBED_MODELS
+    std::cout << "[Main] Loading embedded models..." << std::endl;
+    HRSRC hPalmRes = FindResource(NULL, MAKEINTRESOURCE(IDR_PALM_MODEL), RT_RCDATA);
+    HRSRC hHandRes = FindResource(NULL, MAKEINTRESOURCE(IDR_HAND_MODEL), RT_RCDATA);
+    if (!hPalmRes || !hHandRes) {
+        std::cerr << "[Main] Warning: Failed to find embedded model resources" << std::endl;
+        std::ostringstream details;
+        details << "FindResource() failed:\n"
+                << "  Palm model: " << (hPalmRes ? "Found" : "NOT FOUND") << "\n"
+                << "  Hand model: " << (hHandRes ? "Found" : "NOT FOUND") << "\n\n"
+                << "The executable may be corrupted or built incorrectly.";
+        ErrorHandler::ShowWarning(i18n::Get().embeddedResourceFailed, details.str());
+    } else {
+        HGLOBAL hPalmData = LoadResource(NULL, hPalmRes);
+        HGLOBAL hHandData = LoadResource(NULL, hHandRes);
+        if (!hPalmData || !hHandData) {
+            std::cerr << "[Main] Warning: Failed to load embedded model resources" << std::endl;
+            ErrorHandler::ShowWarning(i18n::Get().embeddedResourceFailed, "LoadResource() failed");
+        } else {
+            const void* palmData = LockResource(hPalmData);
+            const void* handData = LockResource(hHandData);
+            DWORD       palmSize = SizeofResource(NULL, hPalmRes);
+            DWORD       handSize = SizeofResource(NULL, hHandRes);
+            SetEmbeddedModels(palmData, palmSize, handData, handSize);
+            std::cout << "[Main] Embedded models loaded (palm: " << palmSize << " bytes, hand: " << handSize
+                      << " bytes)" << std::endl;
+        }
+    }
+    const char* modelDir = nullptr;
+#else
+    std::cout << "[Main] Initializing HandTracker..." << std::endl;
+    const char* modelDir = ".";
+#endif
+    if (!InitTracker(0, modelDir)) {
+        std::cerr << "[Main] Warning: Failed to start HandTracker thread" << std::endl;
+        ErrorHandler::ShowWarning(i18n::Get().cameraInitFailed,
+                                  "InitTracker() returned false - thread creation failed");
+        return false;
+    }
+    return true;
+}
+
+// 追踪器初始化结束后调用，返回是否成功 (失败时弹出警告)
+static bool FinishHandTracking() {
+    if (!WaitForTrackerReady(0)) {
+        std::cerr << "[Main] Warning: HandTracker initialization failed" << std::endl;
+        int         errCode = GetTrackerLastError();
+        const char* errMsg  = GetTrackerLastErrorMessage();
+        const char* localizedMsg;
+        switch (errCode) {
+        case HANDTRACKER_ERROR_PALM_MODEL:
+            localizedMsg = i18n::Get().palmModelLoadFailed;
+            break;
+        case HANDTRACKER_ERROR_HAND_MODEL:
+            localizedMsg = i18n::Get().handModelLoadFailed;
+            break;
+        case HANDTRACKER_ERROR_NO_CAMERA:
+            localizedMsg = i18n::Get().cameraNotFound;
+            break;
+        case HANDTRACKER_ERROR_CAMERA_IN_USE:
+            localizedMsg = i18n::Get().cameraInUse;
+            break;
+        default:
+            localizedMsg = i18n::Get().cameraInitFailed;
+            break;
+        }
+        ErrorHandler::ShowWarning(localizedMsg, errMsg ? errMsg : "WaitForTrackerReady() returned false");
+        return false;
+    }
+
+    std::cout << "[Main] HandTracker initialized successfully." << std::endl;
+    ErrorHandler::SetCameraInfo(0, 640, 480, true);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    // 启动计时 (用于报告首帧时间)
+    auto appStartTime = std::chrono::steady_clock::now();
+
     // 创建应用程序状态
     AppState appState;
     appState.InitDefaults(MAX_PARTICLES);
@@ -47,6 +147,105 @@ int main() {
 
     std::cout << "[Main] Particle Saturn " << i18n::GetVersion() << " starting..." << std::endl;
 
+    // 输入录制/回放 (--record <file> / --replay <file>)，用于确定性复现性能问题
+    // --bench-fbm: 运行 FBM 噪声生成微基准后退出
+    // --bench-blur: 渲染第一帧后对比新旧模糊实现的 GPU 耗时，然后退出
+    // --bench-splat: 渲染第一帧后对比点精灵与点溅射混合路径的 GPU 耗时，然后退出
+    // --bench-backend: 渲染第一帧后重新比较各粒子图元后端并记录最快的，然后退出 (首次启动时自动比较，不退出)
+    // --stars <count>: 星空星星数量 (默认 STAR_COUNT)
+    // --catalog <file.psky>: 使用真实星表代替随机星空
+    // --planets <count>: 天体总数 (默认只有 3 颗预定义行星，多出的生成为小行星带)
+    // --convert-catalog <in.csv> <out.psky>: 把 CSV 星表转换为二进制天空格式后退出
+    // --seed <n>: 固定粒子随机种子 (默认取当前时间)
+    // --render-cpu <out.png|out.exr>: 用 CPU 软件渲染器渲染一帧后退出，不创建窗口 (基准图像需配合 --seed)
+    //   --render-size <w>x<h> / --render-time <秒>: 渲染尺寸 (默认 1920x1080) 和动画时间 (默认 0)
+    // --image-diff <a.png> <b.png>: 逐像素比较两张图像，超出容差时退出码为 1
+    //   --diff-tolerance <色阶> / --diff-max-bad <比例> / --diff-out <heat.png>: 容差、允许超差的像素比例和误差热图
+    // --capture <out.y4m|prefix>: 启动后立即录制视频 (Y4M 或 PNG 序列，配合 --replay 可把录制的会话渲染成视频)
+    //   --capture-fps <n>: 视频采样帧率 (默认 30)
+    InputRecorder inputRecorder;
+    unsigned int  particleSeed = (unsigned int)time(0);
+    uint32_t      starCount    = STAR_COUNT;
+    std::string   catalogPath;
+    uint32_t      planetTotal  = PlanetConstants::kPlanetCount;
+    bool          benchBlur    = false;
+    bool          benchSplat   = false;
+    bool          benchBackend = false;
+    std::string   capturePath;
+    int           captureFps = FrameCapture::kDefaultVideoFps;
+
+    // 无头模式: 渲染输出路径 / 待比较的两张图像
+    std::string               renderCpuPath;
+    std::string               diffPaths[2];
+    SoftRenderer::View        renderView;
+    SoftRenderer::DiffOptions diffOptions;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            inputRecorder.BeginRecord(argv[++i], particleSeed);
+        } else if (arg == "--replay" && i + 1 < argc) {
+            if (inputRecorder.BeginReplay(argv[++i])) {
+                particleSeed = inputRecorder.GetParticleSeed();
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            particleSeed = (unsigned int)atoll(argv[++i]);
+        } else if (arg == "--stars" && i + 1 < argc) {
+            starCount = (uint32_t)std::clamp(atoll(argv[++i]), 1000ll, 8000000ll);
+        } else if (arg == "--planets" && i + 1 < argc) {
+            planetTotal = (uint32_t)std::clamp(atoll(argv[++i]), (long long)PlanetConstants::kPlanetCount,
+                                               (long long)PlanetSystem::kMaxInstances);
+        } else if (arg == "--catalog" && i + 1 < argc) {
+            catalogPath = argv[++i];
+        } else if (arg == "--convert-catalog" && i + 2 < argc) {
+            return StarCatalog::Convert(argv[i + 1], argv[i + 2]) ? 0 : 1;
+        } else if (arg == "--render-cpu" && i + 1 < argc) {
+            renderCpuPath = argv[++i];
+        } else if (arg == "--render-size" && i + 1 < argc) {
+            std::string size = argv[++i];
+            size_t      x    = size.find('x');
+            if (x != std::string::npos) {
+                renderView.width  = std::clamp(atoi(size.c_str()), 16, 16384);
+                renderView.height = std::clamp(atoi(size.c_str() + x + 1), 16, 16384);
+            }
+        } else if (arg == "--render-time" && i + 1 < argc) {
+            renderView.time = (float)atof(argv[++i]);
+        } else if (arg == "--image-diff" && i + 2 < argc) {
+            diffPaths[0] = argv[++i];
+            diffPaths[1] = argv[++i];
+        } else if (arg == "--diff-tolerance" && i + 1 < argc) {
+            diffOptions.tolerance = std::clamp(atoi(argv[++i]), 0, 255);
+        } else if (arg == "--diff-max-bad" && i + 1 < argc) {
+            diffOptions.maxBadFraction = std::clamp(atof(argv[++i]), 0.0, 1.0);
+        } else if (arg == "--diff-out" && i + 1 < argc) {
+            diffOptions.diffImage = argv[++i];
+        } else if (arg == "--capture" && i + 1 < argc) {
+            capturePath = argv[++i];
+        } else if (arg == "--capture-fps" && i + 1 < argc) {
+            captureFps = std::clamp(atoi(argv[++i]), 1, 240);
+        } else if (arg == "--bench-blur") {
+            benchBlur = true;
+        } else if (arg == "--bench-splat") {
+            benchSplat = true;
+        } else if (arg == "--bench-backend") {
+            benchBackend = true;
+        } else if (arg == "--bench-fbm") {
+            FBMNoise::RunBenchmark();
+            return 0;
+        }
+    }
+
+    // 无头模式 (构建机上的预览和基准图像回归测试): 不创建窗口，也不需要 GPU
+    if (!renderCpuPath.empty()) {
+        SoftRenderer::SceneParams sceneParams;
+        sceneParams.particleSeed = particleSeed;
+        sceneParams.starCount    = starCount;
+        sceneParams.planetCount  = planetTotal;
+        return SoftRenderer::RenderToFile(renderCpuPath, sceneParams, renderView) ? 0 : 1;
+    }
+    if (!diffPaths[0].empty()) {
+        return SoftRenderer::CompareImages(diffPaths[0], diffPaths[1], diffOptions) ? 0 : 1;
+    }
+
     ErrorHandler::SetStage(ErrorHandler::AppStage::WINDOW_INIT);
 
     // 初始化 GLFW
@@ -115,6 +314,8 @@ int main() {
     SetAppState(window, &appState);
 
     glfwSetFramebufferSizeCallback(window, WindowManager::FramebufferSizeCallback);
+    glfwSetWindowIconifyCallback(window, WindowManager::WindowIconifyCallback);
+    glfwSetWindowFocusCallback(window, WindowManager::WindowFocusCallback);
     glfwSetDropCallback(window, DropCallback);
 
     // Store OpenGL info for crash reports
@@ -124,6 +325,55 @@ int main() {
     ErrorHandler::SetGPUInfo(appState.gl.renderer, appState.gl.version);
     std::cout << "[Main] OpenGL: " << appState.gl.version << std::endl;
 
+    // 程序二进制缓存 (需要 GL_RENDERER/GL_VERSION 作为缓存键)
+    Renderer::InitProgramCache();
+    Renderer::InitParallelShaderCompile();
+
+    // 启动任务图: 纯 CPU 的资源生成在工作线程执行，主线程同时进行 GL 初始化和着色器编译
+    // 星空缓冲先在主线程创建并持久映射，工作线程直接写入映射内存 (星表文件内存映射后解码，否则随机生成)
+    StarField::Params       starParams;
+    StarField::StarBuffer   stars;
+    StarField::SkyIndex     starIndex; // 天区 / 亮度索引，用于每帧按预算选择星星
+    StarField::LODSelection starLOD;
+    StarCatalog::Catalog    starCatalog;
+    starParams.count = starCount;
+    if (!catalogPath.empty() && starCatalog.Open(catalogPath)) {
+        starParams.count = starCatalog.GetCount();
+    }
+    StarField::BeginUpload(stars, starParams.count);
+
+    PlanetSystem::LodMeshes    planetMeshes;
+    std::vector<PlanetData>    planetBodies;
+    std::vector<unsigned char> fbmData;
+    FBMNoise::Params           fbmParams; // 512x512 可平铺，按参数哈希缓存到磁盘
+    StartupGraph               startup;
+    startup.Add("stars", {}, [&] {
+        if (starCatalog.IsOpen()) {
+            starCatalog.Decode(stars.mapped, &starIndex);
+        } else {
+            StarField::Generate(starParams, stars.mapped, &starIndex);
+        }
+    });
+    startup.Add("planets", {}, [&] {
+        planetMeshes = PlanetSystem::BuildLodMeshes();
+        planetBodies.assign(std::begin(PlanetConstants::kPlanets), std::end(PlanetConstants::kPlanets));
+        std::vector<PlanetData> extra = PlanetSystem::GenerateBodies(planetTotal - PlanetConstants::kPlanetCount, 1);
+        planetBodies.insert(planetBodies.end(), extra.begin(), extra.end());
+    });
+    startup.Add("fbm", {}, [&] { fbmData = FBMNoise::GenerateCached(fbmParams); });
+    startup.Start();
+
+    // 启动阶段等待后台任务/着色器编译时处理窗口消息，避免窗口无响应
+    auto pumpEvents = [] { glfwPollEvents(); };
+
+    // 启动失败时退出: 先等后台任务结束 (星空任务还在写映射的顶点缓冲)，再销毁窗口和上下文
+    auto shutdownEarly = [&] {
+        startup.Join();
+        UIManager::Shutdown();
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    };
+
 #ifdef _WIN32
     ImmAssociateContext(glfwGetWin32Window(window), NULL);
 
@@ -140,204 +390,77 @@ int main() {
     }
 #endif
 
-    // 初始化手部追踪
+    // 启动手部追踪 (回放模式下手部数据来自日志，无需摄像头)
+    // 不等待摄像头就绪: 首帧先显示，追踪器在主循环中就绪后再开始读取
     ErrorHandler::SetStage(ErrorHandler::AppStage::HAND_TRACKER_INIT);
-    bool handTrackerInitialized = false;
-#ifdef EMBED_MODELS
-    std::cout << "[Main] Loading embedded models..." << std::endl;
-    HRSRC hPalmRes = FindResource(NULL, MAKEINTRESOURCE(IDR_PALM_MODEL), RT_RCDATA);
-    HRSRC hHandRes = FindResource(NULL, MAKEINTRESOURCE(IDR_HAND_MODEL), RT_RCDATA);
-    if (!hPalmRes || !hHandRes) {
-        std::cerr << "[Main] Warning: Failed to find embedded model resources" << std::endl;
-        std::ostringstream details;
-        details << "FindResource() failed:\n"
-                << "  Palm model: " << (hPalmRes ? "Found" : "NOT FOUND") << "\n"
-                << "  Hand model: " << (hHandRes ? "Found" : "NOT FOUND") << "\n\n"
-                << "The executable may be corrupted or built incorrectly.";
-        ErrorHandler::ShowWarning(i18n::Get().embeddedResourceFailed, details.str());
+    bool trackerPending = false;
+    if (inputRecorder.IsReplaying()) {
+        std::cout << "[Main] Replay mode: HandTracker disabled" << std::endl;
     } else {
-        HGLOBAL hPalmData = LoadResource(NULL, hPalmRes);
-        HGLOBAL hHandData = LoadResource(NULL, hHandRes);
-        if (!hPalmData || !hHandData) {
-            std::cerr << "[Main] Warning: Failed to load embedded model resources" << std::endl;
-            ErrorHandler::ShowWarning(i18n::Get().embeddedResourceFailed, "LoadResource() failed");
-        } else {
-            const void* palmData = LockResource(hPalmData);
-            const void* handData = LockResource(hHandData);
-            DWORD       palmSize = SizeofResource(NULL, hPalmRes);
-            DWORD       handSize = SizeofResource(NULL, hHandRes);
-            SetEmbeddedModels(palmData, palmSize, handData, handSize);
-            std::cout << "[Main] Embedded models loaded (palm: " << palmSize << " bytes, hand: " << handSize
-                      << " bytes)" << std::endl;
-        }
+        trackerPending = StartHandTracking();
     }
-    if (!InitTracker(0, nullptr)) {
-        std::cerr << "[Main] Warning: Failed to start HandTracker thread" << std::endl;
-        ErrorHandler::ShowWarning(i18n::Get().cameraInitFailed,
-                                  "InitTracker() returned false - thread creation failed");
-    } else if (!WaitForTrackerReady(5000)) {
-        // 等待初始化完成（最多 5 秒）
-        std::cerr << "[Main] Warning: HandTracker initialization failed" << std::endl;
-        int         errCode = GetTrackerLastError();
-        const char* errMsg  = GetTrackerLastErrorMessage();
-        const char* localizedMsg;
-        switch (errCode) {
-        case HANDTRACKER_ERROR_PALM_MODEL:
-            localizedMsg = i18n::Get().palmModelLoadFailed;
-            break;
-        case HANDTRACKER_ERROR_HAND_MODEL:
-            localizedMsg = i18n::Get().handModelLoadFailed;
-            break;
-        case HANDTRACKER_ERROR_NO_CAMERA:
-            localizedMsg = i18n::Get().cameraNotFound;
-            break;
-        case HANDTRACKER_ERROR_CAMERA_IN_USE:
-            localizedMsg = i18n::Get().cameraInUse;
-            break;
-        default:
-            localizedMsg = i18n::Get().cameraInitFailed;
-            break;
-        }
-        ErrorHandler::ShowWarning(localizedMsg, errMsg ? errMsg : "WaitForTrackerReady() returned false");
-    } else {
-        std::cout << "[Main] HandTracker initialized successfully." << std::endl;
-        handTrackerInitialized = true;
-        ErrorHandler::SetCameraInfo(0, 640, 480, true);
-    }
-#else
-    std::cout << "[Main] Initializing HandTracker..." << std::endl;
-    if (!InitTracker(0, ".")) {
-        std::cerr << "[Main] Warning: Failed to start HandTracker thread" << std::endl;
-        ErrorHandler::ShowWarning(i18n::Get().cameraInitFailed,
-                                  "InitTracker() returned false - thread creation failed");
-    } else if (!WaitForTrackerReady(5000)) {
-        // 等待初始化完成（最多 5 秒）
-        std::cerr << "[Main] Warning: HandTracker initialization failed" << std::endl;
-        int         errCode = GetTrackerLastError();
-        const char* errMsg  = GetTrackerLastErrorMessage();
-        const char* localizedMsg;
-        switch (errCode) {
-        case HANDTRACKER_ERROR_PALM_MODEL:
-            localizedMsg = i18n::Get().palmModelLoadFailed;
-            break;
-        case HANDTRACKER_ERROR_HAND_MODEL:
-            localizedMsg = i18n::Get().handModelLoadFailed;
-            break;
-        case HANDTRACKER_ERROR_NO_CAMERA:
-            localizedMsg = i18n::Get().cameraNotFound;
-            break;
-        case HANDTRACKER_ERROR_CAMERA_IN_USE:
-            localizedMsg = i18n::Get().cameraInUse;
-            break;
-        default:
-            localizedMsg = i18n::Get().cameraInitFailed;
-            break;
-        }
-        ErrorHandler::ShowWarning(localizedMsg, errMsg ? errMsg : "WaitForTrackerReady() returned false");
-    } else {
-        std::cout << "[Main] HandTracker initialized successfully." << std::endl;
-        handTrackerInitialized = true;
-        ErrorHandler::SetCameraInfo(0, 640, 480, true);
-    }
-#endif
+    auto trackerStartTime = std::chrono::steady_clock::now();
 
     ErrorHandler::SetStage(ErrorHandler::AppStage::IMGUI_INIT);
     UIManager::Init(window, appState);
 
-    // 初始化 MD3 UI 系统
+    // 初始化 MD3 UI 系统 (Ripple 着色器也走程序二进制缓存)
+    MD3::SetProgramFactory(Renderer::CreateProgram);
     MD3::Init(appState.ui.dpiScale);
     MD3::SetDarkMode(appState.ui.isDarkMode);
     MD3::SetScreenSize((float)appState.window.width, (float)appState.window.height);
 
-    // 创建着色器程序
+    // 提交着色器程序 (批量提交，驱动支持时在后台并行编译，结果在资源上传后统一检查)
     ErrorHandler::SetStage(ErrorHandler::AppStage::SHADER_COMPILE);
-    unsigned int pSaturn = Renderer::CreateProgram(Shaders::VertexSaturn, Shaders::FragmentSaturn);
-    unsigned int pStar   = Renderer::CreateProgram(Shaders::VertexStar, Shaders::FragmentStar);
-    unsigned int pPlanet = Renderer::CreateProgram(Shaders::VertexPlanet, Shaders::FragmentPlanet);
-    unsigned int pUI     = Renderer::CreateProgram(Shaders::VertexUI, Shaders::FragmentUI);
-    unsigned int pQuad   = Renderer::CreateProgram(Shaders::VertexQuad, Shaders::FragmentQuad);
-    unsigned int pBlur   = Renderer::CreateProgram(Shaders::VertexQuad, Shaders::FragmentBlur);
-
-    // 检查核心着色器是否编译成功
-    if (!pSaturn || !pStar || !pPlanet || !pUI || !pQuad || !pBlur) {
-        std::cerr << "[Main] Fatal: Core shader compilation failed" << std::endl;
-        std::ostringstream details;
-        details << "Shader compilation status:\n"
-                << "  pSaturn: " << (pSaturn ? "OK" : "FAILED") << "\n"
-                << "  pStar:   " << (pStar ? "OK" : "FAILED") << "\n"
-                << "  pPlanet: " << (pPlanet ? "OK" : "FAILED") << "\n"
-                << "  pUI:     " << (pUI ? "OK" : "FAILED") << "\n"
-                << "  pQuad:   " << (pQuad ? "OK" : "FAILED") << "\n"
-                << "  pBlur:   " << (pBlur ? "OK" : "FAILED") << "\n\n"
-                << "GPU: " << appState.gl.renderer << "\n"
-                << "OpenGL: " << appState.gl.version;
-        ErrorHandler::ShowError(i18n::Get().shaderCompileFailed, details.str());
-        UIManager::Shutdown();
-        glfwDestroyWindow(window);
-        glfwTerminate();
-        return -1;
-    }
-
-    // 创建计算着色器
-    unsigned int cs = glCreateShader(GL_COMPUTE_SHADER);
-    glShaderSource(cs, 1, &Shaders::ComputeSaturn, 0);
-    glCompileShader(cs);
-    if (!Renderer::CheckShaderCompileStatus(cs, "Compute")) {
-        std::cerr << "[Main] Fatal: Compute shader compilation failed" << std::endl;
-        ErrorHandler::ShowError(i18n::Get().shaderCompileFailed, "Compute shader compilation failed");
-        glDeleteShader(cs);
-        UIManager::Shutdown();
-        glfwDestroyWindow(window);
-        glfwTerminate();
-        return -1;
-    }
-
-    unsigned int pComp = glCreateProgram();
-    glAttachShader(pComp, cs);
-    glLinkProgram(pComp);
-    glDeleteShader(cs);
-
-    if (!Renderer::CheckProgramLinkStatus(pComp)) {
-        std::cerr << "[Main] Fatal: Compute program linking failed" << std::endl;
-        ErrorHandler::ShowError(i18n::Get().shaderCompileFailed, "Compute shader program linking failed");
-        glDeleteProgram(pComp);
-        UIManager::Shutdown();
-        glfwDestroyWindow(window);
-        glfwTerminate();
-        return -1;
-    }
-
-    // 离屏渲染 FBO
-    unsigned int fbo, fboTex, rbo;
-    glGenFramebuffers(1, &fbo);
-    glGenTextures(1, &fboTex);
-    glGenRenderbuffers(1, &rbo);
-
-    // 优化: 使用 R11F_G11F_B10F 格式 (4字节/像素) 替代 RGBA16F (8字节/像素)
-    // R11F_G11F_B10F 是紧凑的 HDR 格式，足够存储加法混合的高光值
-    // 返回 true 表示成功，false 表示失败
-    auto resizeFBO = [&](int width, int height) -> bool {
-        glBindTexture(GL_TEXTURE_2D, fboTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, width, height, 0, GL_RGB, GL_FLOAT, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glBindRenderbuffer(GL_RENDERBUFFER, rbo);
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
-        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fboTex, 0);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo);
-
-        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-        if (status != GL_FRAMEBUFFER_COMPLETE) {
-            std::cerr << "[Main] FBO incomplete, status: 0x" << std::hex << status << std::dec << std::endl;
-            return false;
-        }
-        return true;
+    unsigned int           pSaturn = 0, pStar = 0, pStarLayer = 0, pPlanet = 0, pUI = 0, pQuad = 0;
+    unsigned int           pBlur = 0, pBlurDown = 0, pBlurUp = 0, pComp = 0, pPlanetCull = 0, pEASU = 0;
+    unsigned int           pAccum = 0, pCopy = 0, pSplatBin = 0, pSplatScan = 0, pSplatScatter = 0, pSplatRaster = 0;
+    unsigned int           pImpostor = 0, pSaturnQuad = 0, pSaturnGeometry = 0;
+    Renderer::ProgramBatch programs;
+    programs.Add(&pSaturn, Shaders::VertexSaturn, Shaders::FragmentSaturn, "saturn");
+    programs.Add(&pStar, Shaders::VertexStar, Shaders::FragmentStar, "star");
+    programs.Add(&pStarLayer, Shaders::VertexQuad, Shaders::FragmentStarLayer, "star_layer");
+    programs.Add(&pPlanet, Shaders::VertexPlanet, Shaders::FragmentPlanet, "planet");
+    programs.Add(&pUI, Shaders::VertexUI, Shaders::FragmentUI, "ui");
+    programs.Add(&pQuad, Shaders::VertexQuad, Shaders::FragmentQuad, "quad");
+    programs.Add(&pEASU, Shaders::VertexQuad, Shaders::FragmentEASU, "easu");
+    programs.Add(&pAccum, Shaders::VertexQuad, Shaders::FragmentTemporalAccum, "temporal_accum");
+    programs.Add(&pCopy, Shaders::VertexQuad, Shaders::FragmentCopy, "copy");
+    programs.Add(&pBlur, Shaders::VertexQuad, Shaders::FragmentBlur, "blur");
+    programs.Add(&pImpostor, Shaders::VertexImpostor, Shaders::FragmentImpostor, "saturn_impostor");
+    programs.AddCompute(&pComp, Shaders::ComputeSaturn, "compute");
+    programs.AddCompute(&pPlanetCull, Shaders::ComputePlanetCull, "planet_cull");
+    programs.AddCompute(&pBlurDown, Shaders::ComputeBlurDown, "blur_down");
+    programs.AddCompute(&pBlurUp, Shaders::ComputeBlurUp, "blur_up");
+    programs.AddCompute(&pSplatBin, Shaders::ComputeSplatBin, "splat_bin");
+    programs.AddCompute(&pSplatScan, Shaders::ComputeSplatScan, "splat_scan");
+    programs.AddCompute(&pSplatScatter, Shaders::ComputeSplatScatter, "splat_scatter");
+    programs.AddCompute(&pSplatRaster, Shaders::ComputeSplatRaster, "splat_raster");
+    // 可选的粒子图元后端单独成批 (同时提交、并行编译)，编译失败只是该后端不可用
+    Renderer::ProgramBatch backendPrograms;
+    backendPrograms.Add(&pSaturnQuad, Shaders::VertexSaturnQuad, Shaders::FragmentSaturnQuad, "saturn_quad");
+    backendPrograms.AddGeometry(&pSaturnGeometry, Shaders::VertexSaturn, Shaders::GeometrySaturnQuad,
+                                Shaders::FragmentSaturnQuad, "saturn_geometry");
+
+    // 帧图: 渲染目标由帧图的池管理，pass 在主循环前注册，每帧声明依赖后执行
+    // 场景颜色: R11F_G11F_B10F 格式 (4字节/像素)，紧凑的 HDR 格式，足够存储加法混合的高光值
+    // 动态分辨率: 场景按 LOD 控制器的 pixelRatio 缩放渲染，合成前放大回窗口分辨率 (UI 始终为原生分辨率)
+    auto scaledSize = [](unsigned int size, float scale) {
+        return std::max(1, (int)((float)size * std::min(scale, 1.0f) + 0.5f));
     };
-
-    if (!resizeFBO(appState.window.width, appState.window.height)) {
+    FrameGraph::Graph       frameGraph;
+    FrameGraph::TextureDesc sceneDesc      = {scaledSize(appState.window.width, appState.render.pixelRatio),
+                                              scaledSize(appState.window.height, appState.render.pixelRatio),
+                                              GL_R11F_G11F_B10F, true};
+    FrameGraph::TextureDesc upscaledDesc   = {(int)appState.window.width, (int)appState.window.height,
+                                              GL_R11F_G11F_B10F, false};
+    FrameGraph::TextureDesc particleDesc   = {sceneDesc.width, sceneDesc.height, GL_R11F_G11F_B10F, false};
+    FrameGraph::ResourceId  rScene         = frameGraph.CreateTexture("scene", sceneDesc);
+    FrameGraph::ResourceId  rUpscaled      = frameGraph.CreateTexture("upscaled", upscaledDesc);
+    FrameGraph::ResourceId  rParticleLayer = frameGraph.CreateTexture("particle_layer", particleDesc);
+    FrameGraph::ResourceId  rSplat         = frameGraph.CreateTexture("particle_splat", particleDesc);
+
+    if (!frameGraph.Prewarm(rScene)) {
         std::cerr << "[Main] Fatal: Failed to create main framebuffer" << std::endl;
         std::ostringstream details;
         details << "glCheckFramebufferStatus() != GL_FRAMEBUFFER_COMPLETE\n\n"
@@ -345,16 +468,25 @@ int main() {
                 << "GPU: " << appState.gl.renderer << "\n"
                 << "OpenGL: " << appState.gl.version;
         ErrorHandler::ShowError(i18n::Get().fboCreateFailed, details.str());
-        UIManager::Shutdown();
-        glfwDestroyWindow(window);
-        glfwTerminate();
+        shutdownEarly();
         return -1;
     }
 
-    // 模糊效果 FBO
-    BlurFramebuffer fboBlur1, fboBlur2;
-    fboBlur1.Init(appState.window.width / 6, appState.window.height / 6);
-    fboBlur2.Init(appState.window.width / 6, appState.window.height / 6);
+    // 玻璃模糊金字塔 (各级尺寸由主 FBO 尺寸决定)
+    BlurPyramid::Pyramid blurPyramid;
+    blurPyramid.Init(sceneDesc.width, sceneDesc.height, appState.window.width, appState.window.height);
+
+    // 粒子时间累积的历史 (与场景同尺寸)
+    TemporalAccum::Accumulator particleAccum;
+    particleAccum.Init(sceneDesc.width, sceneDesc.height);
+
+    // 小粒子的计算光栅化 (分块缓冲与场景同尺寸)
+    PointSplat::Rasterizer pointSplat;
+    pointSplat.Init(sceneDesc.width, sceneDesc.height, MAX_PARTICLES);
+
+    // 星空缓存层 (窗口分辨率，不随动态分辨率缩放；合成时按纹理坐标重投影)
+    StarField::StarLayer starLayer;
+    starLayer.Init(appState.window.width, appState.window.height);
 
     // 全屏四边形 VAO
     unsigned int vaoQuad, vboQuad;
@@ -371,7 +503,7 @@ int main() {
     // 初始化粒子系统 (双缓冲)
     ErrorHandler::SetStage(ErrorHandler::AppStage::PARTICLE_INIT);
     DoubleBufferSSBO particleBuffers;
-    if (!ParticleSystem::InitParticlesGPU(particleBuffers)) {
+    if (!ParticleSystem::InitParticlesGPU(particleBuffers, particleSeed)) {
         std::cerr << "[Main] Fatal: Failed to initialize particle system" << std::endl;
         // 检查是否是显存不足
         bool               isOutOfMemory = ParticleSystem::g_lastError.find("OUT_OF_MEMORY") != std::string::npos;
@@ -382,26 +514,85 @@ int main() {
                 << "GPU: " << appState.gl.renderer << "\n"
                 << "OpenGL: " << appState.gl.version;
         ErrorHandler::ShowError(message, details.str());
-        UIManager::Shutdown();
-        glfwDestroyWindow(window);
-        glfwTerminate();
+        shutdownEarly();
         return -1;
     }
 
-    // 创建星空背景
-    unsigned int vaoStars, vboStars;
-    ParticleSystem::CreateStars(vaoStars, vboStars);
+    // 上传后台生成的资源 (GL 调用只能在主线程)
+    // 任务失败 (例如星星数过大时内存不足) 时数据不完整，不能上传，按致命错误退出
+    auto waitStartupTask = [&](const char* name) {
+        if (startup.Wait(name, pumpEvents)) {
+            return true;
+        }
+        std::cerr << "[Main] Fatal: Startup task '" << name << "' failed" << std::endl;
+        std::ostringstream details;
+        details << "StartupGraph task '" << name << "' failed\n\n"
+                << "Stars: " << starParams.count << "\n"
+                << "Planets: " << planetTotal << "\n"
+                << "GPU: " << appState.gl.renderer << "\n"
+                << "OpenGL: " << appState.gl.version;
+        ErrorHandler::ShowError(i18n::Get().unexpectedError, details.str());
+        shutdownEarly();
+        return false;
+    };
+
+    // 星空背景 (提交映射写入)
+    if (!waitStartupTask("stars")) {
+        return -1;
+    }
+    StarField::EndUpload(stars);
+    starCatalog.Close();
 
-    // 创建行星网格
-    unsigned int vaoPlanet, idxPlanet;
-    Renderer::CreateSphere(vaoPlanet, idxPlanet, 1.0f);
+    // 行星 LOD 网格和实例缓冲
+    PlanetSystem::PlanetRenderer planetRenderer;
+    if (!waitStartupTask("planets")) {
+        return -1;
+    }
+    planetRenderer.Init(planetMeshes, (uint32_t)planetBodies.size());
 
-    // 生成 FBM 噪声纹理 (预计算替代程序化噪声)
-    unsigned int fbmTexture = Renderer::GenerateFBMTexture();
+    // FBM 噪声纹理 (预计算替代程序化噪声)
+    if (!waitStartupTask("fbm")) {
+        return -1;
+    }
+    unsigned int fbmTexture = Renderer::CreateFBMTexture(fbmData, fbmParams.width, fbmParams.height);
+    startup.Join();
+    planetMeshes = {};
+    fbmData      = {};
 
-    // 使用预定义的行星常量数据
-    const auto& planets     = PlanetConstants::kPlanets;
-    const int   planetCount = PlanetConstants::kPlanetCount;
+    // 检查核心着色器是否编译成功
+    ErrorHandler::SetStage(ErrorHandler::AppStage::SHADER_COMPILE);
+    if (!programs.Finish(pumpEvents)) {
+        std::cerr << "[Main] Fatal: Core shader compilation failed" << std::endl;
+        std::ostringstream details;
+        details << "Shader compilation status:\n"
+                << "  pSaturn: " << (pSaturn ? "OK" : "FAILED") << "\n"
+                << "  pStar:   " << (pStar ? "OK" : "FAILED") << "\n"
+                << "  pStarLayer: " << (pStarLayer ? "OK" : "FAILED") << "\n"
+                << "  pPlanet: " << (pPlanet ? "OK" : "FAILED") << "\n"
+                << "  pPlanetCull: " << (pPlanetCull ? "OK" : "FAILED") << "\n"
+                << "  pUI:     " << (pUI ? "OK" : "FAILED") << "\n"
+                << "  pQuad:   " << (pQuad ? "OK" : "FAILED") << "\n"
+                << "  pEASU:   " << (pEASU ? "OK" : "FAILED") << "\n"
+                << "  pAccum:  " << (pAccum ? "OK" : "FAILED") << "\n"
+                << "  pCopy:   " << (pCopy ? "OK" : "FAILED") << "\n"
+                << "  pBlur:   " << (pBlur ? "OK" : "FAILED") << "\n"
+                << "  pImpostor: " << (pImpostor ? "OK" : "FAILED") << "\n"
+                << "  pBlurDown: " << (pBlurDown ? "OK" : "FAILED") << "\n"
+                << "  pBlurUp: " << (pBlurUp ? "OK" : "FAILED") << "\n"
+                << "  pSplatBin: " << (pSplatBin ? "OK" : "FAILED") << "\n"
+                << "  pSplatScan: " << (pSplatScan ? "OK" : "FAILED") << "\n"
+                << "  pSplatScatter: " << (pSplatScatter ? "OK" : "FAILED") << "\n"
+                << "  pSplatRaster: " << (pSplatRaster ? "OK" : "FAILED") << "\n"
+                << "  pComp:   " << (pComp ? "OK" : "FAILED") << "\n\n"
+                << Renderer::GetLastProgramError() << "\n\n"
+                << "GPU: " << appState.gl.renderer << "\n"
+                << "OpenGL: " << appState.gl.version;
+        ErrorHandler::ShowError(i18n::Get().shaderCompileFailed, details.str());
+        shutdownEarly();
+        return -1;
+    }
+    backendPrograms.Finish(pumpEvents);
+    Renderer::LogProgramCacheStats();
 
     // 预生成数字几何 (FPS 显示优化)
     Renderer::PrebuiltDigits prebuiltDigits;
@@ -413,7 +604,20 @@ int main() {
 
     // 初始化 Uniform 缓存
     UniformCache uc;
-    Renderer::InitUniformCache(uc, pComp, pSaturn, pStar, pPlanet, pUI, pBlur, pQuad);
+    Renderer::InitUniformCache(uc, pComp, pSaturn, pStar, pStarLayer, pPlanet, pPlanetCull, pUI, pBlur, pBlurDown,
+                               pBlurUp, pEASU, pAccum, pCopy, pSplatBin, pSplatScan, pSplatScatter, pImpostor, pQuad);
+
+    // 土星粒子的图元后端: 使用上次在这块 GPU 上测得最快的；没有记录或该后端已不可用时，第一帧之后测量
+    ParticleBackend::Backends particleBackends;
+    particleBackends.Init({pSaturn, pSaturnQuad, pSaturnGeometry});
+    ParticleBackend::Backend cachedBackend = ParticleBackend::Backend::PointSprite;
+    bool                     backendChosen = !benchBackend && ParticleBackend::LoadChoice(cachedBackend);
+    backendChosen                          = backendChosen && particleBackends.IsSupported(cachedBackend);
+    appState.render.particleBackend        = backendChosen ? (int)cachedBackend : 0;
+    if (backendChosen) {
+        std::cout << "[Main] Particle backend: " << ParticleBackend::GetName(cachedBackend) << " (cached)"
+                  << std::endl;
+    }
 
     // 投影和视图矩阵
     glm::mat4 proj   = glm::perspective(1.047f, (float)appState.window.width / appState.window.height, 1.f, 10000.f);
@@ -424,119 +628,184 @@ int main() {
     SmoothState currentAnim;
     float       autoTime = 0;
 
-    // 异步手部追踪器 (优化: 消除主线程阻塞)
-    AsyncHandTracker asyncTracker;
-    if (handTrackerInitialized) {
-        asyncTracker.Start();
+    // 有手时跟随手部姿态 (帧开始和提交前的输入锁存共用)
+    auto followHand = [&](const HandState& hand) {
+        float targetScale = hand.scale;
+        float targetRotX  = -0.6f + hand.rotY * 1.6f;
+        float targetRotY  = (hand.rotX - 0.5f) * 2.0f;
+        // 使用插值平滑过渡，避免 30fps 摄像头数据在 90fps 渲染时的跳变
+        float lerpFactor  = 0.25f;
+        currentAnim.scale = Lerp(currentAnim.scale, targetScale, lerpFactor);
+        currentAnim.rotX  = Lerp(currentAnim.rotX, targetRotX, lerpFactor);
+        currentAnim.rotY  = Lerp(currentAnim.rotY, targetRotY, lerpFactor);
+    };
+    auto saturnModel = [&] {
+        glm::mat4 m = glm::mat4(1.f);
+        m           = glm::rotate(m, currentAnim.rotX, glm::vec3(1, 0, 0));
+        m           = glm::rotate(m, currentAnim.rotY, glm::vec3(0, 1, 0));
+        return glm::rotate(m, 0.466f, glm::vec3(0, 0, 1));
+    };
+
+    // 帧节奏控制与土星姿态锁存 (刷新率取主显示器，之后按实测 vblank 间隔修正)
+    const GLFWvidmode*     videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    FramePacer::Pacer      framePacer;
+    FramePacer::InputLatch inputLatch;
+    framePacer.Init(videoMode ? videoMode->refreshRate : 60);
+    inputLatch.Init();
+
+    // 点径预算 (按实测的点精灵填充开销限制近景大粒子)
+    FillBudget::Controller fillBudget;
+    fillBudget.Init();
+
+    // 动态 LOD (按实测的 GPU 耗时与预算调整粒子数和 pixelRatio)
+    GpuBudget::Controller gpuBudget;
+    gpuBudget.Init(MIN_PARTICLES, MAX_PARTICLES);
+
+    // 帧捕获 (截图 F12 / 录制视频 F9)，读回和编码都不阻塞渲染线程
+    FrameCapture::Capturer frameCapture;
+    frameCapture.Init();
+    if (!capturePath.empty()) {
+        frameCapture.StartVideo(capturePath, captureFps);
     }
+    auto toggleRecording = [&] {
+        if (frameCapture.IsRecording()) {
+            frameCapture.StopVideo();
+        } else {
+            frameCapture.StartVideo(FrameCapture::TimestampedPath("capture", ".y4m"), captureFps);
+        }
+    };
 
-    // 主循环变量
-    float             lastFrame  = 0;
-    float             currentFps = 60.0f;
-    RingBufferFPS<60> fpsCalculator;         // 优化: 使用环形缓冲区计算平滑 FPS
-    float             lodUpdateTimer = 0.0f; // LOD 更新计时器
+    // 土星远景替身 (八面体图集，粒子模拟在替身模式下累积步长，捕获前再推进)
+    SaturnImpostor::Atlas saturnImpostor;
+    saturnImpostor.Init();
+    float pendingSimDt = 0.0f;
 
-    // 主渲染循环
-    ErrorHandler::SetStage(ErrorHandler::AppStage::RENDER_LOOP);
-    int totalFrameCount = 0;
-    while (!glfwWindowShouldClose(window)) {
-        float t   = (float)glfwGetTime();
-        float dt  = t - lastFrame;
-        lastFrame = t;
-
-        // MD3 帧开始
-        MD3::BeginFrame(dt);
+    // 异步手部追踪器 (优化: 消除主线程阻塞)，追踪器初始化结束后在主循环中启动
+    AsyncHandTracker asyncTracker;
+    bool             trackerSlowLogged = false;
 
-        // 处理窗口大小变化
-        if (appState.window.resized) {
-            appState.window.resized = false;
-            proj   = glm::perspective(1.047f, (float)appState.window.width / appState.window.height, 1.f, 10000.f);
-            projUI = glm::ortho(0.0f, (float)appState.window.width, 0.0f, (float)appState.window.height);
-            resizeFBO(appState.window.width, appState.window.height);
-            fboBlur1.Init(appState.window.width / 6, appState.window.height / 6);
-            fboBlur2.Init(appState.window.width / 6, appState.window.height / 6);
-            MD3::SetScreenSize((float)appState.window.width, (float)appState.window.height);
-        }
+    // 省电模式 (窗口最小化 / 被遮挡 / 失去焦点)
+    PowerMode::Governor powerGovernor;
 
-        // 获取手部追踪数据 (异步: 非阻塞读取最新状态)
-        HandState handState = asyncTracker.GetLatestState();
-
-        // 优化: 使用环形缓冲区计算平滑 FPS
-        fpsCalculator.AddFrameTime(dt);
-        currentFps = fpsCalculator.GetAverageFPS();
-
-        // 动态 LOD 调整 (每 0.5 秒检查一次)
-        lodUpdateTimer += dt;
-        if (lodUpdateTimer >= 0.5f) {
-            lodUpdateTimer = 0.0f;
-
-            float smoothedFps          = currentFps; // 环形缓冲区已经提供平滑值
-            bool  particleCountChanged = false;
-            bool  pixelRatioChanged    = false;
-
-            // 扩展滞后区间: 38-57 FPS 进一步减少边界震荡
-            if (smoothedFps < 38.0f) {
-                // 更保守的降质策略: 0.95 替代 0.9
-                if (appState.render.activeParticleCount > MIN_PARTICLES) {
-                    appState.render.activeParticleCount = (unsigned int)(appState.render.activeParticleCount * 0.95f);
-                    particleCountChanged                = true;
-                } else if (appState.render.pixelRatio > 0.7f) {
-                    appState.render.pixelRatio -= 0.03f;
-                    pixelRatioChanged = true;
-                }
-            } else if (smoothedFps > 57.0f) {
-                // 更保守的提质策略: 1.05 替代 1.1
-                if (appState.render.pixelRatio < 1.0f) {
-                    appState.render.pixelRatio += 0.03f;
-                    pixelRatioChanged = true;
-                } else if (appState.render.activeParticleCount < MAX_PARTICLES) {
-                    appState.render.activeParticleCount = (unsigned int)(appState.render.activeParticleCount * 1.05f);
-                    particleCountChanged                = true;
-                }
-            }
+    // 主循环变量
+    float                lastFrame  = 0;
+    float                currentFps = 60.0f;      // 最近 1 秒的平均帧率 (显示用)
+    FrameStats::Recorder frameStats;              // 帧间隔、CPU 和 GPU 耗时的分位数统计
+    double               lastPresentTime = -1.0;  // 上一帧呈现的时间 (< 0 表示下一帧不计帧间隔)
+    uint64_t             lastGpuSerial   = 0;     // 已记录的帧图 GPU 样本序号
+    bool                 resizePending   = false; // 窗口尺寸已变化，渲染目标还是旧尺寸
+    double               resizeTime      = 0.0;   // 最近一次尺寸变化的时间
+
+    // 帧图资源: 外部资源由各模块自己管理 (窗口尺寸变化时更新句柄)
+    // 写入保留资源 (屏幕、星空缓存层、粒子状态) 的 pass 不会被剔除；模糊结果只在本帧内被 UI 使用
+    FrameGraph::ResourceId rBackbuffer = frameGraph.Import("backbuffer", 0, 0, true);
+    FrameGraph::ResourceId rParticles  = frameGraph.Import("particles", 0, 0, true);
+    FrameGraph::ResourceId rHistory    = frameGraph.Import("particle_history", 0, 0, true);
+    FrameGraph::ResourceId rStarLayer  = frameGraph.Import("star_layer", starLayer.tex, starLayer.fbo, true);
+    FrameGraph::ResourceId rGlassBlur  = frameGraph.Import("glass_blur", blurPyramid.GetResult(), 0, false);
+    FrameGraph::ResourceId rImpostor   = frameGraph.Import("saturn_impostor", saturnImpostor.GetTexture(), 0, true);
+    FrameGraph::ResourceId rCapture    = frameGraph.Import("frame_capture", 0, 0, true);
+
+    // 窗口尺寸或 pixelRatio 变化时重新计算场景尺寸 (池纹理容量足够时直接复用，只有超出容量才重新分配)
+    auto applyRenderScale = [&] {
+        sceneDesc.width  = scaledSize(appState.window.width, appState.render.pixelRatio);
+        sceneDesc.height = scaledSize(appState.window.height, appState.render.pixelRatio);
+        particleDesc.width  = sceneDesc.width;
+        particleDesc.height = sceneDesc.height;
+        frameGraph.SetDesc(rScene, sceneDesc);
+        frameGraph.SetDesc(rParticleLayer, particleDesc);
+        frameGraph.SetDesc(rSplat, particleDesc);
+        blurPyramid.Init(sceneDesc.width, sceneDesc.height, appState.window.width, appState.window.height);
+        frameGraph.SetImported(rGlassBlur, blurPyramid.GetResult(), 0);
+        particleAccum.Init(sceneDesc.width, sceneDesc.height);
+        pointSplat.Init(sceneDesc.width, sceneDesc.height, MAX_PARTICLES);
+    };
 
-            // 更新 Indirect Draw Buffer 中的粒子数量
-            if (particleCountChanged) {
-                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, particleBuffers.GetIndirectBuffer());
-                glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(unsigned int), &appState.render.activeParticleCount);
-            }
+    // 每帧数据: 主循环更新，pass 的执行函数按引用读取
+    struct {
+        float     t = 0.0f, dt = 0.0f; // dt: 粒子模拟步长 (替身模式下为累积的步长)
+        bool      hasHand      = false;
+        bool      upscale      = false; // 场景分辨率低于窗口
+        bool      stretch      = false; // 合成目标仍是调整窗口前的尺寸 (拖动中，不锐化)
+        bool      capture      = false; // 本帧读回合成结果 (截图 / 视频)
+        bool      accumulate   = false; // 粒子时间累积
+        bool      splat        = false; // 小粒子走计算光栅化
+        bool      simulate     = true;  // 本帧推进粒子模拟
+        bool      impostor     = false; // 土星画远景替身
+        int       captures     = 0;     // 本帧捕获的替身视角数
+        float     saturnPixels = 0.0f;  // 土星包围球的屏幕直径
+        uint32_t  starBudget   = STAR_BUDGET;
+        glm::mat4 mStar        = glm::mat4(1.f);
+        glm::mat4 starViewProj = glm::mat4(1.f);
+        glm::mat4 mSat         = glm::mat4(1.f);
+        glm::mat4 particleProj = glm::mat4(1.f); // 粒子投影 (累积时叠加亚像素抖动)
+
+        TemporalAccum::Frame accum;
+    } frame;
+
+    // 土星粒子的 uniform (各图元后端相同)
+    auto saturnParams = [&](const glm::mat4& projection) {
+        ParticleBackend::Params params;
+        params.projection   = projection;
+        params.view         = view;
+        params.time         = frame.t;
+        params.densityComp  = appState.render.densityComp; // 使用缓存值，避免每帧计算
+        params.pointSizeMax = fillBudget.GetPointSizeMax();
+        params.largeDensity = fillBudget.GetLargeDensity();
+        params.width        = sceneDesc.width;
+        params.height       = sceneDesc.height;
+        params.count        = appState.render.activeParticleCount;
+        return params;
+    };
 
-            // 优化: 只在粒子数或像素比例变化时重新计算密度补偿
-            if (particleCountChanged || pixelRatioChanged) {
-                float ratio                 = (float)appState.render.activeParticleCount / MAX_PARTICLES;
-                appState.render.densityComp = 0.6f / pow(ratio, 0.7f) / pow(appState.render.pixelRatio, 0.5f);
-            }
+    // 土星粒子 (点精灵和几何着色器后端使用 Indirect Drawing 消除 CPU 开销)
+    // 点溅射开启时先叠加计算光栅化的小粒子，大粒子列表只用点精灵画
+    auto drawSaturn = [&](const glm::mat4& projection) {
+        if (frame.splat) {
+            glBlendFunc(GL_ONE, GL_ONE);
+            glUseProgram(pCopy);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, frameGraph.GetTexture(rSplat));
+            glUniform1i(uc.copy_uTexture, 0);
+            glBindVertexArray(vaoQuad);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
         }
-
-        // 动画逻辑
-        float targetScale, targetRotX, targetRotY;
-        if (!handState.hasHand) {
-            autoTime += 0.005f;
-            targetScale       = 1.0f + sin(autoTime) * 0.2f;
-            targetRotX        = 0.4f + sin(autoTime * 0.3f) * 0.15f;
-            targetRotY        = 0.0f;
-            float lerpFactor  = 0.08f;
-            currentAnim.scale = Lerp(currentAnim.scale, targetScale, lerpFactor);
-            currentAnim.rotX  = Lerp(currentAnim.rotX, targetRotX, lerpFactor);
-            currentAnim.rotY  = Lerp(currentAnim.rotY, targetRotY, lerpFactor);
+        ParticleBackend::Params params = saturnParams(projection);
+        fillBudget.BeginMeasure();
+        if (frame.splat) {
+            particleBackends.Bind(ParticleBackend::Backend::PointSprite, params);
+            glBindVertexArray(particleBuffers.GetRenderVAO());
+            pointSplat.DrawLarge();
         } else {
-            targetScale = handState.scale;
-            targetRotX  = -0.6f + handState.rotY * 1.6f;
-            targetRotY  = (handState.rotX - 0.5f) * 2.0f;
-            // 使用插值平滑过渡，避免 30fps 摄像头数据在 90fps 渲染时的跳变
-            float lerpFactor  = 0.25f;
-            currentAnim.scale = Lerp(currentAnim.scale, targetScale, lerpFactor);
-            currentAnim.rotX  = Lerp(currentAnim.rotX, targetRotX, lerpFactor);
-            currentAnim.rotY  = Lerp(currentAnim.rotY, targetRotY, lerpFactor);
+            particleBackends.Draw((ParticleBackend::Backend)appState.render.particleBackend, params,
+                                  particleBuffers.GetRenderVAO(), particleBuffers.GetIndirectBuffer(),
+                                  particleBuffers.GetRenderSSBO());
         }
+        fillBudget.EndMeasure();
+    };
+
+    // 点溅射: 小粒子分块光栅化到 rSplat，同时生成大粒子的间接绘制列表
+    auto runSplat = [&] {
+        PointSplat::Params params;
+        params.projection   = frame.particleProj;
+        params.view         = view;
+        params.time         = frame.t;
+        params.densityComp  = appState.render.densityComp;
+        params.pointSizeMax = fillBudget.GetPointSizeMax();
+        params.count        = appState.render.activeParticleCount;
+        pointSplat.Run(pSplatBin, pSplatScan, pSplatScatter, pSplatRaster, uc, particleBuffers.GetRenderSSBO(),
+                       frameGraph.GetTexture(rSplat), params);
+    };
 
-        // 计算粒子物理 (双缓冲: 从当前缓冲读取，写入另一个缓冲)
+    // 计算粒子物理 (双缓冲: 从当前缓冲读取，写入另一个缓冲)
+    FrameGraph::PassId passParticles = frameGraph.AddPass("particles", [&] {
         glUseProgram(pComp);
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, particleBuffers.GetReadSSBO());
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, particleBuffers.GetWriteSSBO());
-        glUniform1f(uc.comp_uDt, dt);
+        glUniform1f(uc.comp_uDt, frame.dt);
         glUniform1f(uc.comp_uHandScale, currentAnim.scale);
-        glUniform1f(uc.comp_uHandHas, handState.hasHand ? 1.0f : 0.0f);
+        glUniform1f(uc.comp_uHandHas, frame.hasHand ? 1.0f : 0.0f);
         glUniform1ui(uc.comp_uParticleCount, appState.render.activeParticleCount);
         glDispatchCompute((appState.render.activeParticleCount + 255) / 256, 1, 1);
         // 交换缓冲，下一帧渲染刚写入的数据
@@ -545,84 +814,148 @@ int main() {
         // GL_SHADER_STORAGE_BARRIER_BIT: 确保 SSBO 写入完成
         // GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT: 确保顶点属性读取可见
         glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    });
 
-        // 渲染到 FBO
-        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    // 星空缓存层重绘 (天区视锥剔除 + 亮度阈值，只绘制预算内最亮的部分)，只在需要刷新的帧声明
+    // 可见星区 starLOD 在声明 pass 时由 CPU 选出
+    FrameGraph::PassId passStarLayer = frameGraph.AddPass("star_layer", [&] {
+        glBindFramebuffer(GL_FRAMEBUFFER, starLayer.fbo);
+        glViewport(0, 0, starLayer.w, starLayer.h);
         glClearColor(0, 0, 0, 1);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glClear(GL_COLOR_BUFFER_BIT);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-
-        glm::mat4 mSat = glm::mat4(1.f);
-        mSat           = glm::rotate(mSat, currentAnim.rotX, glm::vec3(1, 0, 0));
-        mSat           = glm::rotate(mSat, currentAnim.rotY, glm::vec3(0, 1, 0));
-        mSat           = glm::rotate(mSat, 0.466f, glm::vec3(0, 0, 1));
-
-        // 渲染星空 (优化: 根据像素比例动态调整星星数量)
         glUseProgram(pStar);
         glUniformMatrix4fv(uc.star_proj, 1, 0, &proj[0][0]);
         glUniformMatrix4fv(uc.star_view, 1, 0, &view[0][0]);
-        glm::mat4 mStar = glm::rotate(glm::mat4(1.f), t * 0.005f, glm::vec3(0, 1, 0));
-        glUniformMatrix4fv(uc.star_model, 1, 0, &mStar[0][0]);
-        glUniform1f(uc.star_uTime, t);
-        glBindVertexArray(vaoStars);
-        // 星空 LOD: 低分辨率时减少星星数量 (对视觉影响极小)
-        unsigned int starLODCount = (appState.render.pixelRatio < 0.85f)
-                                      ? (unsigned int)(STAR_COUNT * 0.6f) // 60% 星星在低分辨率模式
-                                      : STAR_COUNT;
-        glDrawArrays(GL_POINTS, 0, starLODCount);
-
-        // 渲染土星粒子 (使用 Indirect Drawing 消除 CPU 开销)
-        glUseProgram(pSaturn);
-        glUniformMatrix4fv(uc.sat_proj, 1, 0, &proj[0][0]);
-        glUniformMatrix4fv(uc.sat_view, 1, 0, &view[0][0]);
-        glUniformMatrix4fv(uc.sat_model, 1, 0, &mSat[0][0]);
-        glUniform1f(uc.sat_uTime, t);
-        glUniform1f(uc.sat_uScale, currentAnim.scale);
-        glUniform1f(uc.sat_uPixelRatio, appState.render.pixelRatio);
-        glUniform1f(uc.sat_uDensityComp, appState.render.densityComp); // 使用缓存值，避免每帧计算
-        glUniform1f(uc.sat_uScreenHeight, (float)appState.window.height);
-        glBindVertexArray(particleBuffers.GetRenderVAO());
-        // 使用 Indirect Drawing: GPU 直接读取绘制参数，减少 CPU-GPU 同步
-        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, particleBuffers.GetIndirectBuffer());
-        glDrawArraysIndirect(GL_POINTS, nullptr);
-
-        // 渲染行星 (实例化渲染优化 - 单次 draw call)
+        glUniformMatrix4fv(uc.star_model, 1, 0, &frame.mStar[0][0]);
+        glBindVertexArray(stars.vao);
+        if (!starLOD.first.empty()) {
+            glMultiDrawArrays(GL_POINTS, starLOD.first.data(), starLOD.count.data(), (GLsizei)starLOD.first.size());
+        }
+        starLayer.MarkCached(frame.starViewProj, frame.starBudget);
+    });
+
+    // 土星远景替身: 把本帧粒子捕获到图集中用到的格子 (捕获占用了 LatchedInput 绑定点，结束后恢复)
+    FrameGraph::PassId passImpostor = frameGraph.AddPass("saturn_impostor", [&] {
+        saturnImpostor.Capture(pSaturn, uc, particleBuffers.GetRenderVAO(), particleBuffers.GetIndirectBuffer());
+        inputLatch.Bind();
+    });
+
+    // 点溅射 (计算着色器光栅化小粒子)，在所有绘制土星粒子的 pass 之前
+    FrameGraph::PassId passSplat = frameGraph.AddPass("particle_splat", runSplat);
+
+    // 粒子层: 土星粒子单独渲染 (抖动投影)，供时间累积使用
+    FrameGraph::PassId passParticleLayer = frameGraph.AddPass("particle_layer", [&] {
+        glBindFramebuffer(GL_FRAMEBUFFER, frameGraph.GetFramebuffer(rParticleLayer));
+        glViewport(0, 0, particleDesc.width, particleDesc.height);
+        glClearColor(0, 0, 0, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        drawSaturn(frame.particleProj);
+    });
+
+    // 时间累积: 粒子层与重投影的历史混合
+    FrameGraph::PassId passAccumulate = frameGraph.AddPass("accumulate", [&] {
+        particleAccum.Resolve(pAccum, uc, vaoQuad, frameGraph.GetTexture(rParticleLayer), frame.accum);
+    });
+
+    // 场景: 星空缓存层 + 土星粒子 (或累积后的粒子层) + 行星 (动态分辨率)
+    FrameGraph::PassId passScene = frameGraph.AddPass("scene", [&] {
+        glBindFramebuffer(GL_FRAMEBUFFER, frameGraph.GetFramebuffer(rScene));
+        glViewport(0, 0, sceneDesc.width, sceneDesc.height);
+        glClearColor(0, 0, 0, 1);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+        // 合成星空缓存层 (输出 alpha 为 1，在清空的 FBO 上等价于直接写入)
+        glm::mat4 starReproject = starLayer.GetReprojection(frame.starViewProj);
+        glUseProgram(pStarLayer);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, starLayer.tex);
+        glUniform1i(uc.starLayer_uTexture, 0);
+        glUniformMatrix4fv(uc.starLayer_uReproject, 1, 0, &starReproject[0][0]);
+        glUniform1f(uc.starLayer_uTime, frame.t);
+        glBindVertexArray(vaoQuad);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+        // 渲染土星粒子: 累积开启时叠加累积结果 (粒子层本身就是加法混合的结果，直接相加)
+        if (frame.impostor) {
+            saturnImpostor.Draw(pImpostor, uc, vaoQuad, proj * view);
+        } else if (frame.accumulate) {
+            glBlendFunc(GL_ONE, GL_ONE);
+            glUseProgram(pCopy);
+            glBindTexture(GL_TEXTURE_2D, particleAccum.GetResult());
+            glUniform1i(uc.copy_uTexture, 0);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        } else {
+            drawSaturn(frame.particleProj);
+        }
+
+        // 渲染行星 (GPU 剔除 + LOD 选择，一次多重间接绘制)
         glDepthMask(GL_TRUE);
         glEnable(GL_DEPTH_TEST);
         glUseProgram(pPlanet);
         glUniformMatrix4fv(uc.pl_p, 1, 0, &proj[0][0]);
         glUniformMatrix4fv(uc.pl_v, 1, 0, &view[0][0]);
         glUniform3f(uc.pl_ld, 1, .5, 1);
-        glUniform1i(uc.pl_uPlanetCount, planetCount);
         // 绑定预计算的 FBM 噪声纹理
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, fbmTexture);
         glUniform1i(uc.pl_uFBMTex, 0);
 
-        // 更新行星 UBO 数据 (直接写入 persistent mapped buffer，无需 glBufferSubData)
-        glm::mat4 orbitRot = glm::rotate(glm::mat4(1.f), t * 0.02f, glm::vec3(0, 1, 0));
-        float     selfRot  = t * 0.1f;
-
-        // 直接写入 persistent mapped buffer (无 CPU-GPU 同步开销)
-        for (int i = 0; i < planetCount; i++) {
-            const PlanetData& p             = planets[i];
-            glm::mat4         m             = orbitRot;
-            m                               = glm::translate(m, p.pos);
-            m                               = glm::rotate(m, selfRot, glm::vec3(0, 1, 0));
-            m                               = glm::scale(m, glm::vec3(p.radius));
-            uc.pl_ubo_mapped[i].modelMatrix = m;
-            uc.pl_ubo_mapped[i].color1      = glm::vec4(p.color1, p.noiseScale);
-            uc.pl_ubo_mapped[i].color2      = glm::vec4(p.color2, p.atmosphere);
-        }
-
-        // 渲染所有行星 (GL_MAP_COHERENT_BIT 保证自动同步)
-        glBindVertexArray(vaoPlanet);
-        glDrawElementsInstanced(GL_TRIANGLES, idxPlanet, GL_UNSIGNED_INT, 0, planetCount);
+        // 实例数据已在执行帧图之前写入持久映射的环形缓冲
+        planetRenderer.Draw(pPlanetCull, pPlanet, uc, proj, view, (float)sceneDesc.height);
 
         glDisable(GL_DEPTH_TEST);
         glDepthMask(GL_FALSE);
+    });
+
+    // 放大到窗口分辨率 (边缘自适应，见 FragmentEASU)，原生分辨率时不声明
+    FrameGraph::PassId passUpscale = frameGraph.AddPass("upscale", [&] {
+        glBindFramebuffer(GL_FRAMEBUFFER, frameGraph.GetFramebuffer(rUpscaled));
+        glViewport(0, 0, upscaledDesc.width, upscaledDesc.height);
+        glBlendFunc(GL_ONE, GL_ZERO);
+        glUseProgram(pEASU);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, frameGraph.GetTexture(rScene));
+        glUniform1i(uc.easu_uTexture, 0);
+        glUniform2f(uc.easu_uScale, (float)sceneDesc.width / upscaledDesc.width,
+                    (float)sceneDesc.height / upscaledDesc.height);
+        glUniform2i(uc.easu_uSrcSize, sceneDesc.width, sceneDesc.height);
+        glBindVertexArray(vaoQuad);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    });
+
+    // 合成到屏幕 (放大后叠加锐化)，FPS 在合成之后以原生分辨率绘制
+    FrameGraph::PassId passComposite = frameGraph.AddPass("composite", [&] {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, appState.window.width, appState.window.height);
+        if (appState.backdrop.useTransparent) {
+            glClearColor(0, 0, 0, 0);
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        } else {
+            glClearColor(0, 0, 0, 1);
+            glBlendFunc(GL_ONE, GL_ZERO);
+        }
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // 池纹理只有左下角的子矩形有效，纹理坐标按逻辑尺寸缩放
+        FrameGraph::ResourceId         src       = frame.upscale ? rUpscaled : rScene;
+        const FrameGraph::TextureDesc& logical   = frame.upscale ? upscaledDesc : sceneDesc;
+        FrameGraph::TextureDesc        allocated = frameGraph.GetAllocatedDesc(src);
+        glUseProgram(pQuad);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, frameGraph.GetTexture(src));
+        glUniform1i(uc.quad_uTexture, 0);
+        glUniform1f(uc.quad_uTransparent, appState.backdrop.useTransparent ? 1.0f : 0.0f);
+        glUniform1f(uc.quad_uSharpness, frame.upscale && !frame.stretch ? exp2f(-RCAS_SHARPNESS_STOPS) : 0.0f);
+        glUniform2f(uc.quad_uUVScale, (float)logical.width / allocated.width,
+                    (float)logical.height / allocated.height);
+        glBindVertexArray(vaoQuad);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         // 渲染 FPS 显示 (使用预生成数字几何，无需每帧重建)
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
         glUseProgram(pUI);
         glUniformMatrix4fv(uc.ui_proj, 1, 0, &projUI[0][0]);
         glm::vec3 fpsCol = (currentFps > 50)
@@ -643,78 +976,242 @@ int main() {
                                      uc.ui_uTransform);
             xCursor -= (numSize + 10.0f);
         }
+    });
 
-        // 模糊处理 (Kawase Blur - 更高效的模糊算法)
-        // 优化: 预先计算迭代次数，确保最终结果在 fboBlur2 中，避免额外的复制 pass
-        GLuint finalBlurTex = fboBlur2.tex; // 最终模糊结果纹理
-        if (appState.ui.enableBlur) {
-            glBlendFunc(GL_ONE, GL_ZERO);
-            glViewport(0, 0, fboBlur1.w, fboBlur1.h);
-            glUseProgram(pBlur);
-            glUniform1i(uc.blur_uTexture, 0);
-            glUniform2f(uc.blur_uTexelSize, 1.0f / fboBlur1.w, 1.0f / fboBlur1.h);
-            glActiveTexture(GL_TEXTURE0);
-            glBindVertexArray(vaoQuad);
+    // 帧捕获: 合成结果 (不含 UI) 读回到 PBO 环，几帧后由编码线程处理
+    FrameGraph::PassId passCapture = frameGraph.AddPass("frame_capture", [&] {
+        frameCapture.Readback((int)appState.window.width, (int)appState.window.height);
+    });
+
+    // 玻璃模糊: 只计算本帧 UI 上报的面板区域；没有面板读取结果时整个 pass 被剔除
+    FrameGraph::PassId passGlassBlur = frameGraph.AddPass("glass_blur", [&] {
+        blurPyramid.Run(pBlurDown, pBlurUp, uc, frameGraph.GetTexture(rScene),
+                        BlurPyramid::DepthForStrength(appState.ui.blurStrength));
+    });
+
+    // ImGui (绘制数据在执行帧图之前已经构建好)
+    FrameGraph::PassId passUI = frameGraph.AddPass("ui", [&] {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    });
+
+    // 主渲染循环
+    ErrorHandler::SetStage(ErrorHandler::AppStage::RENDER_LOOP);
+    int        totalFrameCount = 0;
+    InputFrame inputFrame      = {};
+    uint16_t   replayW         = 0, replayH = 0; // 回放时最近一次请求的窗口尺寸
+    while (!glfwWindowShouldClose(window)) {
+        // 省电模式: 看不见时不渲染、不推进模拟，只低频处理窗口事件，手部追踪暂停 (回放和基准测试不参与)
+        bool powerAllowed = appState.render.powerSaving && !inputRecorder.IsReplaying() && !benchBlur && !benchSplat;
+        PowerMode::State         powerState  = powerGovernor.Update(window, appState, powerAllowed);
+        const PowerMode::Policy& powerPolicy = PowerMode::GetPolicy(powerState);
+        asyncTracker.SetIntervalMs(powerPolicy.trackerIntervalMs);
+        if (!powerPolicy.render) {
+            glfwWaitEventsTimeout(powerPolicy.frameInterval);
+            lastFrame       = (float)glfwGetTime(); // 恢复后的第一帧不把暂停的时间算进 dt
+            lastPresentTime = -1.0;                 // 也不计入帧间隔统计
+            continue;
+        }
+        double frameStartTime = glfwGetTime();
+
+        // 帧节奏控制: 只在 VSync 开启的实时运行中生效 (回放和基准测试不等待，限制帧率时也不需要)
+        bool pacing = appState.render.framePacing && appState.render.vsyncMode != 0 && !inputRecorder.IsReplaying() &&
+                      !benchBlur && !benchSplat && powerPolicy.frameInterval <= 0.0;
+        framePacer.WaitForFrameStart(pacing);
+        double cpuStartTime = glfwGetTime();
+
+        float t   = (float)glfwGetTime();
+        float dt  = t - lastFrame;
+        lastFrame = t;
 
-            // Kawase Blur: 每次迭代增加采样偏移
-            int   iterations    = 3 + (int)appState.ui.blurStrength;
-            float offsets[]     = {0.0f, 1.0f, 2.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
-            int   maxIterations = sizeof(offsets) / sizeof(offsets[0]);
-            iterations          = (iterations > maxIterations) ? maxIterations : iterations;
-
-            // 优化: 调整迭代次数为偶数，确保最终结果自然落在 fboBlur2 中
-            // 这样避免了原来的额外复制 pass
-            if (iterations % 2 == 1) {
-                iterations++; // 增加一次迭代比复制更有意义（额外模糊效果）
-                if (iterations > maxIterations) {
-                    iterations = maxIterations;
+        // 输入回放: 时间、窗口尺寸、手部数据、LOD 和按键全部取自日志
+        if (inputRecorder.IsReplaying()) {
+            if (!inputRecorder.Read(inputFrame)) {
+                std::cout << "[Main] Replay finished" << std::endl;
+                break;
+            }
+            t  = inputFrame.time;
+            dt = inputFrame.dt;
+            // 仅在日志中的尺寸变化时请求调整窗口，避免每帧重复请求
+            if (inputFrame.width != replayW || inputFrame.height != replayH) {
+                replayW = inputFrame.width;
+                replayH = inputFrame.height;
+                if (replayW != appState.window.width || replayH != appState.window.height) {
+                    glfwSetWindowSize(window, replayW, replayH);
+                }
+            }
+        }
+        inputFrame.time = t;
+        inputFrame.dt   = dt;
+
+        // 手部追踪器在后台初始化，结束后再启动异步读取 (首帧不等待摄像头)
+        if (trackerPending) {
+            double trackerMs =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - trackerStartTime).count();
+            if (IsTrackerInitComplete()) {
+                trackerPending = false;
+                if (FinishHandTracking()) {
+                    asyncTracker.Start();
                 }
+                std::cout << "[Main] HandTracker init finished after " << trackerMs << " ms" << std::endl;
+            } else if (!trackerSlowLogged && trackerMs > 5000.0) {
+                trackerSlowLogged = true;
+                std::cout << "[Main] HandTracker still initializing after 5 s" << std::endl;
             }
+        }
 
-            // 第一次: fboTex -> fboBlur1
-            glBindFramebuffer(GL_FRAMEBUFFER, fboBlur1.fbo);
-            glBindTexture(GL_TEXTURE_2D, fboTex);
-            glUniform1f(uc.blur_uOffset, offsets[0]);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        // MD3 帧开始
+        MD3::BeginFrame(dt);
 
-            // 后续迭代: ping-pong between fboBlur1 and fboBlur2
-            // 奇数次迭代写入 fboBlur2，偶数次迭代写入 fboBlur1
-            // 由于 iterations 是偶数，最后一次 (iterations-1) 是奇数，写入 fboBlur2
-            for (int i = 1; i < iterations; i++) {
-                if (i % 2 == 1) {
-                    glBindFramebuffer(GL_FRAMEBUFFER, fboBlur2.fbo);
-                    glBindTexture(GL_TEXTURE_2D, fboBlur1.tex);
-                } else {
-                    glBindFramebuffer(GL_FRAMEBUFFER, fboBlur1.fbo);
-                    glBindTexture(GL_TEXTURE_2D, fboBlur2.tex);
-                }
-                glUniform1f(uc.blur_uOffset, offsets[std::min(i, maxIterations - 1)]);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        // 处理窗口大小变化: 投影和 UI 立即跟随新尺寸；渲染目标等尺寸稳定后再重建，
+        // 拖动窗口期间场景仍按旧尺寸渲染，合成时拉伸到窗口 (NDC 覆盖整个目标，画面比例不变)，不产生 GPU 分配
+        if (appState.window.resized) {
+            appState.window.resized = false;
+            proj   = glm::perspective(1.047f, (float)appState.window.width / appState.window.height, 1.f, 10000.f);
+            projUI = glm::ortho(0.0f, (float)appState.window.width, 0.0f, (float)appState.window.height);
+            MD3::SetScreenSize((float)appState.window.width, (float)appState.window.height);
+            resizePending = true;
+            resizeTime    = glfwGetTime();
+        }
+        if (resizePending && glfwGetTime() - resizeTime >= RESIZE_SETTLE_SECONDS) {
+            resizePending       = false;
+            upscaledDesc.width  = (int)appState.window.width;
+            upscaledDesc.height = (int)appState.window.height;
+            frameGraph.SetDesc(rUpscaled, upscaledDesc);
+            applyRenderScale();
+            starLayer.Init(appState.window.width, appState.window.height);
+            frameGraph.SetImported(rStarLayer, starLayer.tex, starLayer.fbo);
+        }
+
+        inputFrame.width  = (uint16_t)appState.window.width;
+        inputFrame.height = (uint16_t)appState.window.height;
+
+        // 获取手部追踪数据 (异步: 非阻塞读取最新状态)
+        HandState handState =
+            inputRecorder.IsReplaying() ? InputRecorder::UnpackHand(inputFrame) : asyncTracker.GetLatestState();
+        InputRecorder::PackHand(handState, inputFrame);
+
+        // 显示的帧率取最近 1 秒的平均帧间隔 (真实耗时，回放时也不取日志中的 dt)
+        FrameStats::Summary recentFrames = frameStats.Get(FrameStats::Metric::Frame).GetWindow(1.0, cpuStartTime);
+        if (recentFrames.count > 0) {
+            currentFps = (float)(1000.0 / recentFrames.mean);
+        }
+
+        // 动态 LOD: 按帧图测得的 GPU 耗时与预算 (刷新周期的一部分) 闭环调整，VSync 和限制帧率都不影响测量
+        bool particleCountChanged = false;
+        bool pixelRatioChanged    = false;
+        if (inputRecorder.IsReplaying()) {
+            // 回放: 直接使用录制时的 LOD 决策，不受本机帧率影响
+            particleCountChanged                = inputFrame.particleCount != appState.render.activeParticleCount;
+            pixelRatioChanged                   = inputFrame.pixelRatio != appState.render.pixelRatio;
+            appState.render.activeParticleCount = inputFrame.particleCount;
+            appState.render.pixelRatio          = inputFrame.pixelRatio;
+        } else {
+            // 点精灵填充超预算时由点径预算先收紧，暂不降质 (减少粒子对近景大粒子的填充开销帮助不大)
+            unsigned int prevCount    = appState.render.activeParticleCount;
+            float        prevRatio    = appState.render.pixelRatio;
+            int          windowPixels = (int)(appState.window.width * appState.window.height);
+            if (gpuBudget.Update(framePacer.GetStats().refreshMs, windowPixels, !fillBudget.IsLimiting(),
+                                 appState.render.activeParticleCount, appState.render.pixelRatio)) {
+                particleCountChanged = appState.render.activeParticleCount != prevCount;
+                pixelRatioChanged    = appState.render.pixelRatio != prevRatio;
             }
+        }
+        inputFrame.particleCount = appState.render.activeParticleCount;
+        inputFrame.pixelRatio    = appState.render.pixelRatio;
 
-            // 最终结果现在保证在 fboBlur2 中
-            finalBlurTex = fboBlur2.tex;
-            glViewport(0, 0, appState.window.width, appState.window.height);
+        // 点径预算: 读取几帧前的过绘制测量并调整 (回放时使用日志中的预算)
+        fillBudget.BeginFrame(sceneDesc.width * sceneDesc.height, inputRecorder.IsReplaying());
+        if (inputRecorder.IsReplaying()) {
+            fillBudget.SetCodes(inputFrame.fillSize, inputFrame.fillDensity);
         }
+        inputFrame.fillSize    = fillBudget.GetSizeCode();
+        inputFrame.fillDensity = fillBudget.GetDensityCode();
 
-        // 合成到屏幕
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        if (appState.backdrop.useTransparent) {
-            glClearColor(0, 0, 0, 0);
-            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        // 更新 Indirect Draw Buffer 中的粒子数量
+        if (particleCountChanged) {
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, particleBuffers.GetIndirectBuffer());
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(unsigned int), &appState.render.activeParticleCount);
+        }
+
+        // 优化: 只在粒子数变化时重新计算密度补偿 (动态分辨率下粒子的屏幕尺寸不变，不再按像素比例补偿)
+        if (particleCountChanged) {
+            float ratio                 = (float)appState.render.activeParticleCount / MAX_PARTICLES;
+            appState.render.densityComp = 0.6f / pow(ratio, 0.7f);
+        }
+
+        // 动态分辨率: 场景渲染目标跟随 pixelRatio
+        if (pixelRatioChanged) {
+            applyRenderScale();
+        }
+
+        // 动画逻辑 (保留插值前的状态，提交前锁存到更新的手部样本时从这里重新插值)
+        SmoothState animBase = currentAnim;
+        if (!handState.hasHand) {
+            autoTime += 0.005f;
+            float targetScale = 1.0f + sin(autoTime) * 0.2f;
+            float targetRotX  = 0.4f + sin(autoTime * 0.3f) * 0.15f;
+            float targetRotY  = 0.0f;
+            float lerpFactor  = 0.08f;
+            currentAnim.scale = Lerp(currentAnim.scale, targetScale, lerpFactor);
+            currentAnim.rotX  = Lerp(currentAnim.rotX, targetRotX, lerpFactor);
+            currentAnim.rotY  = Lerp(currentAnim.rotY, targetRotY, lerpFactor);
         } else {
-            glClearColor(0, 0, 0, 1);
-            glBlendFunc(GL_ONE, GL_ZERO);
+            followHand(handState);
         }
-        glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(pQuad);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, fboTex);
-        glUniform1i(uc.quad_uTexture, 0);
-        glUniform1f(uc.quad_uTransparent, appState.backdrop.useTransparent ? 1.0f : 0.0f);
-        glBindVertexArray(vaoQuad);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        // 本帧 pass 使用的数据 (星空旋转与 LOD 预算、土星姿态)
+        frame.t            = t;
+        frame.hasHand      = handState.hasHand;
+        frame.upscale      = sceneDesc.width != upscaledDesc.width || sceneDesc.height != upscaledDesc.height;
+        frame.stretch      = resizePending;
+        frame.capture      = frameCapture.WantsFrame(t);
+        frame.mStar        = glm::rotate(glm::mat4(1.f), t * 0.005f, glm::vec3(0, 1, 0));
+        frame.starViewProj = proj * view * frame.mStar;
+        // 星空 LOD: 低分辨率时降低预算 (丢弃的是最暗的星，对视觉影响极小)
+        frame.starBudget = (appState.render.pixelRatio < 0.85f) ? (uint32_t)(STAR_BUDGET * 0.6f) : STAR_BUDGET;
+
+        frame.mSat = saturnModel();
+        inputLatch.BeginFrame();
+        inputLatch.Write(frame.mSat, currentAnim.scale);
+
+        // 远景替身: 土星在屏幕上较小时改画图集，粒子模拟只在需要捕获的帧推进 (步长累积，转动是精确旋转)
+        bool impostorAllowed = appState.render.saturnImpostor && !benchSplat;
+        frame.saturnPixels   = SaturnImpostor::ScreenDiameter(currentAnim.scale, proj, sceneDesc.height);
+        frame.impostor       = saturnImpostor.UpdateMode(frame.saturnPixels, impostorAllowed);
+        frame.captures       = 0;
+        if (frame.impostor) {
+            SaturnImpostor::CaptureParams capture;
+            capture.scale          = currentAnim.scale;
+            capture.targetHeight   = (float)sceneDesc.height;
+            capture.screenDiameter = frame.saturnPixels;
+            capture.time           = t;
+            capture.densityComp    = appState.render.densityComp;
+            capture.count          = appState.render.activeParticleCount;
+            capture.now            = t;
+            frame.captures         = saturnImpostor.PlanCaptures(frame.mSat, capture);
+        }
+        frame.simulate = !frame.impostor || frame.captures > 0;
+        frame.dt       = frame.simulate ? pendingSimDt + dt : 0.0f;
+        pendingSimDt   = frame.simulate ? 0.0f : pendingSimDt + dt;
+
+        // 粒子时间累积: 本帧变换和 ComputeSaturn 的转角 (重投影用)
+        // 模型矩阵和缩放只用于估计历史权重，累积 pass 从 LatchedInput 读取 (提交前锁存可能改写)
+        frame.accumulate = appState.render.temporalAccum && !frame.impostor;
+        if (frame.accumulate) {
+            float timeFactor     = handState.hasHand ? currentAnim.scale : 1.0f;
+            frame.accum.viewProj = proj * view;
+            frame.accum.model    = frame.mSat;
+            frame.accum.scale    = currentAnim.scale;
+            frame.accum.ringStep = 0.2f * frame.dt * timeFactor;
+            frame.accum.bodyStep = 0.03f * frame.dt * timeFactor;
+            frame.accum.hasHand  = handState.hasHand;
+            frame.particleProj   = particleAccum.JitterProjection(proj);
+        } else {
+            frame.particleProj = proj;
+            particleAccum.Reset();
+        }
+        frame.splat = (appState.render.particleSplat || benchSplat) && !frame.impostor;
 
         // Update error handler state
         totalFrameCount++;
@@ -726,11 +1223,14 @@ int main() {
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
+        // 玻璃面板在构建 UI 时上报需要模糊背景的区域
+        blurPyramid.ClearRegions();
+
         // Render error dialogs
         ErrorHandler::RenderErrorDialog(dt);
 
         // Render crash analyzer window
-        CrashAnalyzer::Render(appState.ui.enableBlur, fboBlur2.tex, appState.window.width, appState.window.height,
+        CrashAnalyzer::Render(appState.ui.enableBlur, &blurPyramid, appState.window.width, appState.window.height,
                               appState.ui.isDarkMode);
 
         if (appState.ui.showDebugWindow) {
@@ -751,11 +1251,14 @@ int main() {
             ImDrawList* dl   = ImGui::GetWindowDrawList();
 
             if (appState.ui.enableBlur) {
-                ImVec2 uv0 = ImVec2(pos.x / appState.window.width, 1.0f - pos.y / appState.window.height);
-                ImVec2 uv1 =
-                    ImVec2((pos.x + size.x) / appState.window.width, 1.0f - (pos.y + size.y) / appState.window.height);
-                dl->AddImage((ImTextureID)(intptr_t)fboBlur2.tex, pos, ImVec2(pos.x + size.x, pos.y + size.y), uv0,
-                             uv1);
+                // 结果纹理按尺寸档位分配，逻辑尺寸之外的纹素不可读
+                glm::vec2 uv0 = blurPyramid.GetResultUV(pos.x / appState.window.width,
+                                                        1.0f - pos.y / appState.window.height);
+                glm::vec2 uv1 = blurPyramid.GetResultUV((pos.x + size.x) / appState.window.width,
+                                                        1.0f - (pos.y + size.y) / appState.window.height);
+                blurPyramid.AddRegion(pos.x, pos.y, size.x, size.y);
+                dl->AddImage((ImTextureID)(intptr_t)blurPyramid.GetResult(), pos,
+                             ImVec2(pos.x + size.x, pos.y + size.y), ImVec2(uv0.x, uv0.y), ImVec2(uv1.x, uv1.y));
                 ImU32 tintColor = appState.ui.isDarkMode ? IM_COL32(20, 20, 25, 180) : IM_COL32(245, 245, 255, 150);
                 dl->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), tintColor, style.WindowRounding);
                 ImU32 highlight = appState.ui.isDarkMode ? IM_COL32(255, 255, 255, 40) : IM_COL32(255, 255, 255, 120);
@@ -771,9 +1274,52 @@ int main() {
 
             if (MD3::BeginCollapsingHeader(str.sectionPerformance, true)) {
                 ImGui::Text("%s: %.1f", str.fps, currentFps);
+
+                // 帧时间分位数 (最近 10 秒) 与最近若干帧的曲线 (纵轴 0-50 ms)
+                ImGui::Text("%s:", str.frameTimes);
+                const char* metricNames[FrameStats::kMetricCount] = {str.frameInterval, str.cpuTime, str.gpuTime};
+                for (int m = 0; m < FrameStats::kMetricCount; m++) {
+                    const FrameStats::Tracker& tracker = frameStats.Get((FrameStats::Metric)m);
+                    FrameStats::Summary        window  = tracker.GetWindow(FrameStats::kMaxWindow, glfwGetTime());
+                    ImGui::Text("  %s: %.2f / %.2f / %.2f / %.2f ms", metricNames[m], window.p50, window.p95,
+                                window.p99, window.max);
+                    ImGui::PushID(m);
+                    ImGui::PlotLines("##frameTimes", tracker.GetRecent(), FrameStats::kPlotFrames,
+                                     tracker.GetRecentOffset(), nullptr, 0.0f, 50.0f, ImVec2(-1.0f, 32.0f));
+                    ImGui::PopID();
+                }
                 ImGui::Text("%s: %u / %u", str.particles, appState.render.activeParticleCount, MAX_PARTICLES);
                 ImGui::Text("%s: %.2f", str.pixelRatio, appState.render.pixelRatio);
                 ImGui::Text("%s: %u x %u", str.resolution, appState.window.width, appState.window.height);
+                ImGui::Text("%s: %d x %d", str.renderResolution, sceneDesc.width, sceneDesc.height);
+                if (inputRecorder.GetMode() != InputRecorder::Mode::Off) {
+                    ImGui::Text("%s: %llu", inputRecorder.IsRecording() ? str.inputRecording : str.inputReplaying,
+                                (unsigned long long)inputRecorder.GetFrameCount());
+                }
+
+                // 动态 LOD 的输入 (最近一次决策的 GPU 耗时中位数) 与代价模型
+                const GpuBudget::Stats& budget = gpuBudget.GetStats();
+                ImGui::Text("%s: %.2f / %.2f ms", str.gpuBudget, budget.measuredMs, budget.budgetMs);
+                ImGui::Text("%s: %.2f + %.2f + %.2f ms", str.lodCostModel, budget.baseMs, budget.particleMs,
+                            budget.pixelMs);
+
+                // 点精灵过绘制 (片段数 / 像素数) 与当前点径预算
+                const FillBudget::Stats& fill = fillBudget.GetStats();
+                ImGui::Text("%s: %.2fx (%.2f ms)", str.spriteOverdraw, fill.overdraw, fill.fillMs);
+                ImGui::Text("%s: %.0f px / %.0f%%", str.pointSizeBudget, fill.pointSizeMax, fill.density * 100.0f);
+                if (frame.impostor) {
+                    ImGui::Text("%s: %.0f px", str.impostorActive, frame.saturnPixels);
+                }
+
+                // 帧图各 pass 的 GPU 耗时 (时间戳查询延迟几帧读取)
+                ImGui::Text("%s:", str.passTimings);
+                for (const FrameGraph::PassStats& ps : frameGraph.GetStats()) {
+                    if (ps.executed) {
+                        ImGui::Text("  %s: %.3f ms", ps.name, ps.gpuMs);
+                    } else if (ps.culled) {
+                        ImGui::TextDisabled("  %s: (%s)", ps.name, str.passCulled);
+                    }
+                }
 
                 ImGui::Dummy(ImVec2(0, 5));
 
@@ -804,6 +1350,38 @@ int main() {
                         std::cout << "[Main] VSync mode changed to: " << vsyncModes[vsyncIndex] << std::endl;
                     }
                 }
+
+                // 帧节奏控制 (VSync 关闭时不生效)
+                MD3::Toggle(str.framePacing, &appState.render.framePacing);
+                const FramePacer::Stats& paceStats = framePacer.GetStats();
+                ImGui::Text("%s: %.1f / %.1f ms", str.inputLatency, paceStats.latencyMs, paceStats.latencyMax);
+                if (paceStats.pacing) {
+                    ImGui::Text("%s: %.2f ms", str.paceWait, paceStats.sleepMs);
+                }
+
+                // 帧捕获: 队列深度 = GPU 读回中 + 等待或正在编码
+                FrameCapture::Stats capStats  = frameCapture.GetStats();
+                bool                recording = capStats.recording;
+                if (MD3::Toggle(str.videoRecording, &recording)) {
+                    toggleRecording();
+                }
+                ImGui::Text("%s: %llu / %llu", str.captureFrames, (unsigned long long)capStats.captured,
+                            (unsigned long long)capStats.dropped);
+                ImGui::Text("%s: %d + %d (%d) / %.1f ms", str.captureQueue, capStats.inFlight, capStats.queued,
+                            capStats.maxQueued, capStats.encodeMs);
+
+                // 省电模式: 各状态下累计的 CPU (占单核) / GPU 占用与帧率
+                MD3::Toggle(str.powerSaving, &appState.render.powerSaving);
+                const char* powerStates[] = {str.powerActive, str.powerUnfocused, str.powerOccluded,
+                                             str.powerMinimized};
+                ImGui::Text("%s:", str.powerUsage);
+                for (int s = 0; s < PowerMode::kStateCount; s++) {
+                    PowerMode::Usage usage = powerGovernor.GetUsage((PowerMode::State)s);
+                    if (usage.seconds > 0.0) {
+                        ImGui::Text("  %s: CPU %.0f%% / GPU %.0f%% / %.0f FPS (%.0f s)", powerStates[s],
+                                    usage.cpuPercent, usage.gpuPercent, usage.fps, usage.seconds);
+                    }
+                }
                 MD3::EndCollapsingHeader();
             }
 
@@ -831,6 +1409,9 @@ int main() {
                     MD3::SetDarkMode(appState.ui.isDarkMode);
                 }
                 ImGui::Dummy(ImVec2(0, 5));
+                MD3::Toggle(str.temporalAccum, &appState.render.temporalAccum);
+                MD3::Toggle(str.particleSplat, &appState.render.particleSplat);
+                MD3::Toggle(str.saturnImpostor, &appState.render.saturnImpostor);
                 MD3::Toggle(str.glassBlur, &appState.ui.enableBlur);
                 if (appState.ui.enableBlur) {
                     ImGui::Indent(10);
@@ -861,6 +1442,22 @@ int main() {
                     std::cout << "[Main] SIMD mode changed to: " << GetTrackerSIMDImplementation() << std::endl;
                 }
                 ImGui::Text("%s: %s", str.simdCurrent, GetTrackerSIMDImplementation());
+
+                // 粒子图元后端 (不支持的后端不可选)
+                ImGui::Text("%s:", str.particleBackend);
+                int         backendIndex   = appState.render.particleBackend;
+                const char* backendNames[] = {str.backendPointSprite, str.backendInstancedQuad,
+                                              str.backendGeometryQuad};
+                if (MD3::Combo("##ParticleBackend", &backendIndex, backendNames, ParticleBackend::kBackendCount)) {
+                    if (particleBackends.IsSupported((ParticleBackend::Backend)backendIndex)) {
+                        appState.render.particleBackend = backendIndex;
+                        std::cout << "[Main] Particle backend changed to: "
+                                  << ParticleBackend::GetName((ParticleBackend::Backend)backendIndex) << std::endl;
+                    } else {
+                        std::cout << "[Main] Particle backend not supported: "
+                                  << ParticleBackend::GetName((ParticleBackend::Backend)backendIndex) << std::endl;
+                    }
+                }
                 MD3::EndCollapsingHeader();
             }
 
@@ -892,17 +1489,194 @@ int main() {
         }
 
         ImGui::Render();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+        // 执行帧图: 按执行顺序声明本帧的 pass 及其读写的资源
+        // pass 需要的 CPU 工作 (星区 LOD 选择、等待行星实例缓冲的栅栏) 在这里做完:
+        // 放在 pass 里会让 GPU 在 pass 中途空等，被时间戳算进 GPU 耗时，GPU 预算会误以为 GPU 跑满
+        frameGraph.BeginFrame();
+        if (frame.simulate) {
+            frameGraph.Use(passParticles).Write(rParticles);
+        }
+        if (starLayer.NeedsRefresh(frame.starViewProj, frame.starBudget, STAR_LAYER_REFRESH_PIXELS)) {
+            float aspect = (float)appState.window.width / std::max(1u, appState.window.height);
+            StarField::SelectLOD(starIndex, view * frame.mStar, tanf(1.047f * 0.5f), aspect, frame.starBudget, starLOD);
+            frameGraph.Use(passStarLayer).Write(rStarLayer);
+        }
+        if (frame.captures > 0) {
+            frameGraph.Use(passImpostor).Read(rParticles).Write(rImpostor);
+        }
+        if (frame.splat) {
+            frameGraph.Use(passSplat).Read(rParticles).Write(rSplat);
+        }
+        if (frame.accumulate) {
+            FrameGraph::Graph::Node& layerNode = frameGraph.Use(passParticleLayer).Read(rParticles);
+            if (frame.splat) {
+                layerNode.Read(rSplat);
+            }
+            layerNode.Write(rParticleLayer);
+            frameGraph.Use(passAccumulate).Read(rParticleLayer).Write(rHistory);
+        }
+        planetRenderer.Update(planetBodies, frame.t); // 场景 pass 总是执行 (合成读取它的结果)
+        FrameGraph::Graph::Node& sceneNode =
+            frameGraph.Use(passScene).Read(rParticles).Read(rStarLayer).Read(rHistory).Write(rScene);
+        if (frame.splat && !frame.accumulate) {
+            sceneNode.Read(rSplat);
+        }
+        if (frame.impostor) {
+            sceneNode.Read(rImpostor);
+        }
+        if (frame.upscale) {
+            frameGraph.Use(passUpscale).Read(rScene).Write(rUpscaled);
+        }
+        frameGraph.Use(passComposite).Read(frame.upscale ? rUpscaled : rScene).Write(rBackbuffer);
+        if (frame.capture) {
+            frameGraph.Use(passCapture).Read(rBackbuffer).Write(rCapture);
+        }
+        if (appState.ui.enableBlur) {
+            frameGraph.Use(passGlassBlur).Read(rScene).Write(rGlassBlur);
+        }
+        FrameGraph::Graph::Node& uiNode = frameGraph.Use(passUI).Write(rBackbuffer);
+        if (blurPyramid.HasRegions()) {
+            uiNode.Read(rGlassBlur);
+        }
+        frameGraph.Execute();
+
+        if (benchSplat) {
+            // 两条路径都加法混合到场景目标上 (内容无关紧要，只比较耗时)
+            PointSplat::RunBenchmark(
+                pointSplat, frameGraph.GetFramebuffer(rScene), sceneDesc.width, sceneDesc.height,
+                [&](float scale) {
+                    currentAnim.scale = scale;
+                    inputLatch.Write(frame.mSat, scale);
+                },
+                [&] {
+                    frame.splat = false;
+                    drawSaturn(frame.particleProj);
+                },
+                [&] {
+                    frame.splat = true;
+                    runSplat();
+                    drawSaturn(frame.particleProj);
+                });
+            break;
+        }
+        // 粒子图元后端: 首次启动 (或 --bench-backend) 时在第一帧之后比较，结果按 GPU 记录
+        // 叠加绘制到本帧已经合成过的场景目标上 (画面不受影响)，之后恢复间接绘制命令中的粒子数
+        if (!backendChosen && !inputRecorder.IsReplaying() && !benchBlur && !benchSplat) {
+            backendChosen       = true;
+            uint32_t benchCount = appState.render.activeParticleCount;
+            auto     setCount   = [&](uint32_t count) {
+                if (count != benchCount) {
+                    benchCount = count;
+                    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, particleBuffers.GetIndirectBuffer());
+                    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(uint32_t), &count);
+                }
+            };
+            ParticleBackend::Backend fastest = ParticleBackend::RunBenchmark(
+                particleBackends, frameGraph.GetFramebuffer(rScene), sceneDesc.width, sceneDesc.height, MAX_PARTICLES,
+                [&](ParticleBackend::Backend backend, uint32_t count) {
+                    setCount(count);
+                    ParticleBackend::Params params = saturnParams(frame.particleProj);
+                    params.count                   = count;
+                    particleBackends.Draw(backend, params, particleBuffers.GetRenderVAO(),
+                                          particleBuffers.GetIndirectBuffer(), particleBuffers.GetRenderSSBO());
+                });
+            setCount(appState.render.activeParticleCount);
+            ParticleBackend::SaveChoice(fastest);
+            appState.render.particleBackend = (int)fastest;
+            if (benchBackend) {
+                break;
+            }
+        }
+        if (benchBlur) {
+            BlurPyramid::RunBenchmark(blurPyramid, pBlurDown, pBlurUp, pBlur, uc, vaoQuad,
+                                      frameGraph.GetTexture(rScene), sceneDesc.width, sceneDesc.height);
+            break;
+        }
 
         // MD3 帧结束 - 渲染 Ripple 效果
         MD3::EndFrame();
 
+        // 输入锁存: 命令已提交但 GPU 尚未执行时，用帧渲染期间到达的手部样本覆盖土星姿态
+        // 锁存的样本单独记入日志，回放 (不开帧节奏) 时在同一位置重放，姿态插值与录制时逐帧一致
+        HandState late    = handState;
+        bool      latched = false;
+        if (inputRecorder.IsReplaying()) {
+            latched = InputRecorder::UnpackLatch(inputFrame, late);
+        } else if (pacing) {
+            late    = asyncTracker.GetLatestState();
+            latched = late.hasHand && handState.hasHand && late.sequence != handState.sequence;
+        }
+        InputRecorder::PackLatch(latched, late, inputFrame);
+        if (latched) {
+            currentAnim = animBase;
+            followHand(late);
+            frame.mSat = saturnModel();
+            inputLatch.Write(frame.mSat, currentAnim.scale);
+            // 累积 pass 从 LatchedInput 读取本帧姿态，下一帧重投影历史也要用粒子实际绘制时的变换
+            if (frame.accumulate) {
+                particleAccum.Relatch(frame.mSat, currentAnim.scale);
+            }
+            handState = late;
+        }
+
+        double submitTime = glfwGetTime();
+        framePacer.MarkSubmitted();
         glfwSwapBuffers(window);
+
+        // 帧时间统计: 帧间隔按呈现时间计；GPU 耗时在帧图取回新的时间戳结果时记录 (延迟几帧，跳过未就绪的帧)
+        double presentTime = glfwGetTime();
+        if (lastPresentTime >= 0.0) {
+            frameStats.Record(FrameStats::Metric::Frame, (presentTime - lastPresentTime) * 1000.0, presentTime);
+        }
+        lastPresentTime = presentTime;
+        frameStats.Record(FrameStats::Metric::Cpu, (submitTime - cpuStartTime) * 1000.0, presentTime);
+        if (frameGraph.GetFrameGpuSerial() != lastGpuSerial) {
+            lastGpuSerial = frameGraph.GetFrameGpuSerial();
+            frameStats.Record(FrameStats::Metric::Gpu, frameGraph.GetFrameGpuMs(), presentTime);
+            gpuBudget.AddSample(frameGraph.GetFrameGpuMs());
+        }
+
+        double gpuMs = 0.0;
+        for (const FrameGraph::PassStats& ps : frameGraph.GetStats()) {
+            gpuMs += ps.executed ? ps.gpuMs : 0.0;
+        }
+        framePacer.MarkPresented(pacing, gpuMs, handState.hasHand ? handState.sampleTime : 0.0);
+        inputLatch.EndFrame();
+        powerGovernor.AddFrame(gpuMs);
+        frameCapture.Poll();
+
+        // 失去焦点时限制帧率: 等待到最小帧间隔，期间到达的事件照常处理
+        double frameRemaining = powerPolicy.frameInterval - (glfwGetTime() - frameStartTime);
+        while (frameRemaining > 0.0) {
+            glfwWaitEventsTimeout(frameRemaining);
+            frameRemaining = powerPolicy.frameInterval - (glfwGetTime() - frameStartTime);
+        }
         glfwPollEvents();
 
+        if (totalFrameCount == 1) {
+            auto firstFrame = std::chrono::steady_clock::now() - appStartTime;
+            std::cout << "[Main] Time to first frame: " << std::chrono::duration<double, std::milli>(firstFrame).count()
+                      << " ms" << (trackerPending ? " (HandTracker still initializing)" : "") << std::endl;
+        }
+
+        // 采集按键状态 (回放时使用日志中的按键)
+        uint8_t keys = 0;
+        if (inputRecorder.IsReplaying()) {
+            keys = inputFrame.keys;
+        } else {
+            keys |= (glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS) ? INPUT_KEY_F3 : 0;
+            keys |= (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS) ? INPUT_KEY_B : 0;
+            keys |= (glfwGetKey(window, GLFW_KEY_F11) == GLFW_PRESS) ? INPUT_KEY_F11 : 0;
+            keys |= (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) ? INPUT_KEY_ESCAPE : 0;
+            keys |= (glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS) ? INPUT_KEY_F9 : 0;
+            keys |= (glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS) ? INPUT_KEY_F12 : 0;
+        }
+        inputFrame.keys = keys;
+        inputRecorder.Write(inputFrame);
+
         // Key handling (使用 AppState 中的输入状态)
-        if (glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS) {
+        if (keys & INPUT_KEY_F3) {
             if (!appState.input.keyF3_pressed) {
                 appState.input.keyF3_pressed = true;
                 appState.ui.showDebugWindow  = !appState.ui.showDebugWindow;
@@ -912,9 +1686,27 @@ int main() {
             appState.input.keyF3_pressed = false;
         }
 
+        // 截图 / 录制 (按键记录在输入日志中，回放时在同一帧截图)
+        if (keys & INPUT_KEY_F12) {
+            if (!appState.input.keyF12_pressed) {
+                appState.input.keyF12_pressed = true;
+                frameCapture.RequestScreenshot(FrameCapture::TimestampedPath("screenshot", ".png"));
+            }
+        } else {
+            appState.input.keyF12_pressed = false;
+        }
+        if (keys & INPUT_KEY_F9) {
+            if (!appState.input.keyF9_pressed) {
+                appState.input.keyF9_pressed = true;
+                toggleRecording();
+            }
+        } else {
+            appState.input.keyF9_pressed = false;
+        }
+
 #ifdef _WIN32
         HWND hwnd = glfwGetWin32Window(window);
-        if (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS) {
+        if (keys & INPUT_KEY_B) {
             if (!appState.input.keyB_pressed) {
                 appState.input.keyB_pressed = true;
                 if (!appState.backdrop.availableBackdrops.empty()) {
@@ -928,7 +1720,7 @@ int main() {
             appState.input.keyB_pressed = false;
         }
 
-        if (glfwGetKey(window, GLFW_KEY_F11) == GLFW_PRESS) {
+        if (keys & INPUT_KEY_F11) {
             if (!appState.input.keyF11_pressed) {
                 appState.input.keyF11_pressed = true;
                 WindowManager::ToggleFullscreen(window, appState);
@@ -943,7 +1735,8 @@ int main() {
         }
 #endif
 
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE)) {
+        // 回放时仍允许实际按下 ESC 中止
+        if ((keys & INPUT_KEY_ESCAPE) || glfwGetKey(window, GLFW_KEY_ESCAPE)) {
             break;
         }
     }
@@ -951,7 +1744,10 @@ int main() {
     // Cleanup
     // ErrorHandler::SetStage(ErrorHandler::AppStage::SHUTDOWN);
     std::cout << "[Main] Shutting down..." << std::endl;
-    asyncTracker.Stop(); // 停止异步追踪线程
+    frameStats.Report(inputRecorder.IsReplaying() ? "Replay frame times" : "Session frame times");
+    asyncTracker.Stop();     // 停止异步追踪线程
+    frameCapture.Shutdown(); // 编码线程读取持久映射的 PBO，须在销毁 GL 上下文之前结束
+    inputRecorder.Close();
     CrashAnalyzer::Shutdown();
     MD3::Shutdown();
     UIManager::Shutdown();
@@ -0,0 +1,170 @@
+// ParticleBackend.cpp - 土星粒子图元后端实现
+
+#include "pch.h"
+
+#include "ParticleBackend.h"
+#include "Renderer.h" // GetCacheDirectory
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace ParticleBackend {
+
+namespace {
+
+constexpr GLuint kBindParticles = 0; // 与 VertexSaturnQuad 的 ParticleBuffer 绑定点一致
+constexpr int    kChoiceVersion = 1; // 后端实现变化时递增，使旧的测量结果失效
+
+std::string GpuIdentity() {
+    return std::string((const char*)glGetString(GL_RENDERER)) + "|" + (const char*)glGetString(GL_VERSION);
+}
+
+std::filesystem::path ChoicePath() {
+    std::string dir = Renderer::GetCacheDirectory("Benchmark");
+    return dir.empty() ? std::filesystem::path() : std::filesystem::path(dir) / "particle_backend.txt";
+}
+
+} // namespace
+
+const char* GetName(Backend backend) {
+    static const char* const names[kBackendCount] = {"point sprite", "instanced quad", "geometry quad"};
+    return names[(int)backend];
+}
+
+void Backends::Init(const unsigned int (&list)[kBackendCount]) {
+    GLint vertexBlocks = 0;
+    glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexBlocks);
+    for (int i = 0; i < kBackendCount; i++) {
+        programs[i] = list[i];
+        if (i == (int)Backend::InstancedQuad && vertexBlocks <= 0) {
+            programs[i] = 0;
+        }
+        if (!programs[i]) {
+            std::cout << "[ParticleBackend] " << GetName((Backend)i) << ": not supported" << std::endl;
+            continue;
+        }
+        Locations& loc   = locations[i];
+        loc.projection   = glGetUniformLocation(programs[i], "projection");
+        loc.view         = glGetUniformLocation(programs[i], "view");
+        loc.time         = glGetUniformLocation(programs[i], "uTime");
+        loc.densityComp  = glGetUniformLocation(programs[i], "uDensityComp");
+        loc.screenHeight = glGetUniformLocation(programs[i], "uScreenHeight");
+        loc.pointSizeMax = glGetUniformLocation(programs[i], "uPointSizeMax");
+        loc.largeDensity = glGetUniformLocation(programs[i], "uLargeDensity");
+        loc.viewport     = glGetUniformLocation(programs[i], "uViewport");
+    }
+    glGenVertexArrays(1, &emptyVao);
+}
+
+void Backends::Bind(Backend backend, const Params& params) const {
+    const Locations& loc = locations[(int)backend];
+    glUseProgram(programs[(int)backend]);
+    glUniformMatrix4fv(loc.projection, 1, 0, &params.projection[0][0]);
+    glUniformMatrix4fv(loc.view, 1, 0, &params.view[0][0]);
+    glUniform1f(loc.time, params.time);
+    glUniform1f(loc.densityComp, params.densityComp);
+    glUniform1f(loc.screenHeight, (float)params.height);
+    glUniform1f(loc.pointSizeMax, params.pointSizeMax);
+    glUniform1f(loc.largeDensity, params.largeDensity);
+    glUniform2f(loc.viewport, (float)params.width, (float)params.height);
+}
+
+void Backends::Draw(Backend backend, const Params& params, GLuint vao, GLuint indirectBuffer, GLuint particles) const {
+    Bind(backend, params);
+    if (backend == Backend::InstancedQuad) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindParticles, particles);
+        glBindVertexArray(emptyVao);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)params.count);
+    } else {
+        // 点精灵和几何着色器都按点提交，粒子数取自间接绘制命令
+        glBindVertexArray(vao);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        glDrawArraysIndirect(GL_POINTS, nullptr);
+    }
+}
+
+Backend RunBenchmark(const Backends& backends, GLuint framebuffer, int width, int height, uint32_t maxCount,
+                     const std::function<void(Backend, uint32_t)>& draw) {
+    const int   kRepeats   = 8;
+    const float kCounts[4] = {0.25f, 0.5f, 0.75f, 1.0f};
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+
+    // 每种配置重复 kRepeats 次包在一个 GL_TIME_ELAPSED 查询里，取平均
+    auto timeMs = [&](Backend backend, uint32_t count) {
+        draw(backend, count); // 预热
+        glFinish();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        for (int i = 0; i < kRepeats; i++) {
+            draw(backend, count);
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+        return (double)ns / 1.0e6 / kRepeats;
+    };
+
+    std::cout << "[ParticleBackend] Benchmark at " << width << "x" << height << ", " << kRepeats << " runs each"
+              << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    double totals[kBackendCount] = {};
+    for (float fraction : kCounts) {
+        uint32_t           count = (uint32_t)(maxCount * fraction);
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(3) << "[ParticleBackend] " << count << " particles:";
+        for (int i = 0; i < kBackendCount; i++) {
+            if (backends.IsSupported((Backend)i)) {
+                double ms = timeMs((Backend)i, count);
+                totals[i] += ms;
+                line << " " << GetName((Backend)i) << " " << ms << " ms";
+            }
+        }
+        std::cout << line.str() << std::endl;
+    }
+
+    Backend best = Backend::PointSprite;
+    for (int i = 0; i < kBackendCount; i++) {
+        if (backends.IsSupported((Backend)i) && totals[i] < totals[(int)best]) {
+            best = (Backend)i;
+        }
+    }
+    std::cout << "[ParticleBackend] Fastest: " << GetName(best) << std::endl;
+
+    glDeleteQueries(1, &query);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return best;
+}
+
+bool LoadChoice(Backend& backend) {
+    std::filesystem::path path = ChoicePath();
+    if (path.empty()) {
+        return false;
+    }
+    std::ifstream in(path);
+    std::string   identity;
+    int           version = 0, index = -1;
+    if (!std::getline(in, identity) || !(in >> version >> index)) {
+        return false;
+    }
+    if (identity != GpuIdentity() || version != kChoiceVersion || index < 0 || index >= kBackendCount) {
+        return false;
+    }
+    backend = (Backend)index;
+    return true;
+}
+
+void SaveChoice(Backend backend) {
+    std::filesystem::path path = ChoicePath();
+    if (path.empty()) {
+        return;
+    }
+    std::ofstream out(path, std::ios::trunc);
+    out << GpuIdentity() << "\n" << kChoiceVersion << " " << (int)backend << "\n";
+}
+
+} // namespace ParticleBackend
@@ -0,0 +1,67 @@
+#pragma once
+// 土星粒子的图元后端 - 同一组粒子 (三缓冲 SSBO) 的三种画法，着色结果相同
+// PointSprite: GL_POINTS + gl_PointSize (间接绘制)；点径受驱动的 GL_POINT_SIZE_RANGE 限制，部分核显上大点精灵很慢
+// InstancedQuad: 每个粒子一个实例、4 个顶点的三角形带，顶点着色器按 gl_InstanceID 从 SSBO 拉取粒子 (不用顶点属性)
+// GeometryQuad: 顶点着色器与点精灵相同，几何着色器把每个点扩展成四边形
+// 四边形与点精灵同样大小 (至少 1 像素)，片段着色器用插值的坐标代替 gl_PointCoord
+// 首次启动时在几档粒子数下用 GPU 计时比较可用的后端，最快的按 GPU 记录到缓存目录，之后直接使用
+
+#include <cstdint>
+#include <functional>
+
+namespace ParticleBackend {
+
+enum class Backend : uint8_t { PointSprite, InstancedQuad, GeometryQuad };
+static constexpr int kBackendCount = 3;
+
+const char* GetName(Backend backend);
+
+// 本帧粒子的变换 (与 VertexSaturn 的 uniform 一致；模型矩阵和缩放取自已绑定的 LatchedInput 块)
+struct Params {
+    glm::mat4 projection{1};
+    glm::mat4 view{1};
+    float     time         = 0.0f;
+    float     densityComp  = 1.0f;
+    float     pointSizeMax = 300.0f; // 点径上限 (1080p 像素，FillBudget)
+    float     largeDensity = 1.0f;   // 大粒子的保留比例 (FillBudget)
+    int       width = 0, height = 0; // 渲染目标尺寸
+    uint32_t  count = 0;             // 实例化四边形的粒子数 (点精灵和几何着色器读取间接绘制命令)
+};
+
+class Backends {
+  public:
+    // programs 依次为各后端的程序 (点精灵即 pSaturn)，编译失败为 0 时该后端不可用
+    // 顶点着色器不能访问 SSBO 的驱动 (GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS 为 0) 上实例化四边形不可用
+    void Init(const unsigned int (&programs)[kBackendCount]);
+
+    bool IsSupported(Backend backend) const { return programs[(int)backend] != 0; }
+
+    // 使用后端的程序并设置 uniform (点溅射的大粒子列表只用点精灵画)
+    void Bind(Backend backend, const Params& params) const;
+
+    // Bind 后画出全部粒子: 调用方预先设置混合状态
+    // vao / indirectBuffer 为点精灵和几何着色器用，particles 为本帧渲染用的粒子 SSBO (实例化四边形拉取)
+    void Draw(Backend backend, const Params& params, GLuint vao, GLuint indirectBuffer, GLuint particles) const;
+
+  private:
+    struct Locations {
+        GLint projection = -1, view = -1, time = -1, densityComp = -1, screenHeight = -1;
+        GLint pointSizeMax = -1, largeDensity = -1, viewport = -1;
+    };
+
+    GLuint    programs[kBackendCount] = {};
+    Locations locations[kBackendCount];
+    GLuint    emptyVao = 0; // 顶点拉取不需要属性，但核心配置要求绑定 VAO
+};
+
+// 首次启动的选择: 粒子数从 maxCount 的 1/4 到全部分几档，对每个可用后端计时，返回各档耗时之和最小的，结果输出到日志
+// draw(backend, count) 把 count 个粒子加法混合到 framebuffer (调用方负责更新间接绘制命令中的数量)
+Backend RunBenchmark(const Backends& backends, GLuint framebuffer, int width, int height, uint32_t maxCount,
+                     const std::function<void(Backend, uint32_t)>& draw);
+
+// 缓存的选择: 以 GL_RENDERER / GL_VERSION 为键，记录在 %LOCALAPPDATA%\ParticleSaturn\Benchmark
+// 没有记录、GPU 或驱动变化时返回 false (需要重新测量)
+bool LoadChoice(Backend& backend);
+void SaveChoice(Backend backend);
+
+} // namespace ParticleBackend
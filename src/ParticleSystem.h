@@ -3,12 +3,18 @@
 
 #include <ctime>
 
+#include "Renderer.h"
 #include "Shaders.h"
 #include "Utils.h"
 
 const unsigned int MAX_PARTICLES = 1200000;
 const unsigned int MIN_PARTICLES = 200000;
 const unsigned int STAR_COUNT    = 50000;
+const unsigned int STAR_BUDGET   = 250000; // 星空每帧最多绘制的星星数 (超出时按亮度丢弃最暗的星)
+
+const float STAR_LAYER_REFRESH_PIXELS = 0.5f; // 星空缓存层重投影位移超过该值 (像素) 时重绘
+const float RCAS_SHARPNESS_STOPS      = 0.2f; // 动态分辨率放大后的锐化强度 (档位，0 最强，每加 1 减半)
+const float RESIZE_SETTLE_SECONDS     = 0.2f; // 窗口尺寸停止变化这么久后才重建渲染目标 (拖动期间拉伸旧画面)
 
 // GPU 粒子数据结构 (优化: 32字节，从48字节减少33%)
 struct GPUParticle {
@@ -41,6 +47,9 @@ struct DoubleBufferSSBO {
     // 获取当前用于渲染的 VAO
     unsigned int GetRenderVAO() const { return vao[renderIdx]; }
 
+    // 获取当前用于渲染的 SSBO (点溅射计算着色器读取)
+    unsigned int GetRenderSSBO() const { return ssbo[renderIdx]; }
+
     // 获取当前用于读取的 SSBO (计算着色器输入)
     unsigned int GetReadSSBO() const { return ssbo[readIdx]; }
 
@@ -66,7 +75,8 @@ namespace ParticleSystem {
 inline std::string g_lastError;
 
 // GPU 粒子初始化 (三缓冲)，返回是否成功
-inline bool InitParticlesGPU(DoubleBufferSSBO& db) {
+// seed: 粒子分布随机种子 (输入回放时使用录制时的种子以复现初始状态)
+inline bool InitParticlesGPU(DoubleBufferSSBO& db, unsigned int seed) {
     g_lastError.clear();
     db.ssbo[0] = db.ssbo[1] = db.ssbo[2] = 0;
     db.vao[0] = db.vao[1] = db.vao[2] = 0;
@@ -113,39 +123,11 @@ inline bool InitParticlesGPU(DoubleBufferSSBO& db) {
     DrawArraysIndirectCommand cmd = {MAX_PARTICLES, 1, 0, 0};
     glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawArraysIndirectCommand), &cmd, GL_DYNAMIC_DRAW);
 
-    // 2. 编译初始化 Compute Shader
-    unsigned int cs = glCreateShader(GL_COMPUTE_SHADER);
-    glShaderSource(cs, 1, &Shaders::ComputeInitSaturn, 0);
-    glCompileShader(cs);
-
-    // 检查编译错误
-    int  success;
-    char infoLog[512];
-    glGetShaderiv(cs, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(cs, 512, NULL, infoLog);
-        g_lastError = std::string("Init shader compilation failed:\n") + infoLog;
+    // 2. 编译初始化 Compute Shader (走程序二进制缓存)
+    unsigned int pInit = Renderer::CreateComputeProgram(Shaders::ComputeInitSaturn, "compute_init");
+    if (!pInit) {
+        g_lastError = "Init compute program build failed:\n" + Renderer::GetLastProgramError();
         std::cerr << "[ParticleSystem] " << g_lastError << std::endl;
-        glDeleteShader(cs);
-        glDeleteBuffers(3, db.ssbo);
-        glDeleteBuffers(1, &db.indirectBuffer);
-        db.ssbo[0] = db.ssbo[1] = db.ssbo[2] = 0;
-        db.indirectBuffer                    = 0;
-        return false;
-    }
-
-    unsigned int pInit = glCreateProgram();
-    glAttachShader(pInit, cs);
-    glLinkProgram(pInit);
-
-    // 检查链接错误
-    glGetProgramiv(pInit, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(pInit, 512, NULL, infoLog);
-        g_lastError = std::string("Init program linking failed:\n") + infoLog;
-        std::cerr << "[ParticleSystem] " << g_lastError << std::endl;
-        glDeleteShader(cs);
-        glDeleteProgram(pInit);
         glDeleteBuffers(3, db.ssbo);
         glDeleteBuffers(1, &db.indirectBuffer);
         db.ssbo[0] = db.ssbo[1] = db.ssbo[2] = 0;
@@ -156,13 +138,12 @@ inline bool InitParticlesGPU(DoubleBufferSSBO& db) {
     // 3. 对第一个 SSBO 执行初始化
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, db.ssbo[0]);
     glUseProgram(pInit);
-    glUniform1ui(glGetUniformLocation(pInit, "uSeed"), (unsigned int)time(0));
+    glUniform1ui(glGetUniformLocation(pInit, "uSeed"), seed);
     glUniform1ui(glGetUniformLocation(pInit, "uMaxParticles"), MAX_PARTICLES);
     glDispatchCompute((MAX_PARTICLES + 255) / 256, 1, 1);
     glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
 
-    // 4. 清理 Shader
-    glDeleteShader(cs);
+    // 4. 清理 Program
     glDeleteProgram(pInit);
 
     // 5. 为三个 SSBO 设置 VAO (匹配优化后的数据结构)
@@ -192,7 +173,7 @@ inline bool InitParticlesGPU(DoubleBufferSSBO& db) {
 // 兼容旧接口 (内部使用静态双缓冲)
 inline bool InitParticlesGPU(unsigned int& ssbo, unsigned int& vao) {
     static DoubleBufferSSBO db;
-    if (!InitParticlesGPU(db)) {
+    if (!InitParticlesGPU(db, (unsigned int)time(0))) {
         return false;
     }
     ssbo = db.ssbo[0];
@@ -200,33 +181,4 @@ inline bool InitParticlesGPU(unsigned int& ssbo, unsigned int& vao) {
     return true;
 }
 
-// 创建星空背景
-inline void CreateStars(unsigned int& vao, unsigned int& vbo, int count = STAR_COUNT) {
-    std::default_random_engine            gen;
-    std::uniform_real_distribution<float> rnd(0, 1);
-    std::vector<glm::vec3> cols = {HexToRGB(0xE3DAC5), HexToRGB(0xC9A070), HexToRGB(0xE3DAC5), HexToRGB(0xB08D55)};
-
-    std::vector<float> starData;
-    for (int i = 0; i < count; i++) {
-        float     r  = 400 + rnd(gen) * 3000;
-        float     th = rnd(gen) * 6.28f;
-        float     ph = acos(2 * rnd(gen) - 1);
-        glm::vec3 c  = cols[i % 4];
-        starData.insert(starData.end(),
-                        {r * sin(ph) * cos(th), r * cos(ph), r * sin(ph) * sin(th), c.x, c.y, c.z, 1 + rnd(gen) * 3});
-    }
-
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, starData.size() * 4, starData.data(), GL_STATIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, 0, 28, 0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, 0, 28, (void*)12);
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 1, GL_FLOAT, 0, 28, (void*)24);
-}
-
 } // namespace ParticleSystem
@@ -0,0 +1,182 @@
+// PlanetSystem.cpp - 行星实例、GPU 剔除与 LOD 实现
+
+#include "pch.h"
+
+#include "PlanetSystem.h"
+#include "Renderer.h" // SphereMesh, UniformCache
+
+namespace PlanetSystem {
+
+LodMeshes BuildLodMeshes() {
+    LodMeshes out;
+    for (int L = 0; L < kLodLevels; L++) {
+        Renderer::SphereMesh mesh = Renderer::BuildSphereMesh(1.0f, kLodSegments[L], kLodSegments[L]);
+        out.firstIndex[L]         = (uint32_t)out.indices.size();
+        out.indexCount[L]         = (uint32_t)mesh.indices.size();
+        out.baseVertex[L]         = (int32_t)(out.vertices.size() / 8);
+        out.vertices.insert(out.vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        out.indices.insert(out.indices.end(), mesh.indices.begin(), mesh.indices.end());
+    }
+    return out;
+}
+
+std::vector<PlanetData> GenerateBodies(uint32_t count, uint32_t seed) {
+    // 小行星带: 岩石 / 铁锈 / 冰 / 赭石四种配色
+    static const int palette[4][2] = {
+        {0x555555, 0x9a9a9a}, {0x6b2f1a, 0xa0603a}, {0x5a7a99, 0xdfe8f0}, {0x7a5a2a, 0xc8a060}};
+    const float PI = (float)M_PI;
+
+    std::mt19937                          rng(seed);
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    std::vector<PlanetData>               bodies(count);
+    for (PlanetData& b : bodies) {
+        float angle  = u(rng) * 2.0f * PI;
+        float dist   = 250.0f + u(rng) * 650.0f;
+        float size   = u(rng);
+        int   type   = (int)(u(rng) * 4.0f) & 3;
+        b.pos        = glm::vec3(cosf(angle) * dist, (u(rng) - 0.5f) * 240.0f, sinf(angle) * dist);
+        b.radius     = 0.5f + 3.5f * size * size * size; // 大多数是小天体
+        b.color1     = HexToRGB(palette[type][0]);
+        b.color2     = HexToRGB(palette[type][1]);
+        b.noiseScale = 6.0f + u(rng) * 10.0f;
+        b.atmosphere = u(rng) * 0.2f;
+    }
+    return bodies;
+}
+
+void PlanetRenderer::Init(const LodMeshes& meshes, uint32_t maxBodies) {
+    // 每段实例数对齐到 64，并保证段偏移满足 SSBO 偏移对齐要求
+    GLint offsetAlign = 256;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &offsetAlign);
+    capacity = (std::clamp(maxBodies, 1u, kMaxInstances) + 63) / 64 * 64;
+    while ((capacity * sizeof(GPUInstance)) % std::max(1, offsetAlign) != 0) {
+        capacity += 64;
+    }
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glGenBuffers(1, &visibleBuffer);
+    glGenBuffers(1, &instanceBuffer);
+    glGenBuffers(1, &commandBuffer);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, meshes.vertices.size() * 4, meshes.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, meshes.indices.size() * 4, meshes.indices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, 0, 32, (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, 0, 32, (void*)12);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, 0, 32, (void*)24);
+
+    // 可见列表: 计算着色器写入，绘制时作为每实例属性读取 (baseInstance 偏移到各 LOD 的段)
+    glBindBuffer(GL_ARRAY_BUFFER, visibleBuffer);
+    glBufferStorage(GL_ARRAY_BUFFER, (GLsizeiptr)kLodLevels * capacity * sizeof(uint32_t), nullptr, 0);
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+    glVertexAttribDivisor(3, 1);
+    glBindVertexArray(0);
+
+    // 实例数据: 持久映射，CPU 每帧写入一段，围栏保证不覆盖 GPU 仍在读取的段
+    GLsizeiptr instanceBytes = (GLsizeiptr)kFramesInFlight * capacity * sizeof(GPUInstance);
+    GLbitfield flags         = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, instanceBuffer);
+    glBufferStorage(GL_SHADER_STORAGE_BUFFER, instanceBytes, nullptr, flags);
+    mapped = (GPUInstance*)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, instanceBytes, flags);
+
+    for (int L = 0; L < kLodLevels; L++) {
+        commands[L] = {meshes.indexCount[L], 0, meshes.firstIndex[L], meshes.baseVertex[L], L * capacity};
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferStorage(GL_DRAW_INDIRECT_BUFFER, sizeof(commands), commands, GL_DYNAMIC_STORAGE_BIT);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    std::cout << "[PlanetSystem] Capacity " << capacity << " instances, " << kLodLevels << " LOD meshes ("
+              << meshes.indices.size() / 3 << " triangles total)" << std::endl;
+}
+
+void PlanetRenderer::Update(const std::vector<PlanetData>& bodies, float t) {
+    count = std::min((uint32_t)bodies.size(), capacity);
+    if (!mapped) {
+        return;
+    }
+
+    // 等待 GPU 读完这一段 (三段轮转，通常已经完成)
+    if (fences[frame]) {
+        glClientWaitSync(fences[frame], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        glDeleteSync(fences[frame]);
+        fences[frame] = nullptr;
+    }
+
+    glm::mat4    orbitRot = glm::rotate(glm::mat4(1.f), t * 0.02f, glm::vec3(0, 1, 0));
+    float        selfRot  = t * 0.1f;
+    GPUInstance* out      = mapped + (size_t)frame * capacity;
+    for (uint32_t i = 0; i < count; i++) {
+        const PlanetData& p = bodies[i];
+        glm::mat4         m = orbitRot;
+        m                   = glm::translate(m, p.pos);
+        m                   = glm::rotate(m, selfRot, glm::vec3(0, 1, 0));
+        m                   = glm::scale(m, glm::vec3(p.radius));
+        // 法线矩阵在 CPU 计算一次，代替顶点着色器中逐顶点的 transpose(inverse(m))
+        glm::mat3 n            = glm::transpose(glm::inverse(glm::mat3(m)));
+        out[i].modelMatrix     = m;
+        out[i].normalMatrix[0] = glm::vec4(n[0], 0.0f);
+        out[i].normalMatrix[1] = glm::vec4(n[1], 0.0f);
+        out[i].normalMatrix[2] = glm::vec4(n[2], 0.0f);
+        out[i].color1          = glm::vec4(p.color1, p.noiseScale);
+        out[i].color2          = glm::vec4(p.color2, p.atmosphere);
+        out[i].bounds          = glm::vec4(glm::vec3(m[3]), p.radius);
+    }
+}
+
+void PlanetRenderer::Draw(GLuint cullProgram, GLuint planetProgram, const UniformCache& uc, const glm::mat4& proj,
+                          const glm::mat4& view, float screenHeight) {
+    if (count == 0 || !mapped) {
+        return;
+    }
+
+    // 视锥平面 (Gribb-Hartmann，归一化后可直接做球体测试)
+    glm::mat4 vp = proj * view;
+    glm::vec4 w(vp[0][3], vp[1][3], vp[2][3], vp[3][3]);
+    glm::vec4 planes[6];
+    for (int k = 0; k < 3; k++) {
+        glm::vec4 row(vp[0][k], vp[1][k], vp[2][k], vp[3][k]);
+        planes[k * 2]     = w + row;
+        planes[k * 2 + 1] = w - row;
+    }
+    for (glm::vec4& plane : planes) {
+        plane *= 1.0f / glm::length(glm::vec3(plane));
+    }
+
+    GLintptr   offset = (GLintptr)frame * capacity * sizeof(GPUInstance);
+    GLsizeiptr size   = (GLsizeiptr)capacity * sizeof(GPUInstance);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, instanceBuffer, offset, size);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, visibleBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, commandBuffer);
+
+    // 重置各 LOD 的实例计数
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(commands), commands);
+
+    glUseProgram(cullProgram);
+    glUniformMatrix4fv(uc.plc_uView, 1, 0, &view[0][0]);
+    glUniform4fv(uc.plc_uPlanes, 6, &planes[0][0]);
+    glUniform1f(uc.plc_uProjScale, proj[1][1] * screenHeight * 0.5f);
+    glUniform3f(uc.plc_uLodPixels, kLodPixels[0], kLodPixels[1], kLodPixels[2]);
+    glUniform1ui(uc.plc_uCount, count);
+    glUniform1ui(uc.plc_uCapacity, capacity);
+    glDispatchCompute((count + 63) / 64, 1, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+    glUseProgram(planetProgram);
+    glBindVertexArray(vao);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, kLodLevels, 0);
+
+    fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame         = (frame + 1) % kFramesInFlight;
+}
+
+} // namespace PlanetSystem
@@ -0,0 +1,87 @@
+#pragma once
+// 行星系统 - 实例数据放在 SSBO (支持上千个天体)，法线矩阵在 CPU 预计算
+// 计算着色器做视锥剔除并按投影半径为每个实例选择球体 LOD，生成多重间接绘制命令
+
+#include <cstdint>
+#include <vector>
+
+#include "Utils.h" // PlanetData
+
+struct UniformCache;
+
+namespace PlanetSystem {
+
+static constexpr int      kLodLevels      = 4;
+static constexpr int      kFramesInFlight = 3; // 实例数据环形缓冲段数
+static constexpr uint32_t kMaxInstances   = 16384;
+
+// 各级 LOD 的球体分段数 (LOD 0 最精细，与原来的 64x64 球体一致)
+static constexpr int kLodSegments[kLodLevels] = {64, 32, 16, 8};
+
+// 切换到更精细 LOD 的最小投影半径 (像素)，依次对应 LOD 0 / 1 / 2
+static constexpr float kLodPixels[kLodLevels - 1] = {96.0f, 32.0f, 10.0f};
+
+// SSBO 中的实例数据 (std430 布局，160 字节)
+struct GPUInstance {
+    glm::mat4 modelMatrix;
+    glm::vec4 normalMatrix[3]; // mat3 每列按 std430 补齐到 vec4
+    glm::vec4 color1;          // xyz = color, w = noiseScale
+    glm::vec4 color2;          // xyz = color, w = atmosphere
+    glm::vec4 bounds;          // xyz = 世界空间球心, w = 半径
+};
+
+// glMultiDrawElementsIndirect 命令 (计算着色器对 instanceCount 做原子累加)
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t  baseVertex;
+    uint32_t baseInstance;
+};
+
+// 所有 LOD 的单位球体网格，合并在同一组顶点 / 索引缓冲中 (顶点: pos3 + normal3 + uv2)
+struct LodMeshes {
+    std::vector<float>        vertices;
+    std::vector<unsigned int> indices;
+    uint32_t                  firstIndex[kLodLevels] = {};
+    uint32_t                  indexCount[kLodLevels] = {};
+    int32_t                   baseVertex[kLodLevels] = {};
+};
+
+// 生成各级 LOD 网格 (纯 CPU，可在工作线程调用)
+LodMeshes BuildLodMeshes();
+
+// 生成程序化小天体 (--planets <count>)，用于大量实例的压力测试
+std::vector<PlanetData> GenerateBodies(uint32_t count, uint32_t seed);
+
+class PlanetRenderer {
+  public:
+    // 上传网格并创建实例 / 可见列表 / 间接命令缓冲 (GL 线程)
+    void Init(const LodMeshes& meshes, uint32_t maxBodies);
+
+    // 计算本帧所有天体的模型矩阵和法线矩阵，写入环形缓冲的下一段
+    void Update(const std::vector<PlanetData>& bodies, float t);
+
+    // 剔除 + LOD 选择 (计算着色器)，然后用一次多重间接绘制画出所有可见天体
+    // 行星着色器的 v / p / ld uniform 和噪声纹理由调用方预先设置
+    void Draw(GLuint cullProgram, GLuint planetProgram, const UniformCache& uc, const glm::mat4& proj,
+              const glm::mat4& view, float screenHeight);
+
+    uint32_t GetCount() const { return count; }
+
+  private:
+    GLuint                      vao                     = 0;
+    GLuint                      vbo                     = 0;
+    GLuint                      ebo                     = 0;
+    GLuint                      instanceBuffer          = 0; // kFramesInFlight 段，每段 capacity 个 GPUInstance
+    GLuint                      visibleBuffer           = 0; // 每个 LOD 一段可见实例序号，同时作为每实例顶点属性
+    GLuint                      commandBuffer           = 0;
+    GPUInstance*                mapped                  = nullptr;
+    GLsync                      fences[kFramesInFlight] = {};
+    DrawElementsIndirectCommand commands[kLodLevels]    = {}; // instanceCount 为 0 的命令模板，每帧重置
+    uint32_t                    capacity                = 0;
+    uint32_t                    count                   = 0;
+    int                         frame                   = 0;
+};
+
+} // namespace PlanetSystem
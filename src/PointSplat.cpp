@@ -0,0 +1,183 @@
+// PointSplat.cpp - 点溅射光栅化实现
+
+#include "pch.h"
+
+#include "PointSplat.h"
+#include "FrameGraph.h" // Capacity
+#include "Renderer.h"   // UniformCache
+
+#include <cstddef>
+#include <iomanip>
+
+namespace PointSplat {
+
+namespace {
+
+// 与着色器中的绑定点一致
+constexpr GLuint kBindParticles = 0, kBindSplats = 1, kBindTileCounts = 2, kBindTileEnds = 3, kBindCounters = 4,
+                 kBindRefs = 5, kBindLarge = 6;
+
+constexpr size_t kSplatBytes = 16; // vec2 center + 2 x packHalf2x16
+
+GLuint CreateBuffer(GLenum target, GLsizeiptr size, const void* data) {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+    glBufferStorage(target, size, data, GL_DYNAMIC_STORAGE_BIT);
+    glBindBuffer(target, 0);
+    return buffer;
+}
+
+} // namespace
+
+void Rasterizer::Init(int width, int height, uint32_t maxParticles) {
+    w      = std::max(1, width);
+    h      = std::max(1, height);
+    tilesX = (w + kTileSize - 1) / kTileSize;
+    tilesY = (h + kTileSize - 1) / kTileSize;
+
+    if (!counterBuffer) {
+        refCapacity   = maxParticles * kRefsPerSplat;
+        counterBuffer = CreateBuffer(GL_SHADER_STORAGE_BUFFER, sizeof(GPUCounters), nullptr);
+        splatBuffer   = CreateBuffer(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)maxParticles * kSplatBytes, nullptr);
+        largeBuffer   = CreateBuffer(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)maxParticles * sizeof(uint32_t), nullptr);
+        refBuffer     = CreateBuffer(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)refCapacity * sizeof(uint32_t), nullptr);
+        size_t bytes  = (size_t)maxParticles * (kSplatBytes + sizeof(uint32_t)) + refCapacity * sizeof(uint32_t);
+        std::cout << "[PointSplat] Buffers for " << maxParticles << " particles (" << bytes / 1024 / 1024 << " MB)"
+                  << std::endl;
+    }
+
+    // 分块缓冲按帧图的尺寸档位分配，动态分辨率的小幅变化不重新分配，只有分块数超出容量时才重建
+    if (tileCounts && tilesX * tilesY <= tileCapacity) {
+        return;
+    }
+    if (tileCounts) {
+        glDeleteBuffers(1, &tileCounts);
+        glDeleteBuffers(1, &tileEnds);
+    }
+    tileCapacity = ((FrameGraph::Capacity(w) + kTileSize - 1) / kTileSize) *
+                   ((FrameGraph::Capacity(h) + kTileSize - 1) / kTileSize);
+    GLsizeiptr tileBytes = (GLsizeiptr)tileCapacity * sizeof(uint32_t);
+    tileCounts           = CreateBuffer(GL_SHADER_STORAGE_BUFFER, tileBytes, nullptr);
+    tileEnds             = CreateBuffer(GL_SHADER_STORAGE_BUFFER, tileBytes, nullptr);
+}
+
+void Rasterizer::Run(GLuint binProgram, GLuint scanProgram, GLuint scatterProgram, GLuint rasterProgram,
+                     const UniformCache& uc, GLuint particles, GLuint target, const Params& params) {
+    // 重置计数器和分块计数
+    GPUCounters counters = {0, 1, 0, 0, 0, 0, 1, 1, 0, 0};
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, counterBuffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(counters), &counters);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, tileCounts);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0, (GLsizeiptr)tilesX * tilesY * sizeof(uint32_t),
+                         GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindParticles, particles);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindSplats, splatBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindTileCounts, tileCounts);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindTileEnds, tileEnds);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindCounters, counterBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindRefs, refBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kBindLarge, largeBuffer);
+
+    // bin: 分类 + 分块计数
+    glUseProgram(binProgram);
+    glUniformMatrix4fv(uc.splatBin_projection, 1, 0, &params.projection[0][0]);
+    glUniformMatrix4fv(uc.splatBin_view, 1, 0, &params.view[0][0]);
+    glUniform1f(uc.splatBin_uTime, params.time);
+    glUniform1f(uc.splatBin_uDensityComp, params.densityComp);
+    glUniform2f(uc.splatBin_uViewport, (float)w, (float)h);
+    glUniform1ui(uc.splatBin_uParticleCount, params.count);
+    glUniform1f(uc.splatBin_uMaxSplatSize, kMaxSplatSize);
+    glUniform1f(uc.splatBin_uPointSizeMax, params.pointSizeMax);
+    glUniform1ui(uc.splatBin_uRefCapacity, refCapacity);
+    glDispatchCompute((params.count + 255) / 256, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // scan: 分块起点 + scatter 的调度参数
+    glUseProgram(scanProgram);
+    glUniform1ui(uc.splatScan_uTileCount, (GLuint)(tilesX * tilesY));
+    glDispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    // scatter: 填充分块列表 (调度规模由 GPU 上的小粒子数决定)
+    glUseProgram(scatterProgram);
+    glUniform2f(uc.splatScatter_uViewport, (float)w, (float)h);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, counterBuffer);
+    glDispatchComputeIndirect((GLintptr)offsetof(GPUCounters, dispatchX));
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // raster: 每个分块一个工作组，写满整张结果图像
+    glUseProgram(rasterProgram);
+    glBindImageTexture(0, target, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R11F_G11F_B10F);
+    glDispatchCompute(tilesX, tilesY, 1);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R11F_G11F_B10F);
+
+    // 结果作为纹理采样，大粒子列表作为间接绘制命令和元素数组
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT);
+}
+
+void Rasterizer::DrawLarge() {
+    // 元素数组绑定会记录到当前 VAO 中，粒子 VAO 的其他绘制不使用索引，不受影响
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, largeBuffer);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, counterBuffer);
+    glDrawElementsIndirect(GL_POINTS, GL_UNSIGNED_INT, nullptr);
+}
+
+Stats Rasterizer::ReadStats() const {
+    GPUCounters counters = {};
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, counterBuffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(counters), &counters);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    Stats s;
+    s.splats = counters.splatCount;
+    s.large  = counters.largeCount;
+    s.refs   = counters.refCount;
+    return s;
+}
+
+void RunBenchmark(Rasterizer& rasterizer, GLuint framebuffer, int width, int height,
+                  const std::function<void(float)>& setScale, const std::function<void()>& drawPoints,
+                  const std::function<void()>& drawHybrid) {
+    const int   kRepeats   = 32;
+    const float kScales[4] = {0.5f, 1.0f, 1.8f, 2.5f};
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+
+    // 每种配置重复 kRepeats 次包在一个 GL_TIME_ELAPSED 查询里，取平均
+    auto timeMs = [&](const std::function<void()>& fn) {
+        fn(); // 预热
+        glFinish();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        for (int i = 0; i < kRepeats; i++) {
+            fn();
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+        return (double)ns / 1.0e6 / kRepeats;
+    };
+
+    std::cout << "[PointSplat] Benchmark at " << width << "x" << height << ", " << kRepeats << " runs each"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    for (float scale : kScales) {
+        setScale(scale);
+        double pointsMs = timeMs(drawPoints);
+        double hybridMs = timeMs(drawHybrid);
+        Stats  s        = rasterizer.ReadStats();
+        std::cout << "[PointSplat] scale " << scale << ": points " << pointsMs << " ms, hybrid " << hybridMs
+                  << " ms (" << s.splats << " splatted, " << s.large << " point sprites, " << s.refs
+                  << " tile refs)" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+
+    glDeleteQueries(1, &query);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+} // namespace PointSplat
@@ -0,0 +1,80 @@
+#pragma once
+// 点溅射光栅化 - 屏幕上只有几个像素的小粒子改用计算着色器光栅化，大粒子仍走固定管线的点精灵
+// bin: 逐粒子投影并分类，小粒子写入溅射记录并统计覆盖的 16x16 分块，大粒子压缩成索引列表 (间接绘制)
+// scan: 分块计数前缀和；scatter: 把溅射记录序号填入各分块的列表
+// raster: 每个工作组负责一个分块，在共享内存里用定点数原子累加，最后整块写入结果图像 (不需要清屏)
+
+#include <cstdint>
+#include <functional>
+
+struct UniformCache;
+
+namespace PointSplat {
+
+static constexpr int   kTileSize     = 16;   // 分块边长 (像素)，与 raster 着色器的 local_size 一致
+static constexpr float kMaxSplatSize = 4.0f; // 点径 (像素) 不超过该值的粒子走计算光栅化
+static constexpr int   kRefsPerSplat = 2;    // 分块引用容量 = 粒子上限 * 该值，超出的粒子退回点精灵路径
+
+// 本帧粒子的变换 (与 VertexSaturn 的 uniform 一致；模型矩阵和缩放取自已绑定的 LatchedInput 块)
+struct Params {
+    glm::mat4 projection{1};
+    glm::mat4 view{1};
+    float     time         = 0.0f;
+    float     densityComp  = 1.0f;
+    float     pointSizeMax = 300.0f; // 点径上限 (1080p 像素，FillBudget)
+    uint32_t  count        = 0;
+};
+
+// GPU 计数器 (回读用于基准测试日志)
+struct Stats {
+    uint32_t splats = 0; // 计算光栅化的小粒子
+    uint32_t large  = 0; // 点精灵绘制的大粒子
+    uint32_t refs   = 0; // 分块引用总数
+};
+
+class Rasterizer {
+  public:
+    // 按渲染目标尺寸设置分块 (溅射记录和索引列表按粒子上限只创建一次)，尺寸变化时重新调用
+    // 分块缓冲按尺寸档位留有余量，只有超出容量时才重新分配
+    void Init(int width, int height, uint32_t maxParticles);
+
+    // bin -> scan -> scatter -> raster，小粒子的结果写入 target (R11F_G11F_B10F，与渲染目标同尺寸)
+    // particles 为本帧渲染用的粒子缓冲 (GL 线程)
+    void Run(GLuint binProgram, GLuint scanProgram, GLuint scatterProgram, GLuint rasterProgram,
+             const UniformCache& uc, GLuint particles, GLuint target, const Params& params);
+
+    // 用点精灵画出本帧分类为大粒子的部分: 调用方预先绑定粒子 VAO、设置土星着色器和混合状态
+    void DrawLarge();
+
+    // 回读本帧计数 (同步等待 GPU，只用于基准测试)
+    Stats ReadStats() const;
+
+  private:
+    // 与着色器中的 SplatCounters 布局一致: 大粒子绘制命令 + scatter 的间接调度参数 + 计数
+    struct GPUCounters {
+        uint32_t largeCount, largeInstances, largeFirst;
+        int32_t  largeBaseVertex;
+        uint32_t largeBaseInstance;
+        uint32_t dispatchX, dispatchY, dispatchZ;
+        uint32_t splatCount, refCount;
+    };
+
+    GLuint   counterBuffer = 0;
+    GLuint   splatBuffer   = 0; // 溅射记录: 屏幕位置 + 预乘颜色 / 点径 (half)，16 字节
+    GLuint   largeBuffer   = 0; // 大粒子序号 (元素数组)
+    GLuint   refBuffer     = 0; // 按分块排列的溅射记录序号
+    GLuint   tileCounts    = 0;
+    GLuint   tileEnds      = 0; // scan 写入各分块起点，scatter 累加后成为终点
+    int      w = 0, h = 0;
+    int      tilesX = 0, tilesY = 0;
+    int      tileCapacity = 0; // 分块缓冲能容纳的分块数
+    uint32_t refCapacity  = 0;
+};
+
+// --bench-splat: 在几档粒子缩放下 (粒子越近越大) 用 GPU 计时查询对比纯点精灵路径和混合路径，结果输出到日志
+// setScale 修改粒子缩放，drawPoints / drawHybrid 把全部土星粒子加法混合到 framebuffer
+void RunBenchmark(Rasterizer& rasterizer, GLuint framebuffer, int width, int height,
+                  const std::function<void(float)>& setScale, const std::function<void()>& drawPoints,
+                  const std::function<void()>& drawHybrid);
+
+} // namespace PointSplat
@@ -0,0 +1,107 @@
+// PowerMode.cpp - 省电模式实现
+
+#include "pch.h"
+
+#include "PowerMode.h"
+#include "WindowManager.h" // IsWindowOccluded
+
+#include <ctime>
+
+namespace PowerMode {
+
+namespace {
+
+// Active: 不限制，追踪 30 Hz (追踪器原生帧率)；Unfocused: 30 FPS，追踪 15 Hz；看不见时只以 4 / 2 Hz 处理事件，追踪暂停
+const Policy kPolicies[kStateCount] = {
+    {0.0, true, 33},
+    {1.0 / 30.0, true, 66},
+    {0.25, false, 0},
+    {0.5, false, 0},
+};
+
+// 进程累计 CPU 时间 (所有线程，含手部追踪)
+double ProcessCpuSeconds() {
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+    auto seconds = [](const FILETIME& ft) {
+        return (double)(((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime) * 1.0e-7;
+    };
+    return seconds(kernelTime) + seconds(userTime);
+#else
+    return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+} // namespace
+
+const Policy& GetPolicy(State state) {
+    return kPolicies[(int)state];
+}
+
+const char* GetName(State state) {
+    static const char* const names[kStateCount] = {"Active", "Unfocused", "Occluded", "Minimized"};
+    return names[(int)state];
+}
+
+State Governor::Update(GLFWwindow* window, const AppState& state, bool enabled) {
+    double now = glfwGetTime();
+    double cpu = ProcessCpuSeconds();
+    if (lastWall >= 0.0) {
+        Totals& t = totals[(int)current];
+        t.wall += now - lastWall;
+        t.cpu += cpu - lastCpu;
+    }
+    lastWall = now;
+    lastCpu  = cpu;
+
+    // 遮挡检测低频轮询；最小化时不需要
+    if (!enabled || state.window.iconified) {
+        occluded = false;
+        lastPoll = -1.0;
+    } else if (lastPoll < 0.0 || now - lastPoll >= kOcclusionPollSeconds) {
+        occluded = WindowManager::IsWindowOccluded(window);
+        lastPoll = now;
+    }
+
+    State next = State::Active;
+    if (enabled) {
+        if (state.window.iconified) {
+            next = State::Minimized;
+        } else if (occluded) {
+            next = State::Occluded;
+        } else if (!state.window.focused) {
+            next = State::Unfocused;
+        }
+    }
+    if (next != current) {
+        Usage u = GetUsage(current);
+        std::cout << "[PowerMode] " << GetName(current) << " -> " << GetName(next) << " (" << GetName(current)
+                  << ": " << u.seconds << " s, CPU " << u.cpuPercent << "%, GPU " << u.gpuPercent << "%, " << u.fps
+                  << " FPS)" << std::endl;
+        current = next;
+    }
+    return current;
+}
+
+void Governor::AddFrame(double gpuMs) {
+    Totals& t = totals[(int)current];
+    t.gpuMs += gpuMs;
+    t.frames += 1.0;
+}
+
+Usage Governor::GetUsage(State state) const {
+    const Totals& t = totals[(int)state];
+    Usage         u;
+    u.seconds = t.wall;
+    if (t.wall > 0.0) {
+        u.cpuPercent = t.cpu / t.wall * 100.0;
+        u.gpuPercent = t.gpuMs / 10.0 / t.wall;
+        u.fps        = t.frames / t.wall;
+    }
+    return u;
+}
+
+} // namespace PowerMode
@@ -0,0 +1,65 @@
+#pragma once
+// 省电模式 - 窗口最小化、被完全遮挡或失去焦点时降低开销
+// 状态来自 GLFW 的最小化 / 焦点回调，以及 Windows 下低频轮询的遮挡检测 (被 DWM 隐藏或被上层窗口完全覆盖)
+// 看不见时不渲染也不推进粒子模拟，只低频处理窗口事件，手部追踪暂停 (追踪器释放摄像头、停止推理)；失去焦点时限制帧率并降低追踪频率
+// 按状态累计进程 CPU 占用 (占单核的百分比) 和 GPU 占用 (帧图各 pass 的 GPU 耗时 / 墙钟时间)
+
+#include <cstdint>
+
+struct AppState;
+struct GLFWwindow;
+
+namespace PowerMode {
+
+static constexpr double kOcclusionPollSeconds = 0.5; // 遮挡检测的轮询间隔 (要枚举上层窗口，不每帧做)
+
+enum class State : uint8_t { Active, Unfocused, Occluded, Minimized };
+static constexpr int kStateCount = 4;
+
+// 每个状态的开销策略
+struct Policy {
+    double frameInterval;     // 最小帧间隔 (秒)，0 表示不限制 (由 VSync / 帧节奏决定)
+    bool   render;            // 是否渲染并推进粒子模拟
+    int    trackerIntervalMs; // 手部追踪器处理摄像头帧的间隔，0 表示暂停 (释放摄像头)
+};
+
+const Policy& GetPolicy(State state);
+const char*   GetName(State state); // 日志用
+
+// 某个状态下的累计占用
+struct Usage {
+    double seconds    = 0.0; // 处于该状态的总时间
+    double cpuPercent = 0.0; // 进程 CPU 时间 / 墙钟时间 (占单核的百分比，多线程时可超过 100)
+    double gpuPercent = 0.0; // GPU 忙碌时间 / 墙钟时间
+    double fps        = 0.0;
+};
+
+class Governor {
+  public:
+    // 每次循环开始调用，返回本次循环的状态；enabled 为 false 时 (关闭省电、回放、基准测试) 总是 Active
+    // 同时把上一次调用以来的时间和进程 CPU 时间记到上一个状态
+    State Update(GLFWwindow* window, const AppState& state, bool enabled);
+
+    // 渲染了一帧 (gpuMs 为本帧帧图各 pass 的 GPU 耗时之和)
+    void AddFrame(double gpuMs);
+
+    State GetState() const { return current; }
+    Usage GetUsage(State state) const;
+
+  private:
+    struct Totals {
+        double wall   = 0.0;
+        double cpu    = 0.0;
+        double gpuMs  = 0.0;
+        double frames = 0.0;
+    };
+
+    Totals totals[kStateCount];
+    State  current  = State::Active;
+    bool   occluded = false;
+    double lastPoll = -1.0; // 上一次遮挡检测的时间
+    double lastWall = -1.0; // 上一次 Update 的墙钟时间 (< 0 表示尚未开始)
+    double lastCpu  = 0.0;
+};
+
+} // namespace PowerMode
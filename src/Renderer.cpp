@@ -3,8 +3,19 @@
 
 #include "pch.h"
 
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "Renderer.h"
+
 namespace Renderer {
 
+// 最近一次着色器编译/链接错误 (供调用者拼接到错误对话框)
+static std::string s_lastProgramError;
+
 // 检查 shader 编译状态
 static bool CheckShaderCompile(unsigned int shader, const char* type) {
     int success;
@@ -13,6 +24,7 @@ static bool CheckShaderCompile(unsigned int shader, const char* type) {
         char infoLog[512];
         glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
         std::cerr << "[Renderer] " << type << " shader compile error: " << infoLog << std::endl;
+        s_lastProgramError = std::string(type) + " shader compile error: " + infoLog;
         return false;
     }
     return true;
@@ -26,6 +38,7 @@ static bool CheckProgramLink(unsigned int program) {
         char infoLog[512];
         glGetProgramInfoLog(program, sizeof(infoLog), nullptr, infoLog);
         std::cerr << "[Renderer] Program link error: " << infoLog << std::endl;
+        s_lastProgramError = std::string("Program link error: ") + infoLog;
         return false;
     }
     return true;
@@ -41,86 +54,398 @@ bool CheckProgramLinkStatus(unsigned int program) {
     return CheckProgramLink(program);
 }
 
-// 创建着色器程序，失败时返回 0
-unsigned int CreateProgramImpl(const char* vertexSrc, const char* fragmentSrc) {
-    unsigned int vs = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vs, 1, &vertexSrc, 0);
-    glCompileShader(vs);
-    if (!CheckShaderCompile(vs, "Vertex")) {
-        glDeleteShader(vs);
+const std::string& GetLastProgramError() {
+    return s_lastProgramError;
+}
+
+// ============================================================================
+// 程序二进制缓存
+// ============================================================================
+
+// 缓存文件头 (文件名为键的十六进制，文件头中再存一次键以防哈希文件名冲突)
+struct ProgramBinaryHeader {
+    char     magic[4]; // "PSPB"
+    uint32_t binaryFormat;
+    uint32_t length;
+    uint32_t reserved;
+    uint64_t key;
+};
+
+struct ProgramCacheState {
+    bool                  enabled = false;
+    std::filesystem::path dir;
+    std::string           glIdentity; // GL_RENDERER + GL_VERSION，驱动升级后自动失效
+    int                   hits     = 0;
+    int                   misses   = 0;
+    int                   rejected = 0;
+    double                totalMs  = 0.0;
+};
+
+static ProgramCacheState s_programCache;
+
+// 缓存格式版本 (修改文件格式或编译选项时递增)
+static const uint32_t kProgramCacheVersion = 1;
+
+// FNV-1a 64 位哈希 (GL 标识 + 各段源码)，各段之间插入分隔符避免 "ab"+"c" 与 "a"+"bc" 冲突
+static uint64_t HashProgramSources(std::initializer_list<const char*> parts) {
+    uint64_t hash = 1469598103934665603ull;
+    auto     mix  = [&](unsigned char c) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    };
+    for (char c : s_programCache.glIdentity) {
+        mix((unsigned char)c);
+    }
+    for (const char* p : parts) {
+        for (; *p; ++p) {
+            mix((unsigned char)*p);
+        }
+        mix(0xFF);
+    }
+    for (int i = 0; i < 4; i++) {
+        mix((unsigned char)(kProgramCacheVersion >> (i * 8)));
+    }
+    return hash;
+}
+
+static std::filesystem::path CachePathForKey(uint64_t key) {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return s_programCache.dir / name;
+}
+
+std::string GetCacheDirectory(const char* subdir) {
+#ifdef _WIN32
+    char                  localAppData[MAX_PATH];
+    DWORD                 len = GetEnvironmentVariableA("LOCALAPPDATA", localAppData, MAX_PATH);
+    std::filesystem::path dir = (len > 0 && len < MAX_PATH) ? std::filesystem::path(localAppData) / "ParticleSaturn"
+                                                            : std::filesystem::path(".");
+#else
+    std::filesystem::path dir = ".";
+#endif
+    dir /= subdir;
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) {
+        std::cout << "[Renderer] Cannot create cache directory " << dir.string() << " (" << ec.message() << ")"
+                  << std::endl;
+        return "";
+    }
+    return dir.string();
+}
+
+void InitProgramCache() {
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0) {
+        std::cout << "[ShaderCache] Disabled: driver reports no program binary formats" << std::endl;
+        return;
+    }
+
+    std::string dir = GetCacheDirectory("ShaderCache");
+    if (dir.empty()) {
+        std::cout << "[ShaderCache] Disabled: no cache directory" << std::endl;
+        return;
+    }
+    s_programCache.dir = dir;
+
+    s_programCache.glIdentity = std::string((const char*)glGetString(GL_RENDERER)) + "|" +
+                                (const char*)glGetString(GL_VERSION) + "|" + (const char*)glGetString(GL_VENDOR);
+    s_programCache.enabled = true;
+    std::cout << "[ShaderCache] Enabled: " << s_programCache.dir.string() << std::endl;
+}
+
+void LogProgramCacheStats() {
+    std::cout << "[ShaderCache] " << (s_programCache.hits + s_programCache.misses)
+              << " programs: " << s_programCache.hits << " hits, " << s_programCache.misses << " misses, "
+              << s_programCache.rejected << " rejected, total " << s_programCache.totalMs << " ms" << std::endl;
+}
+
+// 尝试从缓存加载程序，失败 (未命中或驱动拒绝) 返回 0
+static unsigned int LoadCachedProgram(uint64_t key, const char* name) {
+    std::filesystem::path path = CachePathForKey(key);
+    std::ifstream         in(path, std::ios::binary);
+    if (!in.is_open()) {
         return 0;
     }
 
-    unsigned int fs = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fs, 1, &fragmentSrc, 0);
-    glCompileShader(fs);
-    if (!CheckShaderCompile(fs, "Fragment")) {
-        glDeleteShader(vs);
-        glDeleteShader(fs);
+    // 长度字段来自磁盘，先与文件大小核对再分配；截断或损坏的缓存删除后回退到源码编译
+    std::error_code     ec;
+    uintmax_t           fileSize = std::filesystem::file_size(path, ec);
+    ProgramBinaryHeader header   = {};
+    in.read((char*)&header, sizeof(header));
+    if (ec || !in || memcmp(header.magic, "PSPB", 4) != 0 || header.key != key || header.length == 0 ||
+        header.length != fileSize - sizeof(header)) {
+        std::cout << "[ShaderCache] " << name << ": corrupt cache file, recompiling" << std::endl;
+        in.close();
+        std::filesystem::remove(path, ec);
+        s_programCache.rejected++;
+        return 0;
+    }
+    std::vector<char> binary(header.length);
+    in.read(binary.data(), header.length);
+    if (!in) {
         return 0;
     }
 
     unsigned int program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-
-    if (!CheckProgramLink(program)) {
+    glProgramBinary(program, header.binaryFormat, binary.data(), (GLsizei)header.length);
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // 驱动拒绝 (驱动更新、格式不兼容等)，删除失效缓存并回退到源码编译
+        std::cout << "[ShaderCache] " << name << ": binary rejected by driver, recompiling" << std::endl;
         glDeleteProgram(program);
+        std::filesystem::remove(path, ec);
+        s_programCache.rejected++;
         return 0;
     }
-
     return program;
 }
 
-// 生成 FBM 噪声纹理 (用于行星表面)
-unsigned int GenerateFBMTextureImpl(int width, int height) {
-    // 辅助函数: 2D 哈希噪声
-    auto hash = [](float x, float y) -> float { return fmodf(sinf(x * 12.9898f + y * 78.233f) * 43758.5453f, 1.0f); };
+static void SaveCachedProgram(unsigned int program, uint64_t key) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    ProgramBinaryHeader header = {};
+    memcpy(header.magic, "PSPB", 4);
+    header.key = key;
+    std::vector<char> binary(length);
+    GLenum            format  = 0;
+    GLsizei           written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return;
+    }
+    header.binaryFormat = format;
+    header.length       = (uint32_t)written;
+
+    // 先写临时文件再重命名，避免崩溃时留下截断的缓存
+    std::filesystem::path path = CachePathForKey(key);
+    std::filesystem::path tmp  = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return;
+        }
+        out.write((const char*)&header, sizeof(header));
+        out.write(binary.data(), written);
+        if (!out) {
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+}
+
+// ============================================================================
+// 程序创建 (提交/完成两阶段)
+// ============================================================================
 
-    // 辅助函数: 平滑插值噪声
-    auto noise = [&](float x, float y) -> float {
-        int   ix = (int)floorf(x);
-        int   iy = (int)floorf(y);
-        float fx = x - ix;
-        float fy = y - iy;
-        float ux = fx * fx * (3.0f - 2.0f * fx);
-        float uy = fy * fy * (3.0f - 2.0f * fy);
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile (两者枚举值相同)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void(APIENTRY* MaxShaderCompilerThreadsFn)(GLuint count);
 
-        float a = hash((float)ix, (float)iy);
-        float b = hash((float)(ix + 1), (float)iy);
-        float c = hash((float)ix, (float)(iy + 1));
-        float d = hash((float)(ix + 1), (float)(iy + 1));
+static bool s_parallelCompile = false;
 
-        return a + (b - a) * ux + (c - a) * uy + (a - b - c + d) * ux * uy;
-    };
+void InitParallelShaderCompile() {
+    const char* fnName = nullptr;
+    if (glfwExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        fnName = "glMaxShaderCompilerThreadsKHR";
+    } else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile")) {
+        fnName = "glMaxShaderCompilerThreadsARB";
+    }
+    MaxShaderCompilerThreadsFn maxThreads =
+        fnName ? (MaxShaderCompilerThreadsFn)glfwGetProcAddress(fnName) : nullptr;
+    if (!maxThreads) {
+        std::cout << "[ShaderCache] Parallel shader compile: not supported" << std::endl;
+        return;
+    }
+    // 0xFFFFFFFF: 由驱动决定编译线程数
+    maxThreads(0xFFFFFFFFu);
+    s_parallelCompile = true;
+    std::cout << "[ShaderCache] Parallel shader compile: enabled (" << fnName << ")" << std::endl;
+}
+
+static const char* StageName(unsigned int type) {
+    switch (type) {
+    case GL_VERTEX_SHADER:
+        return "Vertex";
+    case GL_FRAGMENT_SHADER:
+        return "Fragment";
+    case GL_GEOMETRY_SHADER:
+        return "Geometry";
+    default:
+        return "Compute";
+    }
+}
+
+// 提交程序: 命中缓存则直接加载二进制；否则只提交编译和链接，不查询结果
+// 查询 GL_COMPILE_STATUS/GL_LINK_STATUS 会阻塞到编译结束，推迟到 FinishProgram 才能让驱动在后台并行编译
+static PendingProgram SubmitProgram(const char* name, std::initializer_list<const char*> hashParts,
+                                    std::initializer_list<std::pair<unsigned int, const char*>> stages) {
+    PendingProgram pending;
+    pending.name  = name;
+    pending.start = std::chrono::steady_clock::now();
 
-    // FBM: 5 层噪声叠加
-    auto fbm = [&](float x, float y) -> float {
-        float value = 0.0f;
-        float amp   = 0.5f;
-        for (int i = 0; i < 5; i++) {
-            value += amp * noise(x, y);
-            x *= 2.0f;
-            y *= 2.0f;
-            amp *= 0.5f;
+    if (s_programCache.enabled) {
+        pending.key     = HashProgramSources(hashParts);
+        pending.program = LoadCachedProgram(pending.key, name);
+        if (pending.program) {
+            pending.cacheHit = true;
+            return pending;
         }
-        return value;
-    };
+    }
+
+    pending.program = glCreateProgram();
+    int i           = 0;
+    for (const auto& [type, source] : stages) {
+        unsigned int shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, 0);
+        glCompileShader(shader);
+        glAttachShader(pending.program, shader);
+        pending.shaders[i] = shader;
+        pending.types[i]   = type;
+        i++;
+    }
+    // 链接前声明需要读取二进制，部分驱动否则返回空二进制
+    glProgramParameteri(pending.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(pending.program);
+    return pending;
+}
 
-    std::vector<unsigned char> data(width * height);
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float u             = (float)x / width * 16.0f;
-            float v             = (float)y / height * 16.0f;
-            float value         = fbm(u, v);
-            data[y * width + x] = (unsigned char)(value * 255.0f);
+// 检查编译/链接结果并写入缓存，失败时返回 0
+static unsigned int FinishProgram(PendingProgram& pending) {
+    if (!pending.cacheHit) {
+        bool ok = true;
+        for (int i = 0; i < 3 && pending.shaders[i]; i++) {
+            if (ok && !CheckShaderCompile(pending.shaders[i], StageName(pending.types[i]))) {
+                ok = false;
+            }
+            glDeleteShader(pending.shaders[i]);
+            pending.shaders[i] = 0;
+        }
+        if (ok && !CheckProgramLink(pending.program)) {
+            ok = false;
+        }
+        if (!ok) {
+            glDeleteProgram(pending.program);
+            pending.program = 0;
+        } else if (s_programCache.enabled) {
+            SaveCachedProgram(pending.program, pending.key);
         }
     }
 
+    if (pending.program) {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending.start).count();
+        (pending.cacheHit ? s_programCache.hits : s_programCache.misses)++;
+        std::cout << "[ShaderCache] " << pending.name << ": " << (pending.cacheHit ? "cache hit" : "compiled") << " ("
+                  << ms << " ms)" << std::endl;
+    }
+    return pending.program;
+}
+
+// 同步创建: 提交后立即完成
+static unsigned int CreateProgramNow(PendingProgram pending) {
+    unsigned int program = FinishProgram(pending);
+    s_programCache.totalMs +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending.start).count();
+    return program;
+}
+
+// 创建着色器程序，失败时返回 0
+unsigned int CreateProgramImpl(const char* vertexSrc, const char* fragmentSrc, const char* name) {
+    return CreateProgramNow(SubmitProgram(name, {vertexSrc, fragmentSrc},
+                                          {{GL_VERTEX_SHADER, vertexSrc}, {GL_FRAGMENT_SHADER, fragmentSrc}}));
+}
+
+// 创建计算着色器程序，失败时返回 0
+unsigned int CreateComputeProgramImpl(const char* computeSrc, const char* name) {
+    return CreateProgramNow(SubmitProgram(name, {"compute", computeSrc}, {{GL_COMPUTE_SHADER, computeSrc}}));
+}
+
+void ProgramBatch::Add(unsigned int* out, const char* vertexSrc, const char* fragmentSrc, const char* name) {
+    pending.push_back(SubmitProgram(name, {vertexSrc, fragmentSrc},
+                                    {{GL_VERTEX_SHADER, vertexSrc}, {GL_FRAGMENT_SHADER, fragmentSrc}}));
+    outputs.push_back(out);
+    mainThreadMs +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending.back().start).count();
+}
+
+void ProgramBatch::AddGeometry(unsigned int* out, const char* vertexSrc, const char* geometrySrc,
+                               const char* fragmentSrc, const char* name) {
+    pending.push_back(SubmitProgram(
+        name, {vertexSrc, geometrySrc, fragmentSrc},
+        {{GL_VERTEX_SHADER, vertexSrc}, {GL_GEOMETRY_SHADER, geometrySrc}, {GL_FRAGMENT_SHADER, fragmentSrc}}));
+    outputs.push_back(out);
+    mainThreadMs +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending.back().start).count();
+}
+
+void ProgramBatch::AddCompute(unsigned int* out, const char* computeSrc, const char* name) {
+    pending.push_back(SubmitProgram(name, {"compute", computeSrc}, {{GL_COMPUTE_SHADER, computeSrc}}));
+    outputs.push_back(out);
+    mainThreadMs +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending.back().start).count();
+}
+
+bool ProgramBatch::Finish(const std::function<void()>& pump) {
+    if (pending.empty()) {
+        return true;
+    }
+    auto finishStart = std::chrono::steady_clock::now();
+
+    // 并行编译: 轮询完成状态 (不阻塞)，期间处理窗口消息；不支持时 FinishProgram 中的状态查询会同步等待
+    if (s_parallelCompile) {
+        auto allComplete = [&] {
+            for (const PendingProgram& p : pending) {
+                GLint complete = GL_TRUE;
+                if (!p.cacheHit) {
+                    glGetProgramiv(p.program, GL_COMPLETION_STATUS_KHR, &complete);
+                }
+                if (!complete) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        while (!allComplete()) {
+            if (pump) {
+                pump();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < pending.size(); i++) {
+        *outputs[i] = FinishProgram(pending[i]);
+        ok          = ok && *outputs[i] != 0;
+    }
+
+    auto   now     = std::chrono::steady_clock::now();
+    double readyMs = std::chrono::duration<double, std::milli>(now - pending.front().start).count();
+    mainThreadMs += std::chrono::duration<double, std::milli>(now - finishStart).count();
+    s_programCache.totalMs += mainThreadMs;
+    std::cout << "[ShaderCache] Batch of " << pending.size() << " programs ready " << readyMs
+              << " ms after submit, main thread " << mainThreadMs << " ms (parallel compile "
+              << (s_parallelCompile ? "on" : "off") << ")" << std::endl;
+
+    pending.clear();
+    outputs.clear();
+    mainThreadMs = 0.0;
+    return ok;
+}
+
+// 上传 FBM 噪声数据为纹理 (需在 GL 线程调用)
+unsigned int CreateFBMTexture(const std::vector<unsigned char>& data, int width, int height) {
     unsigned int tex;
     glGenTextures(1, &tex);
     glBindTexture(GL_TEXTURE_2D, tex);
@@ -2,75 +2,122 @@
 
 // 渲染器 - OpenGL 渲染工具、FBO 管理、着色器编译
 
-#include "Utils.h" // 需要 PlanetInstance 定义
+#include <chrono>
+#include <functional>
+
+#include "Utils.h"
 
 // M_PI 可能未定义 (MSVC 需要 _USE_MATH_DEFINES 在 <cmath> 之前)
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-// 模糊效果帧缓冲
-// 优化: 使用 R11F_G11F_B10F 格式 (4字节/像素) 代替 RGB16F (6字节/像素)
-// 对于模糊效果，精度足够，节省 33% 内存带宽
-struct BlurFramebuffer {
-    GLuint fbo = 0, tex = 0;
-    int    w = 0, h = 0;
-
-    void Init(int width, int height) {
-        w = width;
-        h = height;
-        if (fbo) {
-            glDeleteFramebuffers(1, &fbo);
-            glDeleteTextures(1, &tex);
-        }
-        glGenFramebuffers(1, &fbo);
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
-        // 优化: R11F_G11F_B10F 是紧凑的 HDR 格式，每像素 4 字节
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, width, height, 0, GL_RGB, GL_FLOAT, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    }
-};
-
 // Uniform 位置缓存（避免重复查询）
 struct UniformCache {
     GLint comp_uDt, comp_uHandScale, comp_uHandHas, comp_uParticleCount;
-    GLint sat_proj, sat_view, sat_model, sat_uTime, sat_uScale, sat_uPixelRatio, sat_uDensityComp, sat_uScreenHeight,
-        sat_uNoiseTexture;
-    GLint star_proj, star_view, star_model, star_uTime;
+    // 土星粒子 (model / uScale 在 LatchedInput uniform 块中)
+    GLint sat_proj, sat_view, sat_uTime, sat_uDensityComp, sat_uScreenHeight, sat_uNoiseTexture, sat_uPointSizeMax,
+        sat_uLargeDensity;
+    GLint star_proj, star_view, star_model;
+    // 星空缓存层合成
+    GLint starLayer_uTexture, starLayer_uReproject, starLayer_uTime;
     // 行星着色器 (实例化渲染)
-    GLint           pl_p, pl_v, pl_ld, pl_uFBMTex, pl_uPlanetCount;
-    GLuint          pl_ubo;        // 行星 UBO
-    PlanetInstance* pl_ubo_mapped; // Persistent mapped buffer 指针 (OpenGL 4.4+)
-    GLint           ui_proj, ui_uColor, ui_uTransform;
+    GLint pl_p, pl_v, pl_ld, pl_uFBMTex;
+    // 行星剔除 / LOD 计算着色器
+    GLint plc_uView, plc_uPlanes, plc_uProjScale, plc_uLodPixels, plc_uCount, plc_uCapacity;
+    GLint ui_proj, ui_uColor, ui_uTransform;
     // 模糊着色器 (Kawase Blur)
     GLint blur_uTexture, blur_uTexelSize, blur_uOffset;
+    // 模糊金字塔 (计算着色器，只计算 UI 面板背后的区域)
+    GLint blurDown_uOffset, blurDown_uSrcMax, blurUp_uOffset;
+    // 动态分辨率放大
+    GLint easu_uTexture, easu_uScale, easu_uSrcSize;
+    // 粒子时间累积
+    GLint accum_uCurrent, accum_uHistory, accum_uInvViewProj, accum_uPrevViewProj, accum_uPrevScale, accum_uStep,
+        accum_uHistoryWeight, accum_uHistoryScale;
+    GLint copy_uTexture;
+    // 点溅射光栅化
+    GLint splatBin_projection, splatBin_view, splatBin_uTime, splatBin_uDensityComp, splatBin_uViewport,
+        splatBin_uParticleCount, splatBin_uMaxSplatSize, splatBin_uPointSizeMax, splatBin_uRefCapacity;
+    GLint splatScan_uTileCount, splatScatter_uViewport;
+    // 土星远景替身
+    GLint imp_uViewProj, imp_uBoundRadius, imp_uAtlas;
     // 全屏四边形着色器
-    GLint quad_uTexture, quad_uTransparent;
+    GLint quad_uTexture, quad_uTransparent, quad_uSharpness, quad_uUVScale;
 };
 
 namespace Renderer {
 
 // 声明 (实现在 Renderer.cpp)
-unsigned int CreateProgramImpl(const char* vertexSrc, const char* fragmentSrc);
-unsigned int GenerateFBMTextureImpl(int width, int height);
-bool         CheckShaderCompileStatus(unsigned int shader, const char* type);
-bool         CheckProgramLinkStatus(unsigned int program);
-
-// 创建着色器程序 (转发到实现)
-inline unsigned int CreateProgram(const char* vertexSrc, const char* fragmentSrc) {
-    return CreateProgramImpl(vertexSrc, fragmentSrc);
+unsigned int       CreateProgramImpl(const char* vertexSrc, const char* fragmentSrc, const char* name);
+unsigned int       CreateComputeProgramImpl(const char* computeSrc, const char* name);
+unsigned int       CreateFBMTexture(const std::vector<unsigned char>& data, int width, int height);
+bool               CheckShaderCompileStatus(unsigned int shader, const char* type);
+bool               CheckProgramLinkStatus(unsigned int program);
+const std::string& GetLastProgramError();
+
+// 获取 (并创建) %LOCALAPPDATA%\ParticleSaturn\<subdir> 缓存目录，失败返回空字符串
+std::string GetCacheDirectory(const char* subdir);
+
+// 程序二进制缓存 (glGetProgramBinary/glProgramBinary)
+// 以源码哈希 + GL_RENDERER/GL_VERSION 为键存到 %LOCALAPPDATA%\ParticleSaturn\ShaderCache
+// 需要在 GL 上下文创建后、编译任何程序前调用；驱动拒绝缓存的二进制时自动回退到源码编译
+void InitProgramCache();
+
+// 输出缓存命中次数和编译总耗时到日志
+void LogProgramCacheStats();
+
+// 启用驱动并行编译 (GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile)
+// 不支持时 ProgramBatch 退化为逐个同步编译
+void InitParallelShaderCompile();
+
+// 已提交、尚未检查结果的程序 (ProgramBatch 内部使用)
+struct PendingProgram {
+    const char*                           name       = "";
+    uint64_t                              key        = 0;
+    unsigned int                          program    = 0;
+    unsigned int                          shaders[3] = {0, 0, 0};
+    unsigned int                          types[3]   = {0, 0, 0};
+    bool                                  cacheHit   = false;
+    std::chrono::steady_clock::time_point start;
+};
+
+// 程序批量编译: 先提交全部程序，主线程继续做其他初始化，最后 Finish() 统一检查结果
+// 启用并行编译时驱动在后台线程编译，Finish() 只轮询完成状态而不阻塞
+class ProgramBatch {
+  public:
+    void Add(unsigned int* out, const char* vertexSrc, const char* fragmentSrc, const char* name);
+    void AddGeometry(unsigned int* out, const char* vertexSrc, const char* geometrySrc, const char* fragmentSrc,
+                     const char* name);
+    void AddCompute(unsigned int* out, const char* computeSrc, const char* name);
+
+    // 等待全部程序完成并写入 out (失败的程序为 0)，返回是否全部成功
+    // 等待期间周期性调用 pump (例如 glfwPollEvents)
+    bool Finish(const std::function<void()>& pump = {});
+
+  private:
+    std::vector<PendingProgram> pending;
+    std::vector<unsigned int*>  outputs;
+    double                      mainThreadMs = 0.0; // 提交和等待占用的主线程时间
+};
+
+// 创建着色器程序 (转发到实现)，name 仅用于日志
+inline unsigned int CreateProgram(const char* vertexSrc, const char* fragmentSrc, const char* name = "program") {
+    return CreateProgramImpl(vertexSrc, fragmentSrc, name);
+}
+
+// 创建计算着色器程序 (转发到实现)
+inline unsigned int CreateComputeProgram(const char* computeSrc, const char* name = "compute") {
+    return CreateComputeProgramImpl(computeSrc, name);
 }
 
 // 初始化 Uniform 缓存
 inline void InitUniformCache(UniformCache& uc, unsigned int pComp, unsigned int pSaturn, unsigned int pStar,
-                             unsigned int pPlanet, unsigned int pUI, unsigned int pBlur, unsigned int pQuad) {
+                             unsigned int pStarLayer, unsigned int pPlanet, unsigned int pPlanetCull,
+                             unsigned int pUI, unsigned int pBlur, unsigned int pBlurDown, unsigned int pBlurUp,
+                             unsigned int pEASU, unsigned int pAccum, unsigned int pCopy, unsigned int pSplatBin,
+                             unsigned int pSplatScan, unsigned int pSplatScatter, unsigned int pImpostor,
+                             unsigned int pQuad) {
     uc.comp_uDt            = glGetUniformLocation(pComp, "uDt");
     uc.comp_uHandScale     = glGetUniformLocation(pComp, "uHandScale");
     uc.comp_uHandHas       = glGetUniformLocation(pComp, "uHandHas");
@@ -78,38 +125,33 @@ inline void InitUniformCache(UniformCache& uc, unsigned int pComp, unsigned int
 
     uc.sat_proj          = glGetUniformLocation(pSaturn, "projection");
     uc.sat_view          = glGetUniformLocation(pSaturn, "view");
-    uc.sat_model         = glGetUniformLocation(pSaturn, "model");
     uc.sat_uTime         = glGetUniformLocation(pSaturn, "uTime");
-    uc.sat_uScale        = glGetUniformLocation(pSaturn, "uScale");
-    uc.sat_uPixelRatio   = glGetUniformLocation(pSaturn, "uPixelRatio");
     uc.sat_uDensityComp  = glGetUniformLocation(pSaturn, "uDensityComp");
     uc.sat_uScreenHeight = glGetUniformLocation(pSaturn, "uScreenHeight");
     uc.sat_uNoiseTexture = glGetUniformLocation(pSaturn, "uNoiseTexture");
+    uc.sat_uPointSizeMax = glGetUniformLocation(pSaturn, "uPointSizeMax");
+    uc.sat_uLargeDensity = glGetUniformLocation(pSaturn, "uLargeDensity");
 
     uc.star_proj  = glGetUniformLocation(pStar, "projection");
     uc.star_view  = glGetUniformLocation(pStar, "view");
     uc.star_model = glGetUniformLocation(pStar, "model");
-    uc.star_uTime = glGetUniformLocation(pStar, "uTime");
+
+    uc.starLayer_uTexture   = glGetUniformLocation(pStarLayer, "uTexture");
+    uc.starLayer_uReproject = glGetUniformLocation(pStarLayer, "uReproject");
+    uc.starLayer_uTime      = glGetUniformLocation(pStarLayer, "uTime");
 
     // 行星着色器 (实例化渲染)
-    uc.pl_p            = glGetUniformLocation(pPlanet, "p");
-    uc.pl_v            = glGetUniformLocation(pPlanet, "v");
-    uc.pl_ld           = glGetUniformLocation(pPlanet, "ld");
-    uc.pl_uFBMTex      = glGetUniformLocation(pPlanet, "uFBMTex");
-    uc.pl_uPlanetCount = glGetUniformLocation(pPlanet, "uPlanetCount");
-
-    // 创建行星 UBO (OpenGL 4.4: 使用 Persistent Mapped Buffer 消除 CPU-GPU 同步)
-    glGenBuffers(1, &uc.pl_ubo);
-    glBindBuffer(GL_UNIFORM_BUFFER, uc.pl_ubo);
-    // glBufferStorage 创建不可变存储，支持持久映射
-    GLbitfield storageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
-    glBufferStorage(GL_UNIFORM_BUFFER, 8 * sizeof(PlanetInstance), nullptr, storageFlags);
-    // 持久映射: 指针在程序生命周期内有效，无需 unmap
-    uc.pl_ubo_mapped =
-        (PlanetInstance*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, 8 * sizeof(PlanetInstance),
-                                          GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
-    // 绑定到 binding point 0
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, uc.pl_ubo);
+    uc.pl_p       = glGetUniformLocation(pPlanet, "p");
+    uc.pl_v       = glGetUniformLocation(pPlanet, "v");
+    uc.pl_ld      = glGetUniformLocation(pPlanet, "ld");
+    uc.pl_uFBMTex = glGetUniformLocation(pPlanet, "uFBMTex");
+
+    uc.plc_uView      = glGetUniformLocation(pPlanetCull, "uView");
+    uc.plc_uPlanes    = glGetUniformLocation(pPlanetCull, "uPlanes");
+    uc.plc_uProjScale = glGetUniformLocation(pPlanetCull, "uProjScale");
+    uc.plc_uLodPixels = glGetUniformLocation(pPlanetCull, "uLodPixels");
+    uc.plc_uCount     = glGetUniformLocation(pPlanetCull, "uCount");
+    uc.plc_uCapacity  = glGetUniformLocation(pPlanetCull, "uCapacity");
 
     uc.ui_proj       = glGetUniformLocation(pUI, "projection");
     uc.ui_uColor     = glGetUniformLocation(pUI, "uColor");
@@ -120,9 +162,50 @@ inline void InitUniformCache(UniformCache& uc, unsigned int pComp, unsigned int
     uc.blur_uTexelSize = glGetUniformLocation(pBlur, "uTexelSize");
     uc.blur_uOffset    = glGetUniformLocation(pBlur, "uOffset");
 
+    // 模糊金字塔
+    uc.blurDown_uOffset = glGetUniformLocation(pBlurDown, "uOffset");
+    uc.blurDown_uSrcMax = glGetUniformLocation(pBlurDown, "uSrcMax");
+    uc.blurUp_uOffset   = glGetUniformLocation(pBlurUp, "uOffset");
+
+    // 动态分辨率放大
+    uc.easu_uTexture = glGetUniformLocation(pEASU, "uTexture");
+    uc.easu_uScale   = glGetUniformLocation(pEASU, "uScale");
+    uc.easu_uSrcSize = glGetUniformLocation(pEASU, "uSrcSize");
+
+    // 粒子时间累积
+    uc.accum_uCurrent       = glGetUniformLocation(pAccum, "uCurrent");
+    uc.accum_uHistory       = glGetUniformLocation(pAccum, "uHistory");
+    uc.accum_uInvViewProj   = glGetUniformLocation(pAccum, "uInvViewProj");
+    uc.accum_uPrevViewProj  = glGetUniformLocation(pAccum, "uPrevViewProj");
+    uc.accum_uPrevScale     = glGetUniformLocation(pAccum, "uPrevScale");
+    uc.accum_uStep          = glGetUniformLocation(pAccum, "uStep");
+    uc.accum_uHistoryWeight = glGetUniformLocation(pAccum, "uHistoryWeight");
+    uc.accum_uHistoryScale  = glGetUniformLocation(pAccum, "uHistoryScale");
+    uc.copy_uTexture        = glGetUniformLocation(pCopy, "uTexture");
+
+    // 点溅射光栅化 (raster 着色器没有 uniform)
+    uc.splatBin_projection     = glGetUniformLocation(pSplatBin, "projection");
+    uc.splatBin_view           = glGetUniformLocation(pSplatBin, "view");
+    uc.splatBin_uTime          = glGetUniformLocation(pSplatBin, "uTime");
+    uc.splatBin_uDensityComp   = glGetUniformLocation(pSplatBin, "uDensityComp");
+    uc.splatBin_uViewport      = glGetUniformLocation(pSplatBin, "uViewport");
+    uc.splatBin_uParticleCount = glGetUniformLocation(pSplatBin, "uParticleCount");
+    uc.splatBin_uMaxSplatSize  = glGetUniformLocation(pSplatBin, "uMaxSplatSize");
+    uc.splatBin_uPointSizeMax  = glGetUniformLocation(pSplatBin, "uPointSizeMax");
+    uc.splatBin_uRefCapacity   = glGetUniformLocation(pSplatBin, "uRefCapacity");
+    uc.splatScan_uTileCount    = glGetUniformLocation(pSplatScan, "uTileCount");
+    uc.splatScatter_uViewport  = glGetUniformLocation(pSplatScatter, "uViewport");
+
+    // 土星远景替身
+    uc.imp_uViewProj    = glGetUniformLocation(pImpostor, "uViewProj");
+    uc.imp_uBoundRadius = glGetUniformLocation(pImpostor, "uBoundRadius");
+    uc.imp_uAtlas       = glGetUniformLocation(pImpostor, "uAtlas");
+
     // 全屏四边形着色器
     uc.quad_uTexture     = glGetUniformLocation(pQuad, "uTexture");
     uc.quad_uTransparent = glGetUniformLocation(pQuad, "uTransparent");
+    uc.quad_uSharpness   = glGetUniformLocation(pQuad, "uSharpness");
+    uc.quad_uUVScale     = glGetUniformLocation(pQuad, "uUVScale");
 }
 
 // 七段数码管数字定义（用于 FPS 显示）
@@ -236,12 +319,16 @@ inline void AddDigitGeometry(std::vector<float>& verts, float x, float y, float
     }
 }
 
-// 创建球体网格
-inline void CreateSphere(unsigned int& vao, unsigned int& indexCount, float radius) {
-    std::vector<float>        data;
+// 球体网格数据 (顶点: pos3 + normal3 + uv2)
+struct SphereMesh {
+    std::vector<float>        vertices;
     std::vector<unsigned int> indices;
-    int                       X = 64, Y = 64;
-    const float               PI = (float)M_PI;
+};
+
+// 生成球体网格数据 (纯 CPU，可在工作线程调用)
+inline SphereMesh BuildSphereMesh(float radius, int X = 64, int Y = 64) {
+    SphereMesh  mesh;
+    const float PI = (float)M_PI;
 
     for (int y = 0; y <= Y; y++) {
         for (int x = 0; x <= X; x++) {
@@ -249,121 +336,21 @@ inline void CreateSphere(unsigned int& vao, unsigned int& indexCount, float radi
             float xP = cos(xS * 2 * PI) * sin(yS * PI);
             float yP = cos(yS * PI);
             float zP = sin(xS * 2 * PI) * sin(yS * PI);
-            data.insert(data.end(), {xP * radius, yP * radius, zP * radius, xP, yP, zP, xS, yS});
+            mesh.vertices.insert(mesh.vertices.end(), {xP * radius, yP * radius, zP * radius, xP, yP, zP, xS, yS});
         }
     }
 
     for (int y = 0; y < Y; y++) {
         for (int x = 0; x < X; x++) {
-            indices.insert(indices.end(), {(unsigned)((y + 1) * (X + 1) + x), (unsigned)(y * (X + 1) + x),
-                                           (unsigned)(y * (X + 1) + x + 1), (unsigned)((y + 1) * (X + 1) + x),
-                                           (unsigned)(y * (X + 1) + x + 1), (unsigned)((y + 1) * (X + 1) + x + 1)});
+            mesh.indices.insert(mesh.indices.end(),
+                                {(unsigned)((y + 1) * (X + 1) + x), (unsigned)(y * (X + 1) + x),
+                                 (unsigned)(y * (X + 1) + x + 1), (unsigned)((y + 1) * (X + 1) + x),
+                                 (unsigned)(y * (X + 1) + x + 1), (unsigned)((y + 1) * (X + 1) + x + 1)});
         }
     }
-
-    indexCount = (unsigned int)indices.size();
-    unsigned int vbo, ebo;
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-    glGenBuffers(1, &ebo);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, data.size() * 4, data.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * 4, indices.data(), GL_STATIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, 0, 32, (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, 0, 32, (void*)12);
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, 0, 32, (void*)24);
+    return mesh;
 }
 
-// 优化: 缓存的球体网格 (避免重复创建)
-// 使用单位球体，通过 model matrix 缩放到所需大小
-struct CachedSphere {
-    GLuint       vao         = 0;
-    GLuint       vbo         = 0;
-    GLuint       ebo         = 0;
-    unsigned int indexCount  = 0;
-    bool         initialized = false;
-
-    void Init(int segments = 64) {
-        if (initialized) {
-            return;
-        }
-
-        std::vector<float>        data;
-        std::vector<unsigned int> indices;
-        const float               PI = (float)M_PI;
-
-        // 生成单位球体顶点
-        for (int y = 0; y <= segments; y++) {
-            for (int x = 0; x <= segments; x++) {
-                float xS = (float)x / segments;
-                float yS = (float)y / segments;
-                float xP = cos(xS * 2 * PI) * sin(yS * PI);
-                float yP = cos(yS * PI);
-                float zP = sin(xS * 2 * PI) * sin(yS * PI);
-                // pos(3) + normal(3) + uv(2) = 8 floats
-                data.insert(data.end(), {xP, yP, zP, xP, yP, zP, xS, yS});
-            }
-        }
-
-        // 生成索引
-        for (int y = 0; y < segments; y++) {
-            for (int x = 0; x < segments; x++) {
-                unsigned int tl = y * (segments + 1) + x;
-                unsigned int tr = tl + 1;
-                unsigned int bl = (y + 1) * (segments + 1) + x;
-                unsigned int br = bl + 1;
-                indices.insert(indices.end(), {bl, tl, tr, bl, tr, br});
-            }
-        }
-
-        indexCount = (unsigned int)indices.size();
-
-        glGenVertexArrays(1, &vao);
-        glGenBuffers(1, &vbo);
-        glGenBuffers(1, &ebo);
-
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-        // pos
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 32, (void*)0);
-        // normal
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 32, (void*)12);
-        // uv
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 32, (void*)24);
-
-        glBindVertexArray(0);
-        initialized = true;
-    }
-
-    void Draw() const {
-        if (!initialized) {
-            return;
-        }
-        glBindVertexArray(vao);
-        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
-    }
-
-    void DrawInstanced(int count) const {
-        if (!initialized) {
-            return;
-        }
-        glBindVertexArray(vao);
-        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, count);
-    }
-};
-
 // 生成噪声纹理
 inline unsigned int GenerateNoiseTexture(int width = 256, int height = 256) {
     std::vector<unsigned char>         data(width * height * 3);
@@ -385,9 +372,4 @@ inline unsigned int GenerateNoiseTexture(int width = 256, int height = 256) {
     return tex;
 }
 
-// 生成 FBM 噪声纹理 (用于行星表面) - 转发到实现
-inline unsigned int GenerateFBMTexture(int width = 512, int height = 512) {
-    return GenerateFBMTextureImpl(width, height);
-}
-
 } // namespace Renderer
@@ -0,0 +1,189 @@
+// SaturnImpostor.cpp - 土星远景替身实现
+
+#include "pch.h"
+
+#include "SaturnImpostor.h"
+#include "Renderer.h" // UniformCache
+
+#include <cmath>
+
+namespace SaturnImpostor {
+
+namespace {
+
+// 八面体映射 (y 轴为极轴)，与 FragmentImpostor 一致
+glm::vec2 SignNotZero(glm::vec2 v) {
+    return glm::vec2(v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f);
+}
+
+glm::vec2 OctEncode(glm::vec3 n) {
+    n /= fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+    glm::vec2 p(n.x, n.z);
+    if (n.y >= 0.0f) {
+        return p;
+    }
+    return (glm::vec2(1.0f) - glm::vec2(fabsf(p.y), fabsf(p.x))) * SignNotZero(p);
+}
+
+glm::vec3 OctDecode(glm::vec2 p) {
+    glm::vec3 n(p.x, 1.0f - fabsf(p.x) - fabsf(p.y), p.y);
+    if (n.y < 0.0f) {
+        glm::vec2 xz = (glm::vec2(1.0f) - glm::vec2(fabsf(n.z), fabsf(n.x))) * SignNotZero(glm::vec2(n.x, n.z));
+        n.x          = xz.x;
+        n.z          = xz.y;
+    }
+    return glm::normalize(n);
+}
+
+// 格子中心对应的捕获方向 (从土星中心指向相机)
+glm::vec3 CellDirection(int index) {
+    glm::vec2 cell((float)(index % kGrid), (float)(index / kGrid));
+    return OctDecode((cell + 0.5f) / (float)kGrid * 2.0f - 1.0f);
+}
+
+// 与 LatchedInput 块布局一致 (std140)
+struct Block {
+    glm::mat4 model;
+    float     scale;
+    float     pad[3];
+};
+
+} // namespace
+
+float ScreenDiameter(float scale, const glm::mat4& proj, int targetHeight) {
+    // proj[1][1] = 1 / tan(fov / 2)，NDC 的半高对应 targetHeight / 2 像素
+    return kBoundRadius * scale * proj[1][1] / kCameraDistance * (float)targetHeight;
+}
+
+void Atlas::Init() {
+    int size = kGrid * kCellSize;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_R11F_G11F_B10F, size, size);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+bool Atlas::UpdateMode(float screenDiameter, bool allowed) {
+    bool next = allowed && screenDiameter < kCellSize * (active ? kExitRatio : kEnterRatio);
+    if (next != active) {
+        if (next) {
+            for (Cell& c : cells) {
+                c.valid = false;
+            }
+        }
+        std::cout << "[SaturnImpostor] " << (next ? "Enabled" : "Disabled") << " at " << (int)screenDiameter
+                  << " px" << std::endl;
+    }
+    active = next;
+    return active;
+}
+
+int Atlas::PlanCaptures(const glm::mat4& model, const CaptureParams& capture) {
+    params       = capture;
+    pendingCount = 0;
+
+    // 视线方向附近的 4 格 (与 FragmentImpostor 的选取方式相同)
+    glm::vec3 viewDir = glm::normalize(glm::transpose(glm::mat3(model)) * glm::vec3(0, 0, 1));
+    glm::vec2 g       = (OctEncode(viewDir) * 0.5f + 0.5f) * (float)kGrid - 0.5f;
+    int       bx      = (int)floorf(g.x);
+    int       by      = (int)floorf(g.y);
+    int       x0      = std::clamp(bx, 0, kGrid - 1);
+    int       y0      = std::clamp(by, 0, kGrid - 1);
+    int       x1      = std::clamp(bx + 1, 0, kGrid - 1);
+    int       y1      = std::clamp(by + 1, 0, kGrid - 1);
+    int       used[4] = {y0 * kGrid + x0, y0 * kGrid + x1, y1 * kGrid + x0, y1 * kGrid + x1};
+
+    int oldest = -1;
+    for (int i = 0; i < 4; i++) {
+        int idx = used[i];
+        if (std::find(used, used + i, idx) != used + i) {
+            continue;
+        }
+        const Cell& c = cells[idx];
+        if (!c.valid || c.count != capture.count || fabsf(capture.scale / c.scale - 1.0f) > kRescaleLimit) {
+            pending[pendingCount++] = idx;
+        } else if (capture.now - c.time > kRefreshInterval && (oldest < 0 || c.time < cells[oldest].time)) {
+            oldest = idx;
+        }
+    }
+    // 时间预算: 没有失效的格子时每帧最多刷新一格
+    if (pendingCount == 0 && oldest >= 0) {
+        pending[pendingCount++] = oldest;
+    }
+    return pendingCount;
+}
+
+void Atlas::Capture(GLuint saturnProgram, const UniformCache& uc, GLuint particleVAO, GLuint indirectBuffer) {
+    // 捕获在土星模型空间进行 (模型矩阵为单位矩阵)，缩放与本帧一致
+    Block block = {glm::mat4(1.f), params.scale, {}};
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(block), &block);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, ubo);
+
+    // 正交相机与实际相机同距离 (粒子深度相关的点径和透明度一致)，点径按屏幕上的大小换算到格子像素
+    float     extent = kBoundRadius * params.scale;
+    glm::mat4 proj   = glm::ortho(-extent, extent, -extent, extent, kCameraDistance - extent - 1.0f,
+                                  kCameraDistance + extent + 1.0f);
+    float     height = params.targetHeight * (float)kCellSize / std::max(params.screenDiameter, 1.0f);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glEnable(GL_SCISSOR_TEST);
+    glClearColor(0, 0, 0, 1);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glUseProgram(saturnProgram);
+    glUniformMatrix4fv(uc.sat_proj, 1, 0, &proj[0][0]);
+    glUniform1f(uc.sat_uTime, params.time);
+    glUniform1f(uc.sat_uDensityComp, params.densityComp);
+    glUniform1f(uc.sat_uScreenHeight, height);
+    glUniform1f(uc.sat_uPointSizeMax, 300.0f);
+    glUniform1f(uc.sat_uLargeDensity, 1.0f);
+    glBindVertexArray(particleVAO);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    for (int i = 0; i < pendingCount; i++) {
+        int       idx  = pending[i];
+        glm::vec3 dir  = CellDirection(idx);
+        glm::vec3 up   = fabsf(dir.y) > 0.999f ? glm::vec3(0, 0, 1) : glm::vec3(0, 1, 0);
+        glm::mat4 view = glm::lookAt(dir * kCameraDistance, glm::vec3(0), up);
+        glUniformMatrix4fv(uc.sat_view, 1, 0, &view[0][0]);
+
+        int x = idx % kGrid * kCellSize, y = idx / kGrid * kCellSize;
+        glViewport(x, y, kCellSize, kCellSize);
+        glScissor(x, y, kCellSize, kCellSize);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDrawArraysIndirect(GL_POINTS, nullptr);
+
+        Cell& c = cells[idx];
+        c.valid = true;
+        c.scale = params.scale;
+        c.count = params.count;
+        c.time  = params.now;
+    }
+    glDisable(GL_SCISSOR_TEST);
+}
+
+void Atlas::Draw(GLuint program, const UniformCache& uc, GLuint vaoQuad, const glm::mat4& viewProj) const {
+    glBlendFunc(GL_ONE, GL_ONE);
+    glUseProgram(program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glUniform1i(uc.imp_uAtlas, 0);
+    glUniformMatrix4fv(uc.imp_uViewProj, 1, 0, &viewProj[0][0]);
+    glUniform1f(uc.imp_uBoundRadius, kBoundRadius);
+    glBindVertexArray(vaoQuad);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+}
+
+} // namespace SaturnImpostor
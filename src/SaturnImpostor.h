@@ -0,0 +1,75 @@
+#pragma once
+// 土星远景替身 - 土星在屏幕上较小时不再模拟和光栅化整团粒子，改为画一个面向相机的四边形
+// 粒子按 kGrid x kGrid 个视角 (八面体映射覆盖整个球面) 正交捕获到图集中，每个视角一格
+// 绘制时取视线方向附近的 4 格双线性混合；四边形上的点投影到各格的像平面得到纹理坐标，视角之间无需对齐
+// 只捕获当前用到的格子: 首次使用、粒子缩放或粒子数变化时立即捕获，之后按时间预算逐格刷新 (粒子模拟随捕获推进)
+// 屏幕直径超过阈值时切回完整粒子 (滞后区间避免来回切换)
+
+#include <cstdint>
+
+struct UniformCache;
+
+namespace SaturnImpostor {
+
+static constexpr int    kGrid            = 8;      // 图集每边的视角数 (相邻视角约 25 度)
+static constexpr int    kCellSize        = 384;    // 每格像素，图集 3072 x 3072 (R11F_G11F_B10F，36 MB)
+static constexpr float  kBoundRadius     = 44.0f;  // 粒子包围球半径 (模型空间，未乘缩放，外环约 42.1)
+static constexpr float  kCameraDistance  = 100.0f; // 相机到土星中心的距离 (与主循环的 view 矩阵一致)
+static constexpr float  kEnterRatio      = 1.1f;   // 屏幕直径 < 格子尺寸 * 该值时切换到替身
+static constexpr float  kExitRatio       = 1.25f;  // 屏幕直径 > 格子尺寸 * 该值时切回完整粒子
+static constexpr double kRefreshInterval = 0.25;   // 秒: 视角附近的格子超过该时间后重新捕获 (每帧最多一格)
+static constexpr float  kRescaleLimit    = 0.1f;   // 粒子缩放相对捕获时变化超过该值时立即重新捕获
+
+// 包围球在渲染目标上的直径 (像素)
+float ScreenDiameter(float scale, const glm::mat4& proj, int targetHeight);
+
+// 捕获时的粒子状态 (与 VertexSaturn 的 uniform 一致)
+struct CaptureParams {
+    float    scale          = 1.0f;
+    float    targetHeight   = 1080.0f; // 渲染目标高度 (像素)
+    float    screenDiameter = 1.0f;    // 点径按屏幕上的实际大小换算到格子像素
+    float    time           = 0.0f;
+    float    densityComp    = 1.0f;
+    uint32_t count          = 0; // 活跃粒子数
+    double   now            = 0.0;
+};
+
+class Atlas {
+  public:
+    // 创建图集纹理、FBO 和捕获用的 LatchedInput 缓冲 (GL 线程)
+    void Init();
+
+    // 按屏幕直径更新模式，返回本帧是否使用替身；切换到替身时所有格子失效
+    bool UpdateMode(float screenDiameter, bool allowed);
+    bool IsActive() const { return active; }
+
+    // 选出本帧需要捕获的格子，返回数量 (0 表示不需要推进粒子模拟)
+    // model 为土星模型矩阵 (视线方向取其逆变换后的相机方向)
+    int PlanCaptures(const glm::mat4& model, const CaptureParams& params);
+
+    // 捕获计划中的格子: 每格以正交相机绘制全部活跃粒子 (点精灵路径)
+    // 会改写 uniform 绑定点 0 (LatchedInput)，调用方之后需要重新绑定本帧的锁存缓冲
+    void Capture(GLuint saturnProgram, const UniformCache& uc, GLuint particleVAO, GLuint indirectBuffer);
+
+    // 加法混合画出替身四边形 (模型矩阵和缩放取自已绑定的 LatchedInput 块)
+    void Draw(GLuint program, const UniformCache& uc, GLuint vaoQuad, const glm::mat4& viewProj) const;
+
+    GLuint GetTexture() const { return texture; }
+
+  private:
+    struct Cell {
+        bool     valid = false;
+        float    scale = 1.0f;
+        uint32_t count = 0;
+        double   time  = 0.0;
+    };
+
+    GLuint        texture = 0, fbo = 0, ubo = 0;
+    bool          active  = false;
+    Cell          cells[kGrid * kGrid];
+    int           pending[4]   = {};
+    int           pendingCount = 0;
+    CaptureParams params;
+};
+
+} // namespace SaturnImpostor
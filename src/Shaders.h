@@ -203,8 +203,12 @@ layout (location = 0) in vec4 aPos;
 layout (location = 1) in uint aColor;  // RGBA8 打包颜色
 layout (location = 2) in float aSpeed;
 layout (location = 3) in float aIsRing;
-uniform mat4 view; uniform mat4 projection; uniform mat4 model;
-uniform float uTime; uniform float uScale; uniform float uPixelRatio; uniform float uScreenHeight;
+uniform mat4 view; uniform mat4 projection;
+uniform float uTime; uniform float uScreenHeight;
+uniform float uPointSizeMax;  // 点径上限 (1080p 像素)，FillBudget 按实测填充开销调整
+uniform float uLargeDensity;  // 接近上限的大粒子的保留比例 (1 = 不稀疏)
+// 土星姿态 (FramePacer::InputLatch 持久映射，提交前可能被最新的手部样本覆盖)
+layout(std140, binding = 0) uniform LatchedInput { mat4 model; float uScale; };
 out vec3 vColor; out float vDist; out float vOpacity; out float vScaleFactor; out float vIsRing;
 
 // RGBA8 解包: 将 uint 解包为 vec4 颜色
@@ -270,13 +274,21 @@ void main() {
 
     float invDist = 1.0 / max(dist, 0.1);
     float basePointSize = aPos.w * 350.0 * invDist * 0.55;
-    float screenScale = uScreenHeight / 1080.0;
+    float screenScale = uScreenHeight / 1080.0;  // 渲染目标高度 (动态分辨率下小于窗口)
     float pointSize = basePointSize * screenScale;
     float ringFactor = mix(mix(1.0, 0.8, step(dist, 50.0)), 1.0, aIsRing);
-    pointSize *= ringFactor * pow(uPixelRatio, 0.8);
-    gl_PointSize = clamp(pointSize, 0.0, 300.0 * screenScale);
+    pointSize *= ringFactor;
+    float sizeMax = uPointSizeMax * screenScale;
+    gl_PointSize = clamp(pointSize, 0.0, sizeMax);
+
+    // 填充预算: 点径超过上限一半的粒子按序号哈希稀疏 (每帧选中的粒子不变)，保留的粒子提高不透明度补偿总亮度
+    float keep = mix(1.0, uLargeDensity, smoothstep(0.5 * sizeMax, sizeMax, pointSize));
+    if (hash(float(gl_VertexID) + 0.5) > keep) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);  // 裁剪掉
+        gl_PointSize = 0.0;
+    }
 
-    vColor = col.rgb; vOpacity = col.a; vScaleFactor = uScale; vIsRing = aIsRing;
+    vColor = col.rgb; vOpacity = col.a / keep; vScaleFactor = uScale; vIsRing = aIsRing;
 }
 )";
 
@@ -310,6 +322,390 @@ void main() {
 }
 )";
 
+// 顶点着色器 - 土星粒子四边形 (实例化，顶点拉取)
+// 每个实例一个粒子、4 个顶点的三角形带；按 gl_InstanceID 从 SSBO 读取粒子，变换和点径与 VertexSaturn 相同
+// 中心在裁剪体外或被填充预算稀疏掉的粒子移到裁剪体外 (与点精灵一致)；边长至少 1 像素 (固定管线的最小点径)
+const char* const VertexSaturnQuad = R"(
+#version 430 core
+struct ParticleData { vec4 pos; uint color; float speed; float isRing; float pad; };
+layout(std430, binding = 0) readonly buffer ParticleBuffer { ParticleData particles[]; };
+uniform mat4 view; uniform mat4 projection;
+uniform float uTime; uniform float uScreenHeight;
+uniform float uPointSizeMax;
+uniform float uLargeDensity;
+uniform vec2 uViewport;  // 渲染目标尺寸 (像素)，点径换算为裁剪空间偏移
+layout(std140, binding = 0) uniform LatchedInput { mat4 model; float uScale; };
+out SaturnQuad { vec3 color; float dist; float opacity; float scaleFactor; float isRing; vec2 pointCoord; } vs_out;
+
+vec4 unpackRGBA8(uint c) {
+    return vec4(
+        float(c & 0xFFu) / 255.0,
+        float((c >> 8u) & 0xFFu) / 255.0,
+        float((c >> 16u) & 0xFFu) / 255.0,
+        float((c >> 24u) & 0xFFu) / 255.0
+    );
+}
+
+float hash(float n) {
+    uint x = floatBitsToUint(n);
+    x = ((x >> 16u) ^ x) * 0x45d9f3bu;
+    x = ((x >> 16u) ^ x) * 0x45d9f3bu;
+    x = (x >> 16u) ^ x;
+    return float(x) * (1.0 / 4294967296.0);
+}
+
+float fastSin(float x) {
+    x = mod(x, 6.28318530718);
+    x = x > 3.14159265359 ? x - 6.28318530718 : x;
+    float x2 = x * x;
+    return x * (1.0 - x2 * (0.16666667 - x2 * (0.00833333 - x2 * 0.0001984)));
+}
+
+void main() {
+    uint id = uint(gl_InstanceID);
+    vec4 aPos = particles[id].pos;
+    float aIsRing = particles[id].isRing;
+    vec4 col = unpackRGBA8(particles[id].color);
+
+    vec4 mvPosition = view * (model * vec4(aPos.xyz * uScale, 1.0));
+    float dist = -mvPosition.z;
+
+    float chaosIntensity = smoothstep(25.0, 0.1, dist);
+    chaosIntensity = chaosIntensity * chaosIntensity * chaosIntensity;
+    if (chaosIntensity > 0.001) {
+        float highFreqTime = uTime * 40.0;
+        vec3 posScaled = aPos.xyz * 10.0;
+        vec3 noiseVec = vec3(
+            fastSin(highFreqTime + posScaled.x) * hash(aPos.y * 43758.5) * 0.5,
+            fastSin(highFreqTime + posScaled.y + 1.5708) * hash(aPos.x * 43758.5) * 0.5,
+            fastSin(highFreqTime * 0.5) * hash(aPos.z * 43758.5) * 0.5
+        ) * 3.0;
+        mvPosition.xyz += noiseVec * chaosIntensity;
+    }
+    vec4 clip = projection * mvPosition;
+
+    float screenScale = uScreenHeight / 1080.0;
+    float pointSize = aPos.w * 350.0 / max(dist, 0.1) * 0.55 * screenScale;
+    pointSize *= mix(mix(1.0, 0.8, step(dist, 50.0)), 1.0, aIsRing);
+    float sizeMax = uPointSizeMax * screenScale;
+    float keep = mix(1.0, uLargeDensity, smoothstep(0.5 * sizeMax, sizeMax, pointSize));
+
+    // 三角形带的角点顺序: (-1,-1) (1,-1) (-1,1) (1,1)
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)) * 2.0 - 1.0;
+    if (hash(float(id) + 0.5) > keep || any(greaterThan(abs(clip.xyz), vec3(clip.w)))) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);  // 裁剪掉
+    } else {
+        float size = max(clamp(pointSize, 0.0, sizeMax), 1.0);
+        gl_Position = vec4(clip.xy + corner * size / uViewport * clip.w, clip.zw);
+    }
+
+    vs_out.color = col.rgb; vs_out.dist = dist; vs_out.opacity = col.a / keep;
+    vs_out.scaleFactor = uScale; vs_out.isRing = aIsRing; vs_out.pointCoord = corner * 0.5 + 0.5;
+}
+)";
+
+// 几何着色器 - 土星粒子四边形 (顶点着色器沿用 VertexSaturn，把每个点扩展成与点精灵同样大小的四边形)
+// VertexSaturn 移到裁剪体外的粒子 (稀疏) 和中心在裁剪体外的点不输出
+const char* const GeometrySaturnQuad = R"(
+#version 430 core
+layout (points) in;
+layout (triangle_strip, max_vertices = 4) out;
+uniform vec2 uViewport;
+in vec3 vColor[]; in float vDist[]; in float vOpacity[]; in float vScaleFactor[]; in float vIsRing[];
+out SaturnQuad { vec3 color; float dist; float opacity; float scaleFactor; float isRing; vec2 pointCoord; } gs_out;
+
+void main() {
+    vec4 clip = gl_in[0].gl_Position;
+    if (any(greaterThan(abs(clip.xyz), vec3(clip.w)))) return;
+    vec2 halfSize = vec2(max(gl_in[0].gl_PointSize, 1.0)) / uViewport * clip.w;
+    for (int i = 0; i < 4; i++) {
+        vec2 corner = vec2(float(i & 1), float(i >> 1)) * 2.0 - 1.0;
+        gl_Position = vec4(clip.xy + corner * halfSize, clip.zw);
+        gs_out.color = vColor[0]; gs_out.dist = vDist[0]; gs_out.opacity = vOpacity[0];
+        gs_out.scaleFactor = vScaleFactor[0]; gs_out.isRing = vIsRing[0]; gs_out.pointCoord = corner * 0.5 + 0.5;
+        EmitVertex();
+    }
+    EndPrimitive();
+}
+)";
+
+// 片段着色器 - 土星粒子四边形 (与 FragmentSaturn 相同，gl_PointCoord 换成插值的 pointCoord)
+const char* const FragmentSaturnQuad = R"(
+#version 430 core
+out vec4 FragColor;
+in SaturnQuad { vec3 color; float dist; float opacity; float scaleFactor; float isRing; vec2 pointCoord; } fs_in;
+uniform float uDensityComp;
+
+void main() {
+    vec2 cxy = 2.0 * fs_in.pointCoord - 1.0;
+    float distSq = dot(cxy, cxy);
+    if (distSq > 1.0) discard;
+
+    float glow = smoothstep(1.0, 0.4, distSq);
+    float t = clamp((fs_in.scaleFactor - 0.15) * 0.4255, 0.0, 1.0);
+    float tSmooth = smoothstep(0.1, 0.9, t);
+
+    vec3 baseColor = mix(vec3(0.35, 0.22, 0.05), fs_in.color, tSmooth);
+    vec3 finalColor = baseColor * (0.2 + t);
+
+    float closeMix = smoothstep(40.0, 0.0, fs_in.dist);
+    vec3 closeRingColor = finalColor + vec3(0.15, 0.12, 0.1) * closeMix;
+    vec3 closeBodyColor = mix(finalColor, pow(fs_in.color, vec3(1.4)) * 1.5, closeMix * 0.8);
+    finalColor = mix(closeBodyColor, closeRingColor, fs_in.isRing);
+
+    float depthAlpha = smoothstep(0.0, 10.0, fs_in.dist);
+    float finalAlpha = glow * fs_in.opacity * (0.25 + 0.45 * smoothstep(0.0, 0.5, t)) * depthAlpha * uDensityComp;
+    FragColor = vec4(finalColor, finalAlpha);
+}
+)";
+
+// 点溅射 bin (计算着色器): 与 VertexSaturn 相同的变换和点径，加上 FragmentSaturn 中逐粒子不变的着色
+// 中心在裁剪体外的点整个丢弃 (与固定管线的点裁剪一致)；点径超过 uMaxSplatSize 的粒子写入大粒子列表
+// 小粒子的预乘颜色 (rgb * alpha) 和点径按 half 打包，逐像素只剩 glow 衰减
+const char* const ComputeSplatBin = R"(
+#version 430 core
+layout (local_size_x = 256) in;
+struct ParticleData { vec4 pos; uint color; float speed; float isRing; float pad; };
+struct Splat { vec2 center; uint rg; uint bSize; };
+layout(std430, binding = 0) readonly buffer ParticleBuffer { ParticleData particles[]; };
+layout(std430, binding = 1) writeonly buffer Splats { Splat splats[]; };
+layout(std430, binding = 2) buffer TileCounts { uint tileCount[]; };
+layout(std430, binding = 4) buffer SplatCounters {
+    uint largeCount; uint largeInstances; uint largeFirst; int largeBaseVertex; uint largeBaseInstance;
+    uint dispatchX; uint dispatchY; uint dispatchZ;
+    uint splatCount; uint refCount;
+};
+layout(std430, binding = 6) writeonly buffer LargeList { uint largeIndices[]; };
+uniform mat4 view; uniform mat4 projection;
+uniform float uTime; uniform float uDensityComp;
+layout(std140, binding = 0) uniform LatchedInput { mat4 model; float uScale; };
+uniform vec2 uViewport;     // 渲染目标尺寸 (像素)
+uniform uint uParticleCount;
+uniform float uMaxSplatSize;
+uniform float uPointSizeMax;  // 与 VertexSaturn 相同的点径上限 (1080p 像素)
+uniform uint uRefCapacity;
+
+vec4 unpackRGBA8(uint c) {
+    return vec4(
+        float(c & 0xFFu) / 255.0,
+        float((c >> 8u) & 0xFFu) / 255.0,
+        float((c >> 16u) & 0xFFu) / 255.0,
+        float((c >> 24u) & 0xFFu) / 255.0
+    );
+}
+
+float hash(float n) {
+    uint x = floatBitsToUint(n);
+    x = ((x >> 16u) ^ x) * 0x45d9f3bu;
+    x = ((x >> 16u) ^ x) * 0x45d9f3bu;
+    x = (x >> 16u) ^ x;
+    return float(x) * (1.0 / 4294967296.0);
+}
+
+float fastSin(float x) {
+    x = mod(x, 6.28318530718);
+    x = x > 3.14159265359 ? x - 6.28318530718 : x;
+    float x2 = x * x;
+    return x * (1.0 - x2 * (0.16666667 - x2 * (0.00833333 - x2 * 0.0001984)));
+}
+
+void main() {
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= uParticleCount) return;
+
+    vec4 aPos = particles[id].pos;
+    float isRing = particles[id].isRing;
+    vec4 mvPosition = view * (model * vec4(aPos.xyz * uScale, 1.0));
+    float dist = -mvPosition.z;
+
+    float chaosIntensity = smoothstep(25.0, 0.1, dist);
+    chaosIntensity = chaosIntensity * chaosIntensity * chaosIntensity;
+    if (chaosIntensity > 0.001) {
+        float highFreqTime = uTime * 40.0;
+        vec3 posScaled = aPos.xyz * 10.0;
+        vec3 noiseVec = vec3(
+            fastSin(highFreqTime + posScaled.x) * hash(aPos.y * 43758.5) * 0.5,
+            fastSin(highFreqTime + posScaled.y + 1.5708) * hash(aPos.x * 43758.5) * 0.5,
+            fastSin(highFreqTime * 0.5) * hash(aPos.z * 43758.5) * 0.5
+        ) * 3.0;
+        mvPosition.xyz += noiseVec * chaosIntensity;
+    }
+
+    vec4 clip = projection * mvPosition;
+    if (any(greaterThan(abs(clip.xyz), vec3(clip.w)))) return;
+
+    float screenScale = uViewport.y / 1080.0;
+    float pointSize = aPos.w * 350.0 / max(dist, 0.1) * 0.55 * screenScale;
+    pointSize *= mix(mix(1.0, 0.8, step(dist, 50.0)), 1.0, isRing);
+    pointSize = clamp(pointSize, 0.0, uPointSizeMax * screenScale);
+    if (pointSize > uMaxSplatSize) {
+        largeIndices[atomicAdd(largeCount, 1u)] = id;
+        return;
+    }
+
+    // 覆盖的像素 (中心落在点的方框内) 和分块范围
+    float size = max(pointSize, 1.0);
+    vec2 center = (clip.xy / clip.w * 0.5 + 0.5) * uViewport;
+    ivec2 pixelMax = ivec2(uViewport) - 1;
+    ivec2 tileLo = clamp(ivec2(floor(center - size * 0.5)), ivec2(0), pixelMax) / 16;
+    ivec2 tileHi = clamp(ivec2(floor(center + size * 0.5)), ivec2(0), pixelMax) / 16;
+    uint refs = uint((tileHi.x - tileLo.x + 1) * (tileHi.y - tileLo.y + 1));
+    if (atomicAdd(refCount, refs) + refs > uRefCapacity) {
+        largeIndices[atomicAdd(largeCount, 1u)] = id;
+        return;
+    }
+
+    vec4 col = unpackRGBA8(particles[id].color);
+    float t = clamp((uScale - 0.15) * 0.4255, 0.0, 1.0);
+    vec3 baseColor = mix(vec3(0.35, 0.22, 0.05), col.rgb, smoothstep(0.1, 0.9, t));
+    vec3 finalColor = baseColor * (0.2 + t);
+    float closeMix = smoothstep(40.0, 0.0, dist);
+    vec3 closeRingColor = finalColor + vec3(0.15, 0.12, 0.1) * closeMix;
+    vec3 closeBodyColor = mix(finalColor, pow(col.rgb, vec3(1.4)) * 1.5, closeMix * 0.8);
+    finalColor = mix(closeBodyColor, closeRingColor, isRing);
+    float alpha = col.a * (0.25 + 0.45 * smoothstep(0.0, 0.5, t)) * smoothstep(0.0, 10.0, dist) * uDensityComp;
+    vec3 premul = finalColor * alpha;
+
+    uint slot = atomicAdd(splatCount, 1u);
+    splats[slot] = Splat(center, packHalf2x16(premul.rg), packHalf2x16(vec2(premul.b, size)));
+    uint tilesX = (uint(uViewport.x) + 15u) / 16u;
+    for (int y = tileLo.y; y <= tileHi.y; y++) {
+        for (int x = tileLo.x; x <= tileHi.x; x++) {
+            atomicAdd(tileCount[uint(y) * tilesX + uint(x)], 1u);
+        }
+    }
+}
+)";
+
+// 点溅射 scan (计算着色器): 单个工作组对分块计数做前缀和，顺便写出 scatter 的间接调度参数
+// 每个线程先串行累加连续的一段分块，再在共享内存里做 Hillis-Steele 扫描
+const char* const ComputeSplatScan = R"(
+#version 430 core
+layout (local_size_x = 1024) in;
+layout(std430, binding = 2) readonly buffer TileCounts { uint tileCount[]; };
+layout(std430, binding = 3) writeonly buffer TileEnds { uint tileEnd[]; };
+layout(std430, binding = 4) buffer SplatCounters {
+    uint largeCount; uint largeInstances; uint largeFirst; int largeBaseVertex; uint largeBaseInstance;
+    uint dispatchX; uint dispatchY; uint dispatchZ;
+    uint splatCount; uint refCount;
+};
+uniform uint uTileCount;
+shared uint sSum[1024];
+
+void main() {
+    uint t = gl_LocalInvocationID.x;
+    uint chunk = (uTileCount + 1023u) / 1024u;
+    uint begin = min(t * chunk, uTileCount);
+    uint end = min(begin + chunk, uTileCount);
+    uint sum = 0u;
+    for (uint i = begin; i < end; i++) sum += tileCount[i];
+    sSum[t] = sum;
+    barrier();
+    for (uint offset = 1u; offset < 1024u; offset <<= 1u) {
+        uint v = t >= offset ? sSum[t - offset] : 0u;
+        barrier();
+        sSum[t] += v;
+        barrier();
+    }
+    uint start = sSum[t] - sum;
+    for (uint i = begin; i < end; i++) {
+        tileEnd[i] = start;
+        start += tileCount[i];
+    }
+    if (t == 0u) {
+        dispatchX = (splatCount + 255u) / 256u;
+        dispatchY = 1u;
+        dispatchZ = 1u;
+    }
+}
+)";
+
+// 点溅射 scatter (计算着色器，间接调度): 把每条溅射记录的序号填入它覆盖的各分块的列表
+// 填完后 tileEnd 为各分块列表的终点 (起点 = 终点 - 计数)
+const char* const ComputeSplatScatter = R"(
+#version 430 core
+layout (local_size_x = 256) in;
+struct Splat { vec2 center; uint rg; uint bSize; };
+layout(std430, binding = 1) readonly buffer Splats { Splat splats[]; };
+layout(std430, binding = 3) buffer TileEnds { uint tileEnd[]; };
+layout(std430, binding = 4) readonly buffer SplatCounters {
+    uint largeCount; uint largeInstances; uint largeFirst; int largeBaseVertex; uint largeBaseInstance;
+    uint dispatchX; uint dispatchY; uint dispatchZ;
+    uint splatCount; uint refCount;
+};
+layout(std430, binding = 5) writeonly buffer TileRefs { uint refs[]; };
+uniform vec2 uViewport;
+
+void main() {
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= splatCount) return;
+    Splat s = splats[i];
+    float size = unpackHalf2x16(s.bSize).y;
+    ivec2 pixelMax = ivec2(uViewport) - 1;
+    ivec2 tileLo = clamp(ivec2(floor(s.center - size * 0.5)), ivec2(0), pixelMax) / 16;
+    ivec2 tileHi = clamp(ivec2(floor(s.center + size * 0.5)), ivec2(0), pixelMax) / 16;
+    uint tilesX = (uint(uViewport.x) + 15u) / 16u;
+    for (int y = tileLo.y; y <= tileHi.y; y++) {
+        for (int x = tileLo.x; x <= tileHi.x; x++) {
+            refs[atomicAdd(tileEnd[uint(y) * tilesX + uint(x)], 1u)] = i;
+        }
+    }
+}
+)";
+
+// 点溅射 raster (计算着色器): 每个工作组一个 16x16 分块，线程分摊分块列表中的溅射记录
+// glow 与 FragmentSaturn 相同；共享内存中用定点数原子累加 (加法与顺序无关，结果确定)
+// 每个像素都会被写入 (没有粒子的写 0)，结果图像不需要清屏
+const char* const ComputeSplatRaster = R"(
+#version 430 core
+layout (local_size_x = 16, local_size_y = 16) in;
+struct Splat { vec2 center; uint rg; uint bSize; };
+layout(std430, binding = 1) readonly buffer Splats { Splat splats[]; };
+layout(std430, binding = 2) readonly buffer TileCounts { uint tileCount[]; };
+layout(std430, binding = 3) readonly buffer TileEnds { uint tileEnd[]; };
+layout(std430, binding = 5) readonly buffer TileRefs { uint refs[]; };
+layout(r11f_g11f_b10f, binding = 0) uniform writeonly image2D uTarget;
+const float FIXED_SCALE = 16384.0;  // 单像素累加到 2^18 才会溢出
+shared uint sR[256];
+shared uint sG[256];
+shared uint sB[256];
+
+void main() {
+    uint li = gl_LocalInvocationIndex;
+    sR[li] = 0u; sG[li] = 0u; sB[li] = 0u;
+    barrier();
+
+    uint tile = gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x;
+    uint end = tileEnd[tile];
+    ivec2 origin = ivec2(gl_WorkGroupID.xy) * 16;
+    for (uint k = end - tileCount[tile] + li; k < end; k += 256u) {
+        Splat s = splats[refs[k]];
+        vec2 bs = unpackHalf2x16(s.bSize);
+        vec3 color = vec3(unpackHalf2x16(s.rg), bs.x) * FIXED_SCALE;
+        float radius = bs.y * 0.5;
+        ivec2 lo = max(ivec2(floor(s.center - radius)) - origin, ivec2(0));
+        ivec2 hi = min(ivec2(floor(s.center + radius)) - origin, ivec2(15));
+        for (int y = lo.y; y <= hi.y; y++) {
+            for (int x = lo.x; x <= hi.x; x++) {
+                vec2 cxy = (vec2(origin + ivec2(x, y)) + 0.5 - s.center) / radius;
+                float distSq = dot(cxy, cxy);
+                if (distSq > 1.0) continue;
+                uvec3 v = uvec3(color * smoothstep(1.0, 0.4, distSq) + 0.5);
+                uint p = uint(y * 16 + x);
+                atomicAdd(sR[p], v.r);
+                atomicAdd(sG[p], v.g);
+                atomicAdd(sB[p], v.b);
+            }
+        }
+    }
+    barrier();
+
+    ivec2 pixel = origin + ivec2(gl_LocalInvocationID.xy);
+    if (any(greaterThanEqual(pixel, imageSize(uTarget)))) return;
+    imageStore(uTarget, pixel, vec4(vec3(sR[li], sG[li], sB[li]) / FIXED_SCALE, 1.0));
+}
+)";
+
 // UI 着色器 (支持预生成数字的变换)
 const char* const VertexUI = R"(
 #version 430 core
@@ -329,6 +725,67 @@ uniform vec3 uColor;
 void main() { FragColor = vec4(uColor, 1.0); }
 )";
 
+// 土星远景替身 (SaturnImpostor): 面向相机的四边形覆盖包围球，vLocal 为模型空间坐标 / (包围半径 * 缩放)
+// 相机在 +z 方向看向原点，四边形位于 z = 0 平面
+const char* const VertexImpostor = R"(
+#version 430 core
+layout(location=0) in vec2 aPos;
+uniform mat4 uViewProj;
+uniform float uBoundRadius;
+layout(std140, binding = 0) uniform LatchedInput { mat4 model; float uScale; };
+out vec3 vLocal;
+void main() {
+    vLocal = transpose(mat3(model)) * vec3(aPos, 0.0);
+    gl_Position = uViewProj * vec4(aPos * uBoundRadius * uScale, 0.0, 1.0);
+}
+)";
+
+// 视线方向附近的 4 个捕获视角双线性混合；每个视角是沿格子中心方向的正交投影 (与 Atlas::Capture 的 lookAt 一致)
+const char* const FragmentImpostor = R"(
+#version 430 core
+out vec4 FragColor;
+in vec3 vLocal;
+uniform sampler2D uAtlas;
+layout(std140, binding = 0) uniform LatchedInput { mat4 model; float uScale; };
+const int GRID = 8;  // SaturnImpostor::kGrid
+
+vec2 signNotZero(vec2 v) { return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0); }
+
+// 八面体映射 (y 轴为极轴)
+vec2 octEncode(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    return n.y >= 0.0 ? n.xz : (1.0 - abs(n.zx)) * signNotZero(n.xz);
+}
+
+vec3 octDecode(vec2 p) {
+    vec3 n = vec3(p.x, 1.0 - abs(p.x) - abs(p.y), p.y);
+    if (n.y < 0.0) n.xz = (1.0 - abs(n.zx)) * signNotZero(n.xz);
+    return normalize(n);
+}
+
+vec3 sampleCell(ivec2 cell) {
+    vec3 dir = octDecode((vec2(cell) + 0.5) / float(GRID) * 2.0 - 1.0);
+    vec3 up = abs(dir.y) > 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    vec3 right = normalize(cross(-dir, up));
+    vec3 camUp = cross(right, -dir);
+    vec2 uv = vec2(dot(vLocal, right), dot(vLocal, camUp)) * 0.5 + 0.5;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) return vec3(0.0);
+    return textureLod(uAtlas, (vec2(cell) + uv) / float(GRID), 0.0).rgb;
+}
+
+void main() {
+    vec3 viewDir = normalize(transpose(mat3(model)) * vec3(0.0, 0.0, 1.0));
+    vec2 g = (octEncode(viewDir) * 0.5 + 0.5) * float(GRID) - 0.5;
+    ivec2 base = ivec2(floor(g));
+    vec2 f = g - vec2(base);
+    ivec2 lo = clamp(base, ivec2(0), ivec2(GRID - 1));
+    ivec2 hi = clamp(base + 1, ivec2(0), ivec2(GRID - 1));
+    vec3 bottom = mix(sampleCell(lo), sampleCell(ivec2(hi.x, lo.y)), f.x);
+    vec3 top = mix(sampleCell(ivec2(lo.x, hi.y)), sampleCell(hi), f.x);
+    FragColor = vec4(mix(bottom, top, f.y), 1.0);
+}
+)";
+
 // 全屏四边形着色器
 const char* const VertexQuad = R"(
 #version 430 core
@@ -337,24 +794,240 @@ out vec2 vUV;
 void main(){ vUV = aPos * 0.5 + 0.5; gl_Position = vec4(aPos, 0.0, 1.0); }
 )";
 
+// 动态分辨率放大 (FSR1 EASU 风格): 每个输出像素取周围 12 个源纹素，由亮度梯度估计局部边缘方向和强度
+// 沿边缘拉伸、垂直边缘收窄的近似 Lanczos 核加权，结果夹在最近 2x2 纹素的范围内 (去振铃)
+const char* const FragmentEASU = R"(
+#version 430 core
+out vec4 FragColor;
+uniform sampler2D uTexture;
+uniform vec2 uScale;    // 源尺寸 / 输出尺寸
+uniform ivec2 uSrcSize; // 源图像的逻辑尺寸 (池纹理可能更大，之外的纹素不可读)
+ivec2 srcMax;
+
+vec3 fetch(ivec2 p) { return texelFetch(uTexture, clamp(p, ivec2(0), srcMax), 0).rgb; }
+float luma(vec3 c) { return c.b * 0.5 + (c.r * 0.5 + c.g); }
+
+// 双线性四个角之一: 由十字形 5 个纹素 (A 上 B 左 C 中 D 右 E 下) 累加方向和边缘强度
+void edge(inout vec2 dir, inout float len, float w, float lA, float lB, float lC, float lD, float lE) {
+    float dirX = lD - lB;
+    float lenX = clamp(abs(dirX) / max(max(abs(lD - lC), abs(lC - lB)), 1e-5), 0.0, 1.0);
+    dir.x += dirX * w;
+    len += lenX * lenX * w;
+    float dirY = lE - lA;
+    float lenY = clamp(abs(dirY) / max(max(abs(lE - lC), abs(lC - lA)), 1e-5), 0.0, 1.0);
+    dir.y += dirY * w;
+    len += lenY * lenY * w;
+}
+
+void tap(inout vec3 aC, inout float aW, vec2 off, vec2 dir, vec2 len2, float lob, float clp, vec3 c) {
+    vec2 v = vec2(dot(off, dir), dot(off, vec2(-dir.y, dir.x))) * len2;
+    float d2 = min(dot(v, v), clp);
+    float wB = 0.4 * d2 - 1.0;
+    float wA = lob * d2 - 1.0;
+    wB *= wB; wA *= wA;
+    float w = (1.5625 * wB - 0.5625) * wA;
+    aC += c * w; aW += w;
+}
+
+void main() {
+    srcMax = uSrcSize - 1;
+    vec2 pp = gl_FragCoord.xy * uScale - 0.5;
+    vec2 fp = floor(pp);
+    pp -= fp;
+    ivec2 p = ivec2(fp);
+    //     b c
+    //   e f g h
+    //   i j k l
+    //     n o
+    vec3 b = fetch(p + ivec2(0, -1)), c = fetch(p + ivec2(1, -1));
+    vec3 e = fetch(p + ivec2(-1, 0)), f = fetch(p), g = fetch(p + ivec2(1, 0)), h = fetch(p + ivec2(2, 0));
+    vec3 i = fetch(p + ivec2(-1, 1)), j = fetch(p + ivec2(0, 1));
+    vec3 k = fetch(p + ivec2(1, 1)), l = fetch(p + ivec2(2, 1));
+    vec3 n = fetch(p + ivec2(0, 2)), o = fetch(p + ivec2(1, 2));
+    float bL = luma(b), cL = luma(c), eL = luma(e), fL = luma(f), gL = luma(g), hL = luma(h);
+    float iL = luma(i), jL = luma(j), kL = luma(k), lL = luma(l), nL = luma(n), oL = luma(o);
+
+    vec2 dir = vec2(0.0);
+    float len = 0.0;
+    edge(dir, len, (1.0 - pp.x) * (1.0 - pp.y), bL, eL, fL, gL, jL);
+    edge(dir, len, pp.x * (1.0 - pp.y), cL, fL, gL, hL, kL);
+    edge(dir, len, (1.0 - pp.x) * pp.y, fL, iL, jL, kL, nL);
+    edge(dir, len, pp.x * pp.y, gL, jL, kL, lL, oL);
+
+    // 归一化方向 (平坦区域取水平方向)；len: 0 = 平坦，1 = 强边缘
+    float dirR = dot(dir, dir);
+    dir = (dirR < 1.0 / 32768.0) ? vec2(1.0, 0.0) : dir * inversesqrt(dirR);
+    len = len * 0.5;
+    len *= len;
+    float stretch = dot(dir, dir) / max(abs(dir.x), abs(dir.y));
+    vec2 len2 = vec2(1.0 + (stretch - 1.0) * len, 1.0 - 0.5 * len);
+    float lob = 0.5 + ((1.0 / 4.0 - 0.04) - 0.5) * len;
+    float clp = 1.0 / lob;
+
+    vec3 aC = vec3(0.0);
+    float aW = 0.0;
+    tap(aC, aW, vec2(0.0, -1.0) - pp, dir, len2, lob, clp, b);
+    tap(aC, aW, vec2(1.0, -1.0) - pp, dir, len2, lob, clp, c);
+    tap(aC, aW, vec2(-1.0, 1.0) - pp, dir, len2, lob, clp, i);
+    tap(aC, aW, vec2(0.0, 1.0) - pp, dir, len2, lob, clp, j);
+    tap(aC, aW, vec2(0.0, 0.0) - pp, dir, len2, lob, clp, f);
+    tap(aC, aW, vec2(-1.0, 0.0) - pp, dir, len2, lob, clp, e);
+    tap(aC, aW, vec2(1.0, 1.0) - pp, dir, len2, lob, clp, k);
+    tap(aC, aW, vec2(2.0, 1.0) - pp, dir, len2, lob, clp, l);
+    tap(aC, aW, vec2(2.0, 0.0) - pp, dir, len2, lob, clp, h);
+    tap(aC, aW, vec2(1.0, 0.0) - pp, dir, len2, lob, clp, g);
+    tap(aC, aW, vec2(1.0, 2.0) - pp, dir, len2, lob, clp, o);
+    tap(aC, aW, vec2(0.0, 2.0) - pp, dir, len2, lob, clp, n);
+
+    vec3 mn = min(min(f, g), min(j, k));
+    vec3 mx = max(max(f, g), max(j, k));
+    FragColor = vec4(clamp(aC / aW, mn, mx), 1.0);
+}
+)";
+
+// 粒子时间累积: 当前粒子层与按运动重投影的历史混合
+// 每个像素的视线 (粒子空间) 与环平面 y = 0、本体椭球求交得到粒子位置，按角速度转回上一帧位置后用上一帧变换投影
+// 重投影出界或像素位移过大 (快速运动) 时不使用历史
+const char* const FragmentTemporalAccum = R"(
+#version 430 core
+out vec4 FragColor;
+in vec2 vUV;
+uniform sampler2D uCurrent;
+uniform sampler2D uHistory;
+uniform mat4 uInvViewProj;     // 本帧 proj * view 的逆 (未抖动)
+uniform mat4 uPrevViewProj;    // 上一帧 proj * view * model
+uniform float uPrevScale;      // 上一帧粒子缩放
+// 本帧土星姿态与粒子绘制读取同一份 (提交前锁存可能改写)
+layout(std140, binding = 0) uniform LatchedInput { mat4 model; float uScale; };
+uniform vec2 uStep;            // x = 环粒子转角系数 (乘 speed), y = 本体转角
+uniform float uHistoryWeight;  // 0 = 重置
+uniform vec2 uHistoryScale;    // 逻辑尺寸 / 历史纹理尺寸 (历史纹理按尺寸档位分配，只用左下角的子矩形)
+
+const float R = 18.0;          // 与 ComputeInitSaturn 一致
+const float MAX_MOTION = 32.0; // 像素位移超过该值时历史权重降为 0
+
+void main() {
+    // 粒子层与输出同一像素网格 (池纹理可能比输出大，按像素读取)
+    vec3 cur = texelFetch(uCurrent, ivec2(gl_FragCoord.xy), 0).rgb;
+    if (uHistoryWeight <= 0.0) {
+        FragColor = vec4(cur, 1.0);
+        return;
+    }
+
+    // 视线: 近平面 -> 远平面 (粒子空间，未乘 uScale)
+    vec2 ndc = vUV * 2.0 - 1.0;
+    // 土星模型矩阵只有旋转，逆矩阵即转置
+    vec4 n = uInvViewProj * vec4(ndc, -1.0, 1.0);
+    vec4 f = uInvViewProj * vec4(ndc, 1.0, 1.0);
+    mat3 invModel = transpose(mat3(model));
+    vec3 o = invModel * (n.xyz / n.w) / uScale;
+    vec3 d = invModel * (f.xyz / f.w) / uScale - o;
+
+    // 环平面
+    float tRing = abs(d.y) > 1e-6 ? -o.y / d.y : -1.0;
+    float rRing = length((o + d * tRing).xz);
+    bool ring = tRing > 0.0 && tRing < 1.0 && rRing > R * 1.2 && rRing < R * 2.4;
+    // 本体椭球 x^2 + (y / 0.9)^2 + z^2 = R^2，取前表面
+    vec3 oe = o * vec3(1.0, 1.0 / 0.9, 1.0);
+    vec3 de = d * vec3(1.0, 1.0 / 0.9, 1.0);
+    float b = dot(oe, de);
+    float disc = b * b - dot(de, de) * (dot(oe, oe) - R * R);
+    float tBody = disc >= 0.0 ? (-b - sqrt(disc)) / dot(de, de) : -1.0;
+    bool body = tBody > 0.0 && tBody < 1.0;
+
+    vec3 p;
+    float angle;
+    if (ring && (!body || tRing < tBody)) {
+        p = o + d * tRing;
+        angle = uStep.x * 8.0 / sqrt(rRing);
+    } else if (body) {
+        p = o + d * tBody;
+        angle = uStep.y;
+    } else {
+        // 都没有命中 (零散的粒子): 取视线上离土星中心最近的点，按本体转动
+        p = o + d * clamp(-dot(o, d) / dot(d, d), 0.0, 1.0);
+        angle = uStep.y;
+    }
+
+    // ComputeSaturn 每帧把粒子绕 y 轴转 angle，这里转回去
+    float c = cos(angle), s = sin(angle);
+    vec3 prevP = vec3(p.x * c + p.z * s, p.y, -p.x * s + p.z * c);
+    vec4 prevClip = uPrevViewProj * vec4(prevP * uPrevScale, 1.0);
+    vec2 prevUV = prevClip.xy / prevClip.w * 0.5 + 0.5;
+
+    vec2 historySize = vec2(textureSize(uHistory, 0));
+    vec2 motion = (prevUV - vUV) * historySize * uHistoryScale;
+    float w = uHistoryWeight * clamp(1.0 - length(motion) / MAX_MOTION, 0.0, 1.0);
+    if (prevClip.w <= 0.0 || any(lessThan(prevUV, vec2(0.0))) || any(greaterThan(prevUV, vec2(1.0)))) {
+        w = 0.0;
+    }
+    // 双线性采样不越过子矩形最外一圈纹素的中心
+    vec3 hist = texture(uHistory, min(prevUV * uHistoryScale, (historySize * uHistoryScale - 0.5) / historySize)).rgb;
+    FragColor = vec4(w > 0.0 ? mix(cur, hist, w) : cur, 1.0);
+}
+)";
+
+// 纹理直接叠加 (配合 GL_ONE, GL_ONE 混合，把累积后的粒子层加到场景上)
+// 源与目标同一像素网格，按像素读取 (源可能是比目标大的池纹理)
+const char* const FragmentCopy = R"(
+#version 430 core
+out vec4 FragColor;
+uniform sampler2D uTexture;
+void main() { FragColor = vec4(texelFetch(uTexture, ivec2(gl_FragCoord.xy), 0).rgb, 1.0); }
+)";
+
 // 优化: 添加简单 tone mapping 以配合 R11F_G11F_B10F HDR 格式
 // 优化: 使用 mix 替代 if-else 分支，避免着色器发散
+// 动态分辨率放大后叠加 RCAS 风格的对比度自适应锐化 (uSharpness 为 0 时跳过，原生分辨率不锐化)
 const char* const FragmentQuad = R"(
 #version 430 core
 out vec4 FragColor;
 in vec2 vUV;
 uniform sampler2D uTexture;
 uniform float uTransparent;  // 改为 float 以便无分支混合
+uniform float uSharpness;    // RCAS 锐化强度 (exp2(-stops))，0 = 关闭
+uniform vec2 uUVScale;       // 逻辑尺寸 / 纹理尺寸 (池纹理只用左下角的子矩形)
 
 // 简化的 Reinhard tone mapping
 vec3 toneMap(vec3 hdr) {
     return hdr / (hdr + vec3(1.0));
 }
 
+// 轻度 tone mapping: 只压缩超过 1.0 的高光部分
+vec3 grade(vec3 col) {
+    return mix(col, toneMap(col), step(1.0, max(max(col.r, col.g), col.b)) * 0.5);
+}
+
+vec3 fetchLdr(ivec2 p, ivec2 srcMax) {
+    return clamp(grade(texelFetch(uTexture, clamp(p, ivec2(0), srcMax), 0).rgb), 0.0, 1.0);
+}
+
+// RCAS: 由十字形邻居的最小 / 最大值求出不会溢出 [0, 1] 的最大负瓣，对比度高的地方自动减弱锐化
+vec3 sharpen(vec3 e) {
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 srcMax = ivec2(vec2(textureSize(uTexture, 0)) * uUVScale + 0.5) - 1;
+    vec3 b = fetchLdr(p + ivec2(0, 1), srcMax);
+    vec3 d = fetchLdr(p + ivec2(-1, 0), srcMax);
+    vec3 f = fetchLdr(p + ivec2(1, 0), srcMax);
+    vec3 h = fetchLdr(p + ivec2(0, -1), srcMax);
+    e = clamp(e, 0.0, 1.0);
+    vec3 mn4 = min(min(b, d), min(f, h));
+    vec3 mx4 = max(max(b, d), max(f, h));
+    vec3 hitMin = mn4 / max(4.0 * mx4, 1e-5);
+    vec3 hitMax = (1.0 - mx4) / min(4.0 * mn4 - 4.0, -1e-5);
+    vec3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-(0.25 - 1.0 / 16.0), min(max(max(lobeRGB.r, lobeRGB.g), lobeRGB.b), 0.0)) * uSharpness;
+    return (lobe * (b + d + f + h) + e) / (4.0 * lobe + 1.0);
+}
+
 void main(){
-    vec3 col = texture(uTexture, vUV).rgb;
-    // 轻度 tone mapping: 只压缩超过 1.0 的高光部分
-    col = mix(col, toneMap(col), step(1.0, max(max(col.r, col.g), col.b)) * 0.5);
+    // 双线性采样限制在逻辑子矩形最外一圈纹素的中心以内，不混入子矩形之外的过期内容
+    vec2 texSize = vec2(textureSize(uTexture, 0));
+    vec2 uvMax = (texSize * uUVScale - 0.5) / texSize;
+    vec3 col = grade(texture(uTexture, min(vUV * uUVScale, uvMax)).rgb);
+    if (uSharpness > 0.0) {
+        col = sharpen(col);
+    }
     // 无分支: 根据 uTransparent 在 1.0 和 maxRGB 之间混合
     float maxRGB = max(max(col.r, col.g), col.b);
     float alpha = mix(1.0, maxRGB, uTransparent);
@@ -362,7 +1035,7 @@ void main(){
 }
 )";
 
-// Kawase Blur 着色器 (比高斯模糊更高效)
+// Kawase Blur 着色器 (旧的固定 1/6 分辨率 ping-pong 实现，仅用于 --bench-blur 对比)
 // 每次迭代采样4个对角线方向的像素，通过多次迭代实现模糊
 const char* const FragmentBlur = R"(
 #version 430 core
@@ -377,6 +1050,68 @@ void main(){
 }
 )";
 
+// 双重 Kawase 降采样 (计算着色器): 输出分辨率减半
+// 8x8 个输出像素覆盖 16x16 个源像素，四个对角采样各向外扩 1 像素 -> 18x18 共享内存分块
+// 每个采样点都落在源纹素的 2x2 交界处，双线性采样等价于分块内 2x2 平均
+// uOffset (8 的倍数) 为本次调度覆盖区域的左下角，只计算 UI 需要的区域
+const char* const ComputeBlurDown = R"(
+#version 430 core
+layout(local_size_x=8, local_size_y=8) in;
+layout(binding=0) uniform sampler2D uSrc;
+layout(r11f_g11f_b10f, binding=0) uniform writeonly image2D uDst;
+uniform ivec2 uOffset;
+uniform ivec2 uSrcMax; // 源图像有效范围的最大纹素坐标 (level 0 的源是可能更大的池纹理)
+shared vec3 tile[18][18];
+vec3 box(ivec2 p){ return (tile[p.y][p.x] + tile[p.y][p.x+1] + tile[p.y+1][p.x] + tile[p.y+1][p.x+1]) * 0.25; }
+void main(){
+    ivec2 base = uOffset + ivec2(gl_WorkGroupID.xy) * 8;
+    ivec2 origin = base * 2 - 1;
+    for(uint i = gl_LocalInvocationIndex; i < 324u; i += 64u){
+        ivec2 t = ivec2(i % 18u, i / 18u);
+        tile[t.y][t.x] = texelFetch(uSrc, clamp(origin + t, ivec2(0), uSrcMax), 0).rgb;
+    }
+    barrier();
+    ivec2 dst = base + ivec2(gl_LocalInvocationID.xy);
+    if(any(greaterThanEqual(dst, imageSize(uDst)))) return;
+    ivec2 c = ivec2(gl_LocalInvocationID.xy) * 2 + 1; // 中心 2x2 块在分块中的左上角
+    vec3 sum = box(c) * 4.0 + box(c - 1) + box(c + 1) + box(c + ivec2(1, -1)) + box(c + ivec2(-1, 1));
+    imageStore(uDst, dst, vec4(sum * 0.125, 1.0));
+}
+)";
+
+// 双重 Kawase 升采样 (计算着色器): 输出分辨率加倍
+// 8x8 个输出像素对应 4x4 个源像素，采样半径 1 像素 + 双线性邻居 -> 8x8 分块，每个线程读一个纹素
+// uOffset 同降采样 (8 的倍数，保证分块原点对齐到源纹素)
+const char* const ComputeBlurUp = R"(
+#version 430 core
+layout(local_size_x=8, local_size_y=8) in;
+layout(binding=0) uniform sampler2D uSrc;
+layout(r11f_g11f_b10f, binding=0) uniform writeonly image2D uDst;
+uniform ivec2 uOffset;
+shared vec3 tile[8][8];
+vec3 tap(vec2 q){ // q: 分块内坐标，整数处为纹素中心
+    ivec2 i = ivec2(floor(q)); vec2 f = q - vec2(i);
+    vec3 a = mix(tile[i.y][i.x], tile[i.y][i.x+1], f.x);
+    vec3 b = mix(tile[i.y+1][i.x], tile[i.y+1][i.x+1], f.x);
+    return mix(a, b, f.y);
+}
+void main(){
+    ivec2 l = ivec2(gl_LocalInvocationID.xy);
+    ivec2 base = uOffset + ivec2(gl_WorkGroupID.xy) * 8;
+    ivec2 origin = base / 2 - 2;
+    tile[l.y][l.x] = texelFetch(uSrc, clamp(origin + l, ivec2(0), textureSize(uSrc, 0) - 1), 0).rgb;
+    barrier();
+    ivec2 dst = base + l;
+    if(any(greaterThanEqual(dst, imageSize(uDst)))) return;
+    vec2 q = (vec2(dst) + 0.5) * 0.5 - 0.5 - vec2(origin);
+    vec3 sum = tap(q + vec2(-1.0, 0.0)) + tap(q + vec2(1.0, 0.0));
+    sum += tap(q + vec2(0.0, -1.0)) + tap(q + vec2(0.0, 1.0));
+    sum += (tap(q + vec2(-0.5, -0.5)) + tap(q + vec2(0.5, -0.5))) * 2.0;
+    sum += (tap(q + vec2(-0.5, 0.5)) + tap(q + vec2(0.5, 0.5))) * 2.0;
+    imageStore(uDst, dst, vec4(sum / 12.0, 1.0));
+}
+)";
+
 // 星空着色器
 const char* const VertexStar = R"(
 #version 430 core
@@ -390,82 +1125,134 @@ void main(){
 }
 )";
 
+// 星星绘制到缓存层，闪烁在合成时做 (见 FragmentStarLayer)
 const char* const FragmentStar = R"(
 #version 430 core
-out vec4 F; in vec3 vColor; uniform float uTime;
+out vec4 F; in vec3 vColor;
 void main(){ 
     vec2 c=2.0*gl_PointCoord-1.0; 
     if(dot(c,c)>1.0)discard; 
-    float n=fract(sin(dot(gl_FragCoord.xy,vec2(12.9,78.2)))*43758.5); 
-    vec3 col = vColor * (0.7 + 0.3 * sin(uTime * 2.0 + n * 10.0)) * 3.0;
-    F=vec4(col, pow(1.0-dot(c,c),1.5)*0.9); 
+    F=vec4(vColor * 3.0, pow(1.0-dot(c,c),1.5)*0.9); 
+}
+)";
+
+// 星空缓存层合成: 重投影到当前帧，再叠加屏幕空间闪烁
+// 闪烁哈希取缓存纹素坐标，图案跟随星星移动
+const char* const FragmentStarLayer = R"(
+#version 430 core
+out vec4 F; in vec2 vUV;
+uniform sampler2D uTexture;
+uniform mat4 uReproject;
+uniform float uTime;
+void main(){
+    vec4 p = uReproject * vec4(vUV * 2.0 - 1.0, 1.0, 1.0);
+    vec2 uv = p.xy / p.w * 0.5 + 0.5;
+    vec3 col = texture(uTexture, uv).rgb;
+    vec2 texel = floor(uv * vec2(textureSize(uTexture, 0)));
+    float n = fract(sin(dot(texel, vec2(12.9, 78.2))) * 43758.5);
+    F = vec4(col * (0.7 + 0.3 * sin(uTime * 2.0 + n * 10.0)), 1.0);
 }
 )";
 
 // 行星着色器 (实例化渲染优化)
-// 使用 UBO 存储行星数据，单次 draw call 渲染所有行星
+// 实例数据在 SSBO 中 (PlanetSystem 写入)，顶点属性 aInstance 来自计算着色器生成的可见列表
+// 法线矩阵在 CPU 预计算；颜色参数通过 flat 变量传给片段着色器
 const char* const VertexPlanet = R"(
 #version 430 core
 layout(location=0) in vec3 aPos; layout(location=1) in vec3 aNorm; layout(location=2) in vec2 aTex;
+layout(location=3) in uint aInstance; // 每实例属性，baseInstance 偏移到对应 LOD 的可见列表段
 
-// 行星实例数据 (UBO)
 struct PlanetInstance {
-    mat4 modelMatrix;     // 模型矩阵
-    vec4 color1;          // 颜色1 (xyz) + noiseScale (w)
-    vec4 color2;          // 颜色2 (xyz) + atmosphere (w)
-};
-layout(std140, binding = 0) uniform PlanetUBO {
-    PlanetInstance planets[8];  // 最多支持 8 个行星
+    mat4 modelMatrix;
+    vec4 normalMatrix[3]; // mat3，每列补齐到 vec4
+    vec4 color1;          // xyz = color, w = noiseScale
+    vec4 color2;          // xyz = color, w = atmosphere
+    vec4 bounds;          // xyz = 世界空间球心, w = 半径
 };
+layout(std430, binding = 2) readonly buffer PlanetInstances { PlanetInstance planets[]; };
 
 uniform mat4 v, p;
-uniform int uPlanetCount;
 
 out vec2 U;
 out vec3 N, V;
-flat out int instanceID;
+flat out vec4 C1, C2;
 
 void main(){
-    instanceID = gl_InstanceID;
-    mat4 m = planets[gl_InstanceID].modelMatrix;
+    PlanetInstance inst = planets[aInstance];
+    mat3 nm = mat3(inst.normalMatrix[0].xyz, inst.normalMatrix[1].xyz, inst.normalMatrix[2].xyz);
     U = aTex;
-    N = normalize(mat3(transpose(inverse(m))) * aNorm);
-    vec4 P = v * m * vec4(aPos, 1.0);
+    N = normalize(nm * aNorm);
+    C1 = inst.color1;
+    C2 = inst.color2;
+    vec4 P = v * inst.modelMatrix * vec4(aPos, 1.0);
     V = -P.xyz;
     gl_Position = p * P;
 }
 )";
-
 const char* const FragmentPlanet = R"(
 #version 430 core
 out vec4 F;
 in vec2 U;
 in vec3 N, V;
-flat in int instanceID;
+flat in vec4 C1, C2; // xyz = color, w = noiseScale / atmosphere
+
+uniform vec3 ld;
+uniform sampler2D uFBMTex;
+
+void main(){
+    float x = texture(uFBMTex, U * C1.w).r;
+    vec3 c = mix(C1.xyz, C2.xyz, x) * max(dot(normalize(N), normalize(ld)), 0.05);
+    c += C2.w * vec3(0.5, 0.6, 1.0) * pow(1.0 - dot(normalize(V), normalize(N)), 3.0);
+    F = vec4(c, 1.0);
+}
+)";
+
+// 行星剔除 + LOD 选择: 每个实例做视锥球体测试，按投影半径选择网格 LOD，
+// 原子累加对应间接绘制命令的 instanceCount 并写入该 LOD 的可见列表段
+const char* const ComputePlanetCull = R"(
+#version 430 core
+layout(local_size_x = 64) in;
 
-// 行星实例数据 (UBO)
 struct PlanetInstance {
     mat4 modelMatrix;
-    vec4 color1;  // xyz = color, w = noiseScale
-    vec4 color2;  // xyz = color, w = atmosphere
+    vec4 normalMatrix[3];
+    vec4 color1;
+    vec4 color2;
+    vec4 bounds;
 };
-layout(std140, binding = 0) uniform PlanetUBO {
-    PlanetInstance planets[8];
+struct DrawCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int  baseVertex;
+    uint baseInstance;
 };
+layout(std430, binding = 2) readonly buffer PlanetInstances { PlanetInstance planets[]; };
+layout(std430, binding = 3) writeonly buffer VisibleList { uint visible[]; };
+layout(std430, binding = 4) buffer DrawCommands { DrawCommand commands[]; };
 
-uniform vec3 ld;
-uniform sampler2D uFBMTex;
+uniform mat4 uView;
+uniform vec4 uPlanes[6];  // 归一化视锥平面
+uniform float uProjScale; // 世界半径 / 距离 → 像素半径
+uniform vec3 uLodPixels;  // LOD 0 / 1 / 2 的最小投影半径 (像素)
+uniform uint uCount;
+uniform uint uCapacity;   // 每个 LOD 可见列表段的长度
 
 void main(){
-    vec3 c1 = planets[instanceID].color1.xyz;
-    vec3 c2 = planets[instanceID].color2.xyz;
-    float ns = planets[instanceID].color1.w;
-    float at = planets[instanceID].color2.w;
-
-    float x = texture(uFBMTex, U * ns).r;
-    vec3 c = mix(c1, c2, x) * max(dot(normalize(N), normalize(ld)), 0.05);
-    c += at * vec3(0.5, 0.6, 1.0) * pow(1.0 - dot(normalize(V), normalize(N)), 3.0);
-    F = vec4(c, 1.0);
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= uCount) return;
+
+    vec4 b = planets[i].bounds;
+    for (int k = 0; k < 6; k++) {
+        if (dot(uPlanes[k].xyz, b.xyz) + uPlanes[k].w < -b.w) return;
+    }
+
+    float dist = max(length((uView * vec4(b.xyz, 1.0)).xyz), b.w);
+    float px = b.w * uProjScale / dist;
+    uint level = px >= uLodPixels.x ? 0u : (px >= uLodPixels.y ? 1u : (px >= uLodPixels.z ? 2u : 3u));
+
+    uint slot = atomicAdd(commands[level].instanceCount, 1u);
+    visible[level * uCapacity + slot] = i;
 }
 )";
 
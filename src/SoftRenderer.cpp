@@ -0,0 +1,764 @@
+// SoftRenderer.cpp - CPU 软件渲染器实现
+
+#include "pch.h"
+
+#include "SoftRenderer.h"
+#include "FBMNoise.h"
+#include "PlanetSystem.h" // GenerateBodies
+#include "StarField.h"
+
+#define STBI_MSC_SECURE_CRT
+#define STBI_ONLY_PNG
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+#include <immintrin.h> // SSE
+
+namespace SoftRenderer {
+
+namespace {
+
+constexpr float kPi    = 3.14159265359f;
+constexpr float kTwoPi = 6.28318530718f;
+
+// 屏幕空间的点: 中心和半径 (像素)，颜色已乘 alpha；radius <= 0 表示被裁剪
+struct Splat {
+    float x, y, radius;
+    float r, g, b;
+};
+
+// 按分块排好的点序号: refs[tileFirst[t] .. tileFirst[t + 1]) 属于分块 t，块内序号递增
+struct TileBins {
+    std::vector<uint32_t> tileFirst;
+    std::vector<uint32_t> refs;
+};
+
+// 行星的屏幕包围盒和着色参数
+struct PlanetHit {
+    glm::vec3 center;
+    float     radius;
+    glm::mat3 toLocal; // 世界方向 → 网格局部方向 (求纹理坐标)
+    glm::vec3 color1, color2;
+    float     noiseScale, atmosphere;
+    int       x0, y0, x1, y1;
+};
+
+int ResolveThreads(int threads) {
+    return threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+double MsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ---- GLSL 函数的 CPU 版本 ----
+
+float Smoothstep(float e0, float e1, float x) {
+    float t = std::clamp((x - e0) / (e1 - e0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// ComputeInitSaturn 的 random()
+float Random(uint32_t& state) {
+    state           = state * 747796405u + 2891336453u;
+    uint32_t result = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    result          = (result >> 22u) ^ result;
+    return (float)result / 4294967295.0f;
+}
+
+uint32_t PackRGBA8(const glm::vec3& c, float a) {
+    auto u = [](float v) { return (uint32_t)(std::clamp(v, 0.0f, 1.0f) * 255.0f); };
+    return u(c.x) | (u(c.y) << 8u) | (u(c.z) << 16u) | (u(a) << 24u);
+}
+
+// VertexSaturn 的 hash() / fastSin()
+float Hash(float n) {
+    uint32_t x;
+    std::memcpy(&x, &n, sizeof(x));
+    x = ((x >> 16u) ^ x) * 0x45d9f3bu;
+    x = ((x >> 16u) ^ x) * 0x45d9f3bu;
+    x = (x >> 16u) ^ x;
+    return (float)x * (1.0f / 4294967296.0f);
+}
+
+float FastSin(float x) {
+    x        = x - kTwoPi * floorf(x / kTwoPi);
+    x        = x > kPi ? x - kTwoPi : x;
+    float x2 = x * x;
+    return x * (1.0f - x2 * (0.16666667f - x2 * (0.00833333f - x2 * 0.0001984f)));
+}
+
+// 点覆盖的像素 (像素中心落在点的方框内)，裁剪到图像范围；返回 false 表示不覆盖任何像素
+bool PixelRange(const Splat& s, int w, int h, int& x0, int& y0, int& x1, int& y1) {
+    if (s.radius <= 0.0f) {
+        return false;
+    }
+    x0 = std::max(0, (int)ceilf(s.x - s.radius - 0.5f));
+    y0 = std::max(0, (int)ceilf(s.y - s.radius - 0.5f));
+    x1 = std::min(w - 1, (int)floorf(s.x + s.radius - 0.5f));
+    y1 = std::min(h - 1, (int)floorf(s.y + s.radius - 0.5f));
+    return x0 <= x1 && y0 <= y1;
+}
+
+// 裁剪坐标 → 窗口坐标；中心在裁剪体外的点整个丢弃 (与固定管线的点裁剪一致)
+bool ToWindow(const glm::vec4& clip, int w, int h, float& x, float& y) {
+    if (fabsf(clip.x) > clip.w || fabsf(clip.y) > clip.w || fabsf(clip.z) > clip.w) {
+        return false;
+    }
+    x = (clip.x / clip.w * 0.5f + 0.5f) * w;
+    y = (clip.y / clip.w * 0.5f + 0.5f) * h;
+    return true;
+}
+
+// ---- 点的投影与分块 ----
+
+// VertexSaturn + FragmentSaturn 中逐粒子不变的部分，粒子先按 time 推进 ComputeSaturn 的公转
+void ProjectParticles(const Scene& scene, const View& view, const glm::mat4& proj, const glm::mat4& modelView,
+                      int threads, std::vector<Splat>& out) {
+    const int   w           = view.width, h = view.height;
+    const float screenScale = h / 1080.0f;
+    const float t           = std::clamp((view.scale - 0.15f) * 0.4255f, 0.0f, 1.0f);
+    const float tSmooth     = Smoothstep(0.1f, 0.9f, t);
+    const float alphaScale  = (0.25f + 0.45f * Smoothstep(0.0f, 0.5f, t)) * view.densityComp;
+    const float bodyAngle   = 0.03f * view.time;
+
+    out.resize(scene.particles.size());
+    ParallelFor((uint32_t)out.size(), threads, [&](uint32_t begin, uint32_t end, int) {
+        for (uint32_t i = begin; i < end; i++) {
+            const GPUParticle& p     = scene.particles[i];
+            Splat&             s     = out[i];
+            float              angle = p.isRing < 0.5f ? bodyAngle : p.speed * 0.2f * view.time;
+            float              c = cosf(angle), sn = sinf(angle);
+            glm::vec4          aPos(p.pos.x * c - p.pos.z * sn, p.pos.y, p.pos.x * sn + p.pos.z * c, p.pos.w);
+
+            glm::vec4 mv   = modelView * glm::vec4(glm::vec3(aPos) * view.scale, 1.0f);
+            float     dist = -mv.z;
+
+            float chaos = Smoothstep(25.0f, 0.1f, dist);
+            chaos       = chaos * chaos * chaos;
+            if (chaos > 0.001f) {
+                float highFreqTime = view.time * 40.0f;
+                float k            = 0.5f * 3.0f * chaos;
+                mv.x += FastSin(highFreqTime + aPos.x * 10.0f) * Hash(aPos.y * 43758.5f) * k;
+                mv.y += FastSin(highFreqTime + aPos.y * 10.0f + 1.5708f) * Hash(aPos.x * 43758.5f) * k;
+                mv.z += FastSin(highFreqTime * 0.5f) * Hash(aPos.z * 43758.5f) * k;
+            }
+
+            s.radius = 0.0f;
+            if (!ToWindow(proj * mv, w, h, s.x, s.y)) {
+                continue;
+            }
+
+            float pointSize = aPos.w * 350.0f / std::max(dist, 0.1f) * 0.55f * screenScale;
+            pointSize *= p.isRing < 0.5f && dist <= 50.0f ? 0.8f : 1.0f;
+            pointSize = std::clamp(pointSize, 0.0f, 300.0f * screenScale);
+
+            glm::vec4 col(((p.color >> 0u) & 0xFFu) / 255.0f, ((p.color >> 8u) & 0xFFu) / 255.0f,
+                          ((p.color >> 16u) & 0xFFu) / 255.0f, ((p.color >> 24u) & 0xFFu) / 255.0f);
+            glm::vec3 rgb        = glm::vec3(col);
+            glm::vec3 finalColor = glm::mix(glm::vec3(0.35f, 0.22f, 0.05f), rgb, tSmooth) * (0.2f + t);
+            float     closeMix   = Smoothstep(40.0f, 0.0f, dist);
+            if (p.isRing < 0.5f) {
+                glm::vec3 lit(powf(rgb.x, 1.4f), powf(rgb.y, 1.4f), powf(rgb.z, 1.4f));
+                finalColor = glm::mix(finalColor, lit * 1.5f, closeMix * 0.8f);
+            } else {
+                finalColor += glm::vec3(0.15f, 0.12f, 0.1f) * closeMix;
+            }
+            float alpha = col.w * alphaScale * Smoothstep(0.0f, 10.0f, dist);
+            if (alpha <= 0.0f) {
+                continue;
+            }
+
+            // 固定管线的点径下限为 1 像素
+            s.radius = std::max(pointSize, 1.0f) * 0.5f;
+            s.r      = finalColor.x * alpha;
+            s.g      = finalColor.y * alpha;
+            s.b      = finalColor.z * alpha;
+        }
+    });
+}
+
+// VertexStar: 点径 clamp(size * 1000 / 距离, 1, 8)，颜色 x3 (alpha 在逐像素阶段)
+void ProjectStars(const Scene& scene, const View& view, const glm::mat4& proj, const glm::mat4& modelView,
+                  int threads, std::vector<Splat>& out) {
+    out.resize(scene.stars.size() / StarField::kFloatsPerStar);
+    ParallelFor((uint32_t)out.size(), threads, [&](uint32_t begin, uint32_t end, int) {
+        for (uint32_t i = begin; i < end; i++) {
+            const float* star = &scene.stars[(size_t)i * StarField::kFloatsPerStar];
+            Splat&       s    = out[i];
+            glm::vec4    p    = modelView * glm::vec4(star[0], star[1], star[2], 1.0f);
+            s.radius          = 0.0f;
+            if (!ToWindow(proj * p, view.width, view.height, s.x, s.y)) {
+                continue;
+            }
+            s.radius = std::clamp(star[6] * (1000.0f / -p.z), 1.0f, 8.0f) * 0.5f;
+            s.r      = star[3] * 3.0f;
+            s.g      = star[4] * 3.0f;
+            s.b      = star[5] * 3.0f;
+        }
+    });
+}
+
+template <typename Fn> void ForEachTile(const Splat& s, int w, int h, int tilesX, Fn&& fn) {
+    int x0, y0, x1, y1;
+    if (!PixelRange(s, w, h, x0, y0, x1, y1)) {
+        return;
+    }
+    for (int ty = y0 / kTileSize; ty <= y1 / kTileSize; ty++) {
+        for (int tx = x0 / kTileSize; tx <= x1 / kTileSize; tx++) {
+            fn(ty * tilesX + tx);
+        }
+    }
+}
+
+// 计数排序: 各线程统计自己区间内每个分块的点数 → 按 (分块, 线程) 顺序求前缀和 → 各线程按同样的区间填入
+// 线程 t 的区间整体排在线程 t - 1 之后，所以块内顺序就是点序号顺序，与线程数无关
+void BinSplats(const std::vector<Splat>& splats, int w, int h, int threads, TileBins& bins) {
+    const int      tilesX = (w + kTileSize - 1) / kTileSize;
+    const int      tiles  = tilesX * ((h + kTileSize - 1) / kTileSize);
+    const uint32_t count  = (uint32_t)splats.size();
+
+    std::vector<uint32_t> offsets((size_t)threads * tiles, 0);
+    ParallelFor(count, threads, [&](uint32_t begin, uint32_t end, int thread) {
+        uint32_t* counts = &offsets[(size_t)thread * tiles];
+        for (uint32_t i = begin; i < end; i++) {
+            ForEachTile(splats[i], w, h, tilesX, [&](int tile) { counts[tile]++; });
+        }
+    });
+
+    bins.tileFirst.resize(tiles + 1);
+    uint32_t total = 0;
+    for (int tile = 0; tile < tiles; tile++) {
+        bins.tileFirst[tile] = total;
+        for (int thread = 0; thread < threads; thread++) {
+            uint32_t& slot = offsets[(size_t)thread * tiles + tile];
+            uint32_t  n    = slot;
+            slot           = total;
+            total += n;
+        }
+    }
+    bins.tileFirst[tiles] = total;
+
+    bins.refs.resize(total);
+    ParallelFor(count, threads, [&](uint32_t begin, uint32_t end, int thread) {
+        uint32_t* next = &offsets[(size_t)thread * tiles];
+        for (uint32_t i = begin; i < end; i++) {
+            ForEachTile(splats[i], w, h, tilesX, [&](int tile) { bins.refs[next[tile]++] = i; });
+        }
+    });
+}
+
+// ---- 分块光栅化 ----
+
+// 把点加法混合到分块累加缓冲 (每像素 rgb + 填充 4 个 float)，weight(distSq) 为逐像素衰减
+template <typename Weight>
+void DrawSplat(float* acc, int tileX0, int tileY0, const Splat& s, int w, int h, Weight&& weight) {
+    int x0, y0, x1, y1;
+    if (!PixelRange(s, w, h, x0, y0, x1, y1)) {
+        return;
+    }
+    x0 = std::max(x0, tileX0);
+    y0 = std::max(y0, tileY0);
+    x1 = std::min(x1, tileX0 + kTileSize - 1);
+    y1 = std::min(y1, tileY0 + kTileSize - 1);
+
+    const __m128 color  = _mm_setr_ps(s.r, s.g, s.b, 0.0f);
+    const float  invRad = 1.0f / s.radius;
+    for (int y = y0; y <= y1; y++) {
+        float  dy  = (y + 0.5f - s.y) * invRad;
+        float* row = acc + (size_t)(y - tileY0) * kTileSize * 4;
+        for (int x = x0; x <= x1; x++) {
+            float dx     = (x + 0.5f - s.x) * invRad;
+            float distSq = dx * dx + dy * dy;
+            if (distSq > 1.0f) {
+                continue;
+            }
+            float* px = row + (x - tileX0) * 4;
+            _mm_storeu_ps(px, _mm_add_ps(_mm_loadu_ps(px), _mm_mul_ps(color, _mm_set1_ps(weight(distSq)))));
+        }
+    }
+}
+
+// 双线性采样 R8 噪声 (GL_REPEAT)
+float SampleFBM(const Scene& scene, float u, float v) {
+    const int W = scene.fbmWidth, H = scene.fbmHeight;
+    float     x = u * W - 0.5f, y = v * H - 0.5f;
+    float     fx = floorf(x), fy = floorf(y);
+    int       x0 = (int)fx, y0 = (int)fy;
+    float     ax = x - fx, ay = y - fy;
+    auto      at = [&](int px, int py) {
+        px = ((px % W) + W) % W;
+        py = ((py % H) + H) % H;
+        return scene.fbm[(size_t)py * W + px] / 255.0f;
+    };
+    float top    = at(x0, y0) + (at(x0 + 1, y0) - at(x0, y0)) * ax;
+    float bottom = at(x0, y0 + 1) + (at(x0 + 1, y0 + 1) - at(x0, y0 + 1)) * ax;
+    return top + (bottom - top) * ay;
+}
+
+// 行星的世界空间变换 (与 PlanetRenderer::Update 相同) 和保守的屏幕包围盒 (外接立方体 8 个角的投影)
+std::vector<PlanetHit> PreparePlanets(const Scene& scene, const View& view, const glm::mat4& proj,
+                                      const glm::mat4& viewM) {
+    glm::mat4              orbitRot = glm::rotate(glm::mat4(1.f), view.time * 0.02f, glm::vec3(0, 1, 0));
+    float                  selfRot  = view.time * 0.1f;
+    std::vector<PlanetHit> hits;
+    for (const PlanetData& p : scene.planets) {
+        glm::mat4 m = orbitRot;
+        m           = glm::translate(m, p.pos);
+        m           = glm::rotate(m, selfRot, glm::vec3(0, 1, 0));
+        m           = glm::scale(m, glm::vec3(p.radius));
+
+        PlanetHit hit;
+        hit.center     = glm::vec3(m[3]);
+        hit.radius     = p.radius;
+        hit.toLocal    = glm::transpose(glm::mat3(m) * (1.0f / p.radius));
+        hit.color1     = p.color1;
+        hit.color2     = p.color2;
+        hit.noiseScale = p.noiseScale;
+        hit.atmosphere = p.atmosphere;
+        hit.x0 = view.width, hit.y0 = view.height, hit.x1 = -1, hit.y1 = -1;
+
+        glm::vec3 c       = glm::vec3(viewM * glm::vec4(hit.center, 1.0f));
+        bool      crosses = false;
+        for (int corner = 0; corner < 8; corner++) {
+            glm::vec3 q = c + glm::vec3(corner & 1 ? p.radius : -p.radius, corner & 2 ? p.radius : -p.radius,
+                                        corner & 4 ? p.radius : -p.radius);
+            if (-q.z < 1.0f) {
+                crosses = true; // 穿过近平面: 不再估计包围盒，整屏求交
+                break;
+            }
+            glm::vec4 clip = proj * glm::vec4(q, 1.0f);
+            float     sx   = (clip.x / clip.w * 0.5f + 0.5f) * view.width;
+            float     sy   = (clip.y / clip.w * 0.5f + 0.5f) * view.height;
+            hit.x0         = std::min(hit.x0, (int)floorf(sx));
+            hit.y0         = std::min(hit.y0, (int)floorf(sy));
+            hit.x1         = std::max(hit.x1, (int)ceilf(sx));
+            hit.y1         = std::max(hit.y1, (int)ceilf(sy));
+        }
+        if (crosses) {
+            if (c.z - p.radius > -1.0f) {
+                continue; // 整个在近平面之后
+            }
+            hit.x0 = 0, hit.y0 = 0, hit.x1 = view.width - 1, hit.y1 = view.height - 1;
+        }
+        if (hit.x1 >= 0 && hit.y1 >= 0 && hit.x0 < view.width && hit.y0 < view.height) {
+            hits.push_back(hit);
+        }
+    }
+    return hits;
+}
+
+} // namespace
+
+void GenerateParticles(uint32_t count, uint32_t seed, std::vector<GPUParticle>& out, int threads) {
+    static const glm::vec3 bodyColors[4] = {HexToRGB(0xE3DAC5), HexToRGB(0xC9A070), HexToRGB(0xE3DAC5),
+                                            HexToRGB(0xB08D55)};
+    out.resize(count);
+    ParallelFor(count, ResolveThreads(threads), [&](uint32_t begin, uint32_t end, int) {
+        for (uint32_t id = begin; id < end; id++) {
+            uint32_t    rngState = id * 1973u + seed * 9277u + 26699u;
+            float       typeRnd  = Random(rngState);
+            const float R        = 18.0f;
+            GPUParticle p        = {};
+            glm::vec3   color;
+            float       alpha;
+
+            if (typeRnd < 0.25f) {
+                float th  = 6.28318f * Random(rngState);
+                float ph  = acosf(2.0f * Random(rngState) - 1.0f);
+                p.pos.x   = R * sinf(ph) * cosf(th);
+                p.pos.y   = R * cosf(ph) * 0.9f;
+                p.pos.z   = R * sinf(ph) * sinf(th);
+                float lat = (p.pos.y / 0.9f / R + 1.0f) * 0.5f;
+                int   idx = (int)(lat * 4.0f + cosf(lat * 40.0f) * 0.8f + cosf(lat * 15.0f) * 0.4f);
+                int   ci  = std::max(0, idx - (idx / 4) * 4);
+                color     = bodyColors[ci];
+                p.pos.w   = 1.0f + Random(rngState) * 0.8f;
+                alpha     = 0.8f;
+                p.speed   = 0.0f;
+                p.isRing  = 0.0f;
+            } else {
+                float z = Random(rngState);
+                float rad, s;
+                if (z < 0.15f) {
+                    rad   = R * (1.235f + Random(rngState) * 0.29f);
+                    color = HexToRGB(0x2A2520);
+                    s     = 0.5f;
+                    alpha = 0.3f;
+                } else if (z < 0.65f) {
+                    float t = Random(rngState);
+                    rad     = R * (1.525f + t * 0.425f);
+                    color   = glm::mix(HexToRGB(0xCDBFA0), HexToRGB(0xDCCBBA), t);
+                    s       = 0.8f + Random(rngState) * 0.6f;
+                    alpha   = sinf(rad * 2.0f) > 0.8f ? 0.85f * 1.2f : 0.85f;
+                } else if (z < 0.69f) {
+                    rad   = R * (1.95f + Random(rngState) * 0.075f);
+                    color = HexToRGB(0x050505);
+                    s     = 0.3f;
+                    alpha = 0.1f;
+                } else if (z < 0.99f) {
+                    rad   = R * (2.025f + Random(rngState) * 0.245f);
+                    color = HexToRGB(0x989085);
+                    s     = 0.7f;
+                    alpha = rad > R * 2.2f && rad < R * 2.21f ? 0.1f : 0.6f;
+                } else {
+                    rad   = R * (2.32f + Random(rngState) * 0.02f);
+                    color = HexToRGB(0xAFAFA0);
+                    s     = 1.0f;
+                    alpha = 0.7f;
+                }
+                float th          = Random(rngState) * 6.28318f;
+                float heightRange = rad > R * 2.3f ? 0.4f : 0.15f;
+                p.pos.x           = rad * cosf(th);
+                p.pos.z           = rad * sinf(th);
+                p.pos.y           = (Random(rngState) - 0.5f) * heightRange;
+                p.pos.w           = s;
+                p.speed           = 8.0f / sqrtf(rad);
+                p.isRing          = 1.0f;
+            }
+            p.color = PackRGBA8(color, alpha);
+            out[id] = p;
+        }
+    });
+}
+
+Scene BuildScene(const SceneParams& params, int threads) {
+    Scene scene;
+    GenerateParticles(params.particleCount, params.particleSeed, scene.particles, threads);
+
+    StarField::Params starParams;
+    starParams.count = params.starCount;
+    scene.stars.resize((size_t)starParams.count * StarField::kFloatsPerStar);
+    StarField::Generate(starParams, scene.stars.data(), nullptr, threads);
+
+    scene.planets.assign(std::begin(PlanetConstants::kPlanets), std::end(PlanetConstants::kPlanets));
+    if (params.planetCount > (uint32_t)PlanetConstants::kPlanetCount) {
+        uint32_t                extraCount = params.planetCount - PlanetConstants::kPlanetCount;
+        std::vector<PlanetData> extra      = PlanetSystem::GenerateBodies(extraCount, 1);
+        scene.planets.insert(scene.planets.end(), extra.begin(), extra.end());
+    }
+
+    FBMNoise::Params fbmParams;
+    scene.fbm       = FBMNoise::GenerateCached(fbmParams);
+    scene.fbmWidth  = fbmParams.width;
+    scene.fbmHeight = fbmParams.height;
+    return scene;
+}
+
+Image Render(const Scene& scene, const View& view, int threads) {
+    threads     = ResolveThreads(threads);
+    const int w = std::max(1, view.width), h = std::max(1, view.height);
+
+    // 与 Main.cpp 的相机和模型矩阵一致
+    glm::mat4 proj  = glm::perspective(1.047f, (float)w / h, 1.f, 10000.f);
+    glm::mat4 viewM = glm::lookAt(glm::vec3(0, 0, 100), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+    glm::mat4 mStar = glm::rotate(glm::mat4(1.f), view.time * 0.005f, glm::vec3(0, 1, 0));
+    glm::mat4 mSat  = glm::mat4(1.f);
+    mSat            = glm::rotate(mSat, view.rotX, glm::vec3(1, 0, 0));
+    mSat            = glm::rotate(mSat, view.rotY, glm::vec3(0, 1, 0));
+    mSat            = glm::rotate(mSat, 0.466f, glm::vec3(0, 0, 1));
+
+    std::vector<Splat> starSplats, particleSplats;
+    TileBins           starBins, particleBins;
+    ProjectStars(scene, view, proj, viewM * mStar, threads, starSplats);
+    ProjectParticles(scene, view, proj, viewM * mSat, threads, particleSplats);
+    BinSplats(starSplats, w, h, threads, starBins);
+    BinSplats(particleSplats, w, h, threads, particleBins);
+    std::vector<PlanetHit> planets = PreparePlanets(scene, view, proj, viewM);
+
+    const glm::mat4 invViewProj = glm::inverse(proj * viewM);
+    const glm::vec3 camera      = glm::vec3(glm::inverse(viewM)[3]);
+    const glm::vec3 lightDir    = glm::normalize(glm::vec3(1, .5, 1));
+
+    Image image;
+    image.width  = w;
+    image.height = h;
+    image.rgb.assign((size_t)w * h * 3, 0.0f);
+
+    // 每个线程取下一个分块: 星星 → 闪烁 → 粒子 → 行星，最后整块写回
+    const int        tilesX = (w + kTileSize - 1) / kTileSize;
+    const int        tiles  = tilesX * ((h + kTileSize - 1) / kTileSize);
+    std::atomic<int> nextTile{0};
+    ParallelFor(threads, threads, [&](uint32_t, uint32_t, int) {
+        std::vector<float>            acc(kTileSize * kTileSize * 4);
+        std::vector<const PlanetHit*> tilePlanets;
+        for (int tile = nextTile++; tile < tiles; tile = nextTile++) {
+            const int tileX0 = (tile % tilesX) * kTileSize, tileY0 = (tile / tilesX) * kTileSize;
+            const int tileW = std::min(kTileSize, w - tileX0), tileH = std::min(kTileSize, h - tileY0);
+            std::fill(acc.begin(), acc.end(), 0.0f);
+
+            // FragmentStar: alpha = (1 - d²)^1.5 * 0.9
+            for (uint32_t r = starBins.tileFirst[tile]; r < starBins.tileFirst[tile + 1]; r++) {
+                DrawSplat(acc.data(), tileX0, tileY0, starSplats[starBins.refs[r]], w, h,
+                          [](float d2) { return powf(1.0f - d2, 1.5f) * 0.9f; });
+            }
+
+            // FragmentStarLayer 的闪烁 (哈希取像素坐标，GPU 的 sin 在大参数下精度不同，两者的闪烁图案不逐像素一致)
+            for (int y = 0; y < tileH; y++) {
+                for (int x = 0; x < tileW; x++) {
+                    float* px = &acc[((size_t)y * kTileSize + x) * 4];
+                    float  s  = sinf((tileX0 + x) * 12.9f + (tileY0 + y) * 78.2f) * 43758.5f;
+                    float  n  = s - floorf(s);
+                    float  k  = 0.7f + 0.3f * sinf(view.time * 2.0f + n * 10.0f);
+                    _mm_storeu_ps(px, _mm_mul_ps(_mm_loadu_ps(px), _mm_set1_ps(k)));
+                }
+            }
+
+            // FragmentSaturn: glow = smoothstep(1, 0.4, d²)，颜色已在投影阶段乘过 alpha
+            for (uint32_t r = particleBins.tileFirst[tile]; r < particleBins.tileFirst[tile + 1]; r++) {
+                DrawSplat(acc.data(), tileX0, tileY0, particleSplats[particleBins.refs[r]], w, h,
+                          [](float d2) { return Smoothstep(1.0f, 0.4f, d2); });
+            }
+
+            // 行星: 逐像素光线求交取最近的球面，着色与 FragmentPlanet 一致 (加法混合)
+            tilePlanets.clear();
+            for (const PlanetHit& p : planets) {
+                if (p.x1 >= tileX0 && p.x0 < tileX0 + tileW && p.y1 >= tileY0 && p.y0 < tileY0 + tileH) {
+                    tilePlanets.push_back(&p);
+                }
+            }
+            for (int y = 0; y < tileH && !tilePlanets.empty(); y++) {
+                for (int x = 0; x < tileW; x++) {
+                    float     ndcX     = (tileX0 + x + 0.5f) / w * 2.0f - 1.0f;
+                    float     ndcY     = (tileY0 + y + 0.5f) / h * 2.0f - 1.0f;
+                    glm::vec4 farPoint = invViewProj * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+                    glm::vec3 dir      = glm::normalize(glm::vec3(farPoint) / farPoint.w - camera);
+
+                    const PlanetHit* best  = nullptr;
+                    float            bestT = 1e30f;
+                    for (const PlanetHit* p : tilePlanets) {
+                        glm::vec3 oc   = camera - p->center;
+                        float     b    = glm::dot(oc, dir);
+                        float     disc = b * b - (glm::dot(oc, oc) - p->radius * p->radius);
+                        if (disc < 0.0f) {
+                            continue;
+                        }
+                        float t = -b - sqrtf(disc);
+                        if (t > 0.0f && t < bestT) {
+                            best  = p;
+                            bestT = t;
+                        }
+                    }
+                    if (!best) {
+                        continue;
+                    }
+
+                    glm::vec3 hit   = camera + dir * bestT;
+                    glm::vec3 n     = (hit - best->center) / best->radius;
+                    glm::vec3 local = best->toLocal * n;
+                    float     u     = atan2f(local.z, local.x) / kTwoPi;
+                    float     v     = acosf(std::clamp(local.y, -1.0f, 1.0f)) / kPi;
+                    u               = u < 0.0f ? u + 1.0f : u;
+
+                    float     noise = SampleFBM(scene, u * best->noiseScale, v * best->noiseScale);
+                    glm::vec3 c = glm::mix(best->color1, best->color2, noise) * std::max(glm::dot(n, lightDir), 0.05f);
+                    glm::vec3 toEye = glm::normalize(-glm::vec3(viewM * glm::vec4(hit, 1.0f)));
+                    c += best->atmosphere * glm::vec3(0.5f, 0.6f, 1.0f) * powf(1.0f - glm::dot(toEye, n), 3.0f);
+
+                    float* px = &acc[((size_t)y * kTileSize + x) * 4];
+                    _mm_storeu_ps(px, _mm_add_ps(_mm_loadu_ps(px), _mm_setr_ps(c.x, c.y, c.z, 0.0f)));
+                }
+            }
+
+            for (int y = 0; y < tileH; y++) {
+                float* dst = &image.rgb[((size_t)(tileY0 + y) * w + tileX0) * 3];
+                for (int x = 0; x < tileW; x++) {
+                    std::memcpy(dst + x * 3, &acc[((size_t)y * kTileSize + x) * 4], 3 * sizeof(float));
+                }
+            }
+        }
+    });
+    return image;
+}
+
+bool WritePNG(const std::string& path, const Image& image) {
+    // FragmentQuad 的 grade(): 最大通道超过 1 时向 x / (x + 1) 压一半，然后截断量化 (行翻转为从上到下)
+    std::vector<unsigned char> pixels((size_t)image.width * image.height * 3);
+    for (int y = 0; y < image.height; y++) {
+        const float*   src = &image.rgb[(size_t)(image.height - 1 - y) * image.width * 3];
+        unsigned char* dst = &pixels[(size_t)y * image.width * 3];
+        for (int x = 0; x < image.width; x++) {
+            const float* c    = src + x * 3;
+            float        k    = std::max(std::max(c[0], c[1]), c[2]) >= 1.0f ? 0.5f : 0.0f;
+            for (int ch = 0; ch < 3; ch++) {
+                float v         = c[ch] + (c[ch] / (c[ch] + 1.0f) - c[ch]) * k;
+                dst[x * 3 + ch] = (unsigned char)(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+    }
+    return stbi_write_png(path.c_str(), image.width, image.height, 3, pixels.data(), image.width * 3) != 0;
+}
+
+bool WriteEXR(const std::string& path, const Image& image) {
+    // float → half (截断尾数，超出范围饱和为无穷大，过小的数冲刷为 0)
+    auto toHalf = [](float f) {
+        uint32_t x;
+        std::memcpy(&x, &f, sizeof(x));
+        uint16_t sign = (uint16_t)((x >> 16) & 0x8000u);
+        int      exp  = (int)((x >> 23) & 0xFFu) - 127 + 15;
+        if (exp <= 0) {
+            return sign;
+        }
+        if (exp >= 31) {
+            return (uint16_t)(sign | 0x7C00u);
+        }
+        return (uint16_t)(sign | (exp << 10) | ((x >> 13) & 0x3FFu));
+    };
+
+    std::vector<char> header;
+    auto              put = [&](const void* data, size_t size) {
+        header.insert(header.end(), (const char*)data, (const char*)data + size);
+    };
+    auto putInt = [&](int32_t v) { put(&v, 4); };
+    auto attribute = [&](const char* name, const char* type, int32_t size) {
+        put(name, strlen(name) + 1);
+        put(type, strlen(type) + 1);
+        putInt(size);
+    };
+
+    // 单部分扫描线文件，版本 2；通道按名称排序 (B, G, R)，每个通道 HALF、不采样
+    putInt(20000630);
+    putInt(2);
+    attribute("channels", "chlist", 3 * 18 + 1);
+    for (const char* channel : {"B", "G", "R"}) {
+        put(channel, 2);
+        putInt(1); // HALF
+        putInt(0); // pLinear + 保留字节
+        putInt(1); // xSampling
+        putInt(1); // ySampling
+    }
+    header.push_back(0);
+    attribute("compression", "compression", 1);
+    header.push_back(0); // NO_COMPRESSION
+    int32_t window[4] = {0, 0, image.width - 1, image.height - 1};
+    attribute("dataWindow", "box2i", 16);
+    put(window, 16);
+    attribute("displayWindow", "box2i", 16);
+    put(window, 16);
+    attribute("lineOrder", "lineOrder", 1);
+    header.push_back(0); // INCREASING_Y
+    float aspect = 1.0f, center[2] = {0.0f, 0.0f}, width = 1.0f;
+    attribute("pixelAspectRatio", "float", 4);
+    put(&aspect, 4);
+    attribute("screenWindowCenter", "v2f", 8);
+    put(center, 8);
+    attribute("screenWindowWidth", "float", 4);
+    put(&width, 4);
+    header.push_back(0);
+
+    // 偏移表 (每行一个块) + 扫描线: y, 字节数, 各通道一整行 half
+    const int32_t lineBytes = image.width * 3 * 2;
+    uint64_t      offset    = header.size() + (uint64_t)image.height * 8;
+    for (int y = 0; y < image.height; y++) {
+        put(&offset, 8);
+        offset += 8 + lineBytes;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(header.data(), header.size());
+    std::vector<uint16_t> line((size_t)image.width * 3);
+    for (int y = 0; y < image.height; y++) {
+        // EXR 的 y 向下增长，图像行从下到上存放
+        const float* src = &image.rgb[(size_t)(image.height - 1 - y) * image.width * 3];
+        for (int x = 0; x < image.width; x++) {
+            line[x]                   = toHalf(src[x * 3 + 2]);
+            line[image.width + x]     = toHalf(src[x * 3 + 1]);
+            line[image.width * 2 + x] = toHalf(src[x * 3 + 0]);
+        }
+        file.write((const char*)&y, 4);
+        file.write((const char*)&lineBytes, 4);
+        file.write((const char*)line.data(), lineBytes);
+    }
+    return (bool)file;
+}
+
+bool RenderToFile(const std::string& path, const SceneParams& params, const View& view) {
+    auto  start = std::chrono::steady_clock::now();
+    Scene scene = BuildScene(params);
+    std::cout << "[SoftRenderer] Scene: " << scene.particles.size() << " particles (seed " << params.particleSeed
+              << "), " << scene.stars.size() / StarField::kFloatsPerStar << " stars, " << scene.planets.size()
+              << " planets in " << std::fixed << std::setprecision(1) << MsSince(start) << " ms" << std::endl;
+
+    auto  renderStart = std::chrono::steady_clock::now();
+    Image image       = Render(scene, view);
+    std::cout << "[SoftRenderer] Rendered " << image.width << "x" << image.height << " at t=" << view.time << " in "
+              << MsSince(renderStart) << " ms (" << ResolveThreads(0) << " threads)" << std::defaultfloat
+              << std::endl;
+
+    bool exr = path.size() >= 4 && (path.compare(path.size() - 4, 4, ".exr") == 0 ||
+                                    path.compare(path.size() - 4, 4, ".EXR") == 0);
+    bool ok  = exr ? WriteEXR(path, image) : WritePNG(path, image);
+    std::cout << "[SoftRenderer] " << (ok ? "Wrote " : "Failed to write ") << path << std::endl;
+    return ok;
+}
+
+bool CompareImages(const std::string& pathA, const std::string& pathB, const DiffOptions& options,
+                   DiffResult* result) {
+    int            wa = 0, ha = 0, wb = 0, hb = 0, channels = 0;
+    unsigned char* a  = stbi_load(pathA.c_str(), &wa, &ha, &channels, 3);
+    unsigned char* b  = stbi_load(pathB.c_str(), &wb, &hb, &channels, 3);
+    DiffResult     r;
+    bool           pass = false;
+
+    if (!a || !b) {
+        std::cout << "[SoftRenderer] Diff: failed to load " << (!a ? pathA : pathB) << std::endl;
+    } else if (wa != wb || ha != hb) {
+        std::cout << "[SoftRenderer] Diff: size mismatch " << wa << "x" << ha << " vs " << wb << "x" << hb
+                  << std::endl;
+    } else {
+        r.width  = wa;
+        r.height = ha;
+        std::vector<unsigned char> heat(options.diffImage.empty() ? 0 : (size_t)wa * ha * 3);
+        uint64_t                   sum = 0;
+        for (size_t i = 0; i < (size_t)wa * ha; i++) {
+            int err = 0;
+            for (int ch = 0; ch < 3; ch++) {
+                err = std::max(err, std::abs((int)a[i * 3 + ch] - (int)b[i * 3 + ch]));
+            }
+            sum += err;
+            r.maxError = std::max(r.maxError, err);
+            if (err > options.tolerance) {
+                r.badPixels++;
+            }
+            // 热图: 超出容差的像素标红，其余按误差放大显示为灰度
+            if (!heat.empty()) {
+                unsigned char g = (unsigned char)std::min(255, err * 16);
+                heat[i * 3 + 0] = err > options.tolerance ? 255 : g;
+                heat[i * 3 + 1] = err > options.tolerance ? 0 : g;
+                heat[i * 3 + 2] = err > options.tolerance ? 0 : g;
+            }
+        }
+        r.meanError = (double)sum / ((double)wa * ha);
+        pass        = r.badPixels <= (uint64_t)(options.maxBadFraction * wa * ha);
+        if (!heat.empty()) {
+            stbi_write_png(options.diffImage.c_str(), wa, ha, 3, heat.data(), wa * 3);
+        }
+        std::cout << "[SoftRenderer] Diff " << pathA << " vs " << pathB << ": max " << r.maxError << ", mean "
+                  << std::fixed << std::setprecision(3) << r.meanError << ", " << r.badPixels << " pixels over "
+                  << options.tolerance << " (" << 100.0 * r.badPixels / ((double)wa * ha) << "%, limit "
+                  << 100.0 * options.maxBadFraction << "%) -> " << (pass ? "PASS" : "FAIL") << std::defaultfloat
+                  << std::endl;
+    }
+
+    stbi_image_free(a);
+    stbi_image_free(b);
+    if (result) {
+        *result = r;
+    }
+    return pass;
+}
+
+} // namespace SoftRenderer
@@ -0,0 +1,89 @@
+#pragma once
+// CPU 软件渲染器 - 不需要 GPU 的参考渲染 (构建机上的无头预览和基准图像回归测试)
+// 星空、土星粒子 (VertexSaturn / FragmentSaturn 的点径、着色和加法混合) 与行星 (光线求交) 全部在 CPU 上计算
+// 屏幕按分块划分，点按 (分块, 线程) 直方图做计数排序，各线程独立光栅化整块，像素混合用 SSE
+// 每个分块内按粒子序号顺序累加，结果与线程数无关，可以直接逐像素比较
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ParticleSystem.h" // GPUParticle, MAX_PARTICLES, STAR_COUNT
+#include "Utils.h"          // PlanetData, ParallelFor
+
+namespace SoftRenderer {
+
+static constexpr int kTileSize = 64; // 分块边长 (像素)，一块的累加缓冲 64 KB，留在 L2 中
+
+// 场景规模 (与命令行 --stars / --planets / --seed 对应)
+struct SceneParams {
+    uint32_t particleCount = MAX_PARTICLES;
+    uint32_t particleSeed  = 1;
+    uint32_t starCount     = STAR_COUNT;
+    uint32_t planetCount   = PlanetConstants::kPlanetCount;
+};
+
+// 渲染输入 (纯 CPU 数据)
+struct Scene {
+    std::vector<GPUParticle>   particles;
+    std::vector<float>         stars; // StarField::kFloatsPerStar 个 float 一颗星
+    std::vector<PlanetData>    planets;
+    std::vector<unsigned char> fbm; // 行星表面噪声 (R8)
+    int                        fbmWidth = 0, fbmHeight = 0;
+};
+
+// 相机与动画状态，默认值与启动后第一帧一致
+struct View {
+    int   width       = 1920;
+    int   height      = 1080;
+    float time        = 0.0f; // 秒: 粒子公转、混沌效果、星星闪烁、行星自转
+    float scale       = 1.0f; // SmoothState
+    float rotX        = 0.4f;
+    float rotY        = 0.0f;
+    float densityComp = 0.6f; // 满粒子数时的密度补偿
+};
+
+// 线性 HDR 图像 (RGB float，行从下到上，与 OpenGL 一致)
+struct Image {
+    int                width = 0, height = 0;
+    std::vector<float> rgb;
+};
+
+// 图像比较的容差
+struct DiffOptions {
+    int         tolerance      = 8;     // 单通道允许的最大差值 (8 位色阶)
+    double      maxBadFraction = 0.001; // 超出容差的像素比例上限
+    std::string diffImage;              // 非空时输出误差热图 (PNG)
+};
+
+struct DiffResult {
+    int      width = 0, height = 0;
+    int      maxError  = 0;
+    double   meanError = 0.0;
+    uint64_t badPixels = 0;
+};
+
+// 生成粒子初始状态 (与 ComputeInitSaturn 的随机数序列和分布一致)
+// threads: 工作线程数，0 表示使用全部硬件线程
+void GenerateParticles(uint32_t count, uint32_t seed, std::vector<GPUParticle>& out, int threads = 0);
+
+// 生成整个场景 (粒子、星空、行星、噪声纹理)，使用与 GPU 路径启动时相同的生成函数
+Scene BuildScene(const SceneParams& params, int threads = 0);
+
+// 渲染一帧: 星空 (含闪烁) + 土星粒子 + 行星，粒子按 view.time 推进公转 (无手势时的转速)
+Image Render(const Scene& scene, const View& view, int threads = 0);
+
+// PNG: 经过与 FragmentQuad 相同的高光压缩后量化为 8 位 RGB
+bool WritePNG(const std::string& path, const Image& image);
+
+// OpenEXR: 线性 HDR，half RGB，不压缩
+bool WriteEXR(const std::string& path, const Image& image);
+
+// --render-cpu: 生成场景、渲染并按扩展名 (.exr / 其他为 PNG) 写出，返回是否成功
+bool RenderToFile(const std::string& path, const SceneParams& params, const View& view);
+
+// --image-diff: 逐像素比较两张 PNG，返回是否在容差内 (尺寸不同直接失败)，结果输出到日志
+bool CompareImages(const std::string& pathA, const std::string& pathB, const DiffOptions& options,
+                   DiffResult* result = nullptr);
+
+} // namespace SoftRenderer
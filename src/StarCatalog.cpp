@@ -0,0 +1,422 @@
+// StarCatalog.cpp - 二进制星表转换与内存映射加载
+
+#include "pch.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "StarCatalog.h"
+#include "Utils.h" // ParallelFor
+
+namespace StarCatalog {
+
+static const float kColorMin = -0.4f; // B-V 量化范围
+static const float kColorMax = 2.0f;
+
+// ============================================================================
+// 编码 / 解码
+// ============================================================================
+
+static inline float SignNotZero(float v) {
+    return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+// 八面体编码: 单位向量 → 两个 16 位分量 (以 y 轴为折叠轴，最大误差约 0.003 度)
+static void OctEncode(const glm::vec3& n, uint16_t& outX, uint16_t& outY) {
+    float invL1 = 1.0f / (fabsf(n.x) + fabsf(n.y) + fabsf(n.z));
+    float px    = n.x * invL1;
+    float pz    = n.z * invL1;
+    if (n.y < 0.0f) {
+        float fx = (1.0f - fabsf(pz)) * SignNotZero(px);
+        float fz = (1.0f - fabsf(px)) * SignNotZero(pz);
+        px       = fx;
+        pz       = fz;
+    }
+    outX = (uint16_t)lroundf((px * 0.5f + 0.5f) * 65535.0f);
+    outY = (uint16_t)lroundf((pz * 0.5f + 0.5f) * 65535.0f);
+}
+
+static inline glm::vec3 OctDecode(uint16_t qx, uint16_t qy) {
+    float     px = qx * (2.0f / 65535.0f) - 1.0f;
+    float     pz = qy * (2.0f / 65535.0f) - 1.0f;
+    glm::vec3 n(px, 1.0f - fabsf(px) - fabsf(pz), pz);
+    float     t = std::max(-n.y, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.z += n.z >= 0.0f ? -t : t;
+    return n * (1.0f / sqrtf(n.x * n.x + n.y * n.y + n.z * n.z));
+}
+
+// B-V 色指数 → 颜色: Ballesteros 公式求色温，再用黑体近似求 RGB
+static glm::vec3 ColorFromBV(float bv) {
+    float T = 4600.0f * (1.0f / (0.92f * bv + 1.7f) + 1.0f / (0.92f * bv + 0.62f));
+    float t = T / 100.0f;
+    float r, g, b;
+    if (t <= 66.0f) {
+        r = 1.0f;
+        g = 0.3900816f * logf(t) - 0.6318414f;
+        b = t <= 19.0f ? 0.0f : 0.5432068f * logf(t - 10.0f) - 1.1962541f;
+    } else {
+        r = 1.2929362f * powf(t - 60.0f, -0.1332047f);
+        g = 1.1298909f * powf(t - 60.0f, -0.0755148f);
+        b = 1.0f;
+    }
+    // 整体亮度与随机星空的调色板一致
+    return glm::vec3(std::clamp(r, 0.0f, 1.0f), std::clamp(g, 0.0f, 1.0f), std::clamp(b, 0.0f, 1.0f)) * 0.85f;
+}
+
+// ============================================================================
+// CSV 转换
+// ============================================================================
+
+struct RawStar {
+    glm::vec3 dir;  // 场景坐标系方向 (y 轴指向北天极)
+    float     dist; // 秒差距，未知为 -1
+    float     bv;
+    float     mag;
+};
+
+static std::vector<std::string> SplitCSV(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string              field;
+    bool                     quoted = false;
+    for (char ch : line) {
+        if (ch == '"') {
+            quoted = !quoted;
+        } else if (ch == ',' && !quoted) {
+            fields.push_back(std::move(field));
+            field.clear();
+        } else if (ch != '\r') {
+            field += ch;
+        }
+    }
+    fields.push_back(std::move(field));
+    return fields;
+}
+
+static bool ParseField(const std::vector<std::string>& fields, int column, double& out) {
+    if (column < 0 || column >= (int)fields.size() || fields[column].empty()) {
+        return false;
+    }
+    const char* begin = fields[column].c_str();
+    char*       end   = nullptr;
+    out               = strtod(begin, &end);
+    return end != begin;
+}
+
+bool Convert(const std::string& csvPath, const std::string& outPath) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::ifstream in(csvPath);
+    std::string   line;
+    if (!in.is_open() || !std::getline(in, line)) {
+        std::cerr << "[StarCatalog] Cannot read " << csvPath << std::endl;
+        return false;
+    }
+
+    // 按列名查找 (不区分大小写)
+    std::vector<std::string> columns = SplitCSV(line);
+    for (std::string& name : columns) {
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)tolower(c); });
+    }
+    auto find = [&](std::initializer_list<const char*> names) {
+        for (const char* name : names) {
+            auto it = std::find(columns.begin(), columns.end(), name);
+            if (it != columns.end()) {
+                return (int)(it - columns.begin());
+            }
+        }
+        return -1;
+    };
+    int colX = find({"x"}), colY = find({"y"}), colZ = find({"z"});
+    int colRaRad = find({"rarad"}), colDecRad = find({"decrad"});
+    int colRa = find({"ra", "ra_deg"}), colDec = find({"dec", "dec_deg"});
+    int colMag = find({"mag", "vmag", "phot_g_mean_mag"});
+    int colBV = find({"ci", "bv", "b_v"}), colBpRp = find({"bp_rp"});
+    int colDist = find({"dist", "distance"}), colPlx = find({"parallax", "plx"});
+
+    bool hasXYZ    = colX >= 0 && colY >= 0 && colZ >= 0;
+    bool hasRadian = colRaRad >= 0 && colDecRad >= 0;
+    bool hasDegree = colRa >= 0 && colDec >= 0;
+    if (colMag < 0 || (!hasXYZ && !hasRadian && !hasDegree)) {
+        std::cerr << "[StarCatalog] " << csvPath << ": need a magnitude column and x/y/z, rarad/decrad or ra/dec"
+                  << std::endl;
+        return false;
+    }
+
+    std::vector<RawStar> raw;
+    size_t               skipped = 0;
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields = SplitCSV(line);
+        double                   mag, a, b, c;
+        if (!ParseField(fields, colMag, mag)) {
+            skipped++;
+            continue;
+        }
+
+        // 赤道直角坐标 (x 指向春分点，z 指向北天极)
+        glm::vec3 eq;
+        double    dist = -1.0;
+        if (hasXYZ && ParseField(fields, colX, a) && ParseField(fields, colY, b) && ParseField(fields, colZ, c)) {
+            eq   = glm::vec3((float)a, (float)b, (float)c);
+            dist = sqrt(a * a + b * b + c * c);
+        } else if ((hasRadian && ParseField(fields, colRaRad, a) && ParseField(fields, colDecRad, b)) ||
+                   (hasDegree && ParseField(fields, colRa, a) && ParseField(fields, colDec, b))) {
+            if (!hasRadian) {
+                a *= 0.017453292519943295;
+                b *= 0.017453292519943295;
+            }
+            eq = glm::vec3((float)(cos(b) * cos(a)), (float)(cos(b) * sin(a)), (float)sin(b));
+        } else {
+            skipped++;
+            continue;
+        }
+        if (ParseField(fields, colDist, a)) {
+            dist = a;
+        } else if (ParseField(fields, colPlx, a) && a > 0.0) {
+            dist = 1000.0 / a; // 视差 (毫角秒) → 秒差距
+        }
+
+        // 跳过太阳 (距离为 0) 和无效方向
+        float len = sqrtf(eq.x * eq.x + eq.y * eq.y + eq.z * eq.z);
+        if (dist == 0.0 || len < 1e-9f) {
+            skipped++;
+            continue;
+        }
+
+        RawStar star;
+        star.dir  = glm::vec3(eq.x, eq.z, -eq.y) * (1.0f / len); // 场景 y 轴朝上
+        star.dist = (dist > 0.0 && dist < 100000.0) ? (float)dist : -1.0f; // HYG 用 100000 表示未知
+        star.mag  = (float)mag;
+        star.bv   = 0.65f; // 缺失时按类太阳恒星处理
+        if (ParseField(fields, colBV, a)) {
+            star.bv = (float)a;
+        } else if (ParseField(fields, colBpRp, a)) {
+            star.bv = (float)(0.77 * a - 0.03); // Gaia BP-RP 的线性近似
+        }
+        raw.push_back(star);
+    }
+    if (raw.empty()) {
+        std::cerr << "[StarCatalog] " << csvPath << ": no usable rows" << std::endl;
+        return false;
+    }
+
+    // 量化范围
+    float magMin = 1e9f, magMax = -1e9f, logMin = 1e9f, logMax = -1e9f;
+    for (const RawStar& s : raw) {
+        magMin = std::min(magMin, s.mag);
+        magMax = std::max(magMax, s.mag);
+        if (s.dist > 0.0f) {
+            logMin = std::min(logMin, log10f(s.dist));
+            logMax = std::max(logMax, log10f(s.dist));
+        }
+    }
+    magMax = std::max(magMax, magMin + 0.1f);
+
+    StarField::Params sceneParams; // 与随机星空相同的半径范围
+    FileHeader        header = {};
+    memcpy(header.magic, "PSKY", 4);
+    header.version   = kFileVersion;
+    header.count     = (uint32_t)raw.size();
+    header.bands     = StarField::kBands;
+    header.segments  = StarField::kSegments;
+    header.levels    = StarField::kLevels;
+    header.minRadius = sceneParams.minRadius;
+    header.maxRadius = sceneParams.maxRadius;
+    header.magMin    = magMin;
+    header.magMax    = magMax;
+
+    // 量化并按 (天区, 星等) 排序，同星等保持原顺序
+    std::vector<PackedStar>                    packed(raw.size());
+    std::vector<std::pair<uint32_t, uint32_t>> order(raw.size());
+    for (size_t i = 0; i < raw.size(); i++) {
+        const RawStar& s = raw[i];
+        PackedStar&    p = packed[i];
+        OctEncode(s.dir, p.octX, p.octY);
+        float distance = (s.dist > 0.0f && logMax > logMin) ? (log10f(s.dist) - logMin) / (logMax - logMin) : 1.0f;
+        float color    = (std::clamp(s.bv, kColorMin, kColorMax) - kColorMin) / (kColorMax - kColorMin);
+        p.distance     = (uint8_t)lroundf(distance * 255.0f);
+        p.colorIndex   = (uint8_t)lroundf(color * 255.0f);
+        p.magnitude    = (uint8_t)lroundf((s.mag - magMin) / (magMax - magMin) * 255.0f);
+        p.reserved     = 0;
+        order[i]       = {(StarField::CellOf(s.dir) << 8) | p.magnitude, (uint32_t)i};
+    }
+    std::sort(order.begin(), order.end());
+
+    // 天区索引表: 星等高 6 位即亮度等级 (256 / kLevels = 4)
+    static_assert(256 / StarField::kLevels == 4, "magnitude quantization must map onto kLevels");
+    std::vector<uint32_t> cellFirst(StarField::kCells, 0);
+    std::vector<uint32_t> cellLevels((size_t)StarField::kCells * StarField::kLevels, 0);
+    std::vector<uint32_t> levelCounts((size_t)StarField::kCells * StarField::kLevels, 0);
+    for (const auto& entry : order) {
+        levelCounts[(entry.first >> 8) * StarField::kLevels + ((entry.first & 0xFF) >> 2)]++;
+    }
+    uint32_t running = 0;
+    for (int c = 0; c < StarField::kCells; c++) {
+        cellFirst[c]    = running;
+        uint32_t inCell = 0;
+        for (int L = 0; L < StarField::kLevels; L++) {
+            inCell += levelCounts[c * StarField::kLevels + L];
+            cellLevels[c * StarField::kLevels + L] = inCell;
+        }
+        running += inCell;
+    }
+
+    std::vector<PackedStar> sorted(packed.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        sorted[i] = packed[order[i].second];
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (out.is_open()) {
+        out.write((const char*)&header, sizeof(header));
+        out.write((const char*)cellFirst.data(), cellFirst.size() * sizeof(uint32_t));
+        out.write((const char*)cellLevels.data(), cellLevels.size() * sizeof(uint32_t));
+        out.write((const char*)sorted.data(), sorted.size() * sizeof(PackedStar));
+    }
+    if (!out) {
+        std::cerr << "[StarCatalog] Cannot write " << outPath << std::endl;
+        return false;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "[StarCatalog] " << csvPath << " -> " << outPath << ": " << header.count << " stars (" << skipped
+              << " rows skipped), mag " << magMin << " ~ " << magMax << ", " << ((size_t)out.tellp() >> 10)
+              << " KB, " << ms << " ms" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// 运行时加载
+// ============================================================================
+
+bool Catalog::Open(const std::string& path) {
+    Close();
+    const unsigned char* data = nullptr;
+    size_t               size = 0;
+
+#ifdef _WIN32
+    // 只读映射: 页面按需调入，顺序扫描提示让系统提前预读
+    HANDLE file = CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "[StarCatalog] Cannot open " << path << std::endl;
+        return false;
+    }
+    fileHandle             = file;
+    LARGE_INTEGER fileSize = {};
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        view          = mappingHandle ? MapViewOfFile((HANDLE)mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    }
+    if (!view) {
+        std::cerr << "[StarCatalog] Cannot map " << path << " (error " << GetLastError() << ")" << std::endl;
+        Close();
+        return false;
+    }
+    data = (const unsigned char*)view;
+    size = (size_t)fileSize.QuadPart;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        std::cerr << "[StarCatalog] Cannot open " << path << std::endl;
+        return false;
+    }
+    buffer.resize((size_t)in.tellg());
+    in.seekg(0);
+    in.read((char*)buffer.data(), buffer.size());
+    data = buffer.data();
+    size = buffer.size();
+#endif
+
+    // 校验文件头和长度
+    const size_t      tableSize = ((size_t)StarField::kCells + (size_t)StarField::kCells * StarField::kLevels) * 4;
+    const FileHeader* h         = (const FileHeader*)data;
+    if (size < sizeof(FileHeader) || memcmp(h->magic, "PSKY", 4) != 0 || h->version != kFileVersion ||
+        h->bands != StarField::kBands || h->segments != StarField::kSegments || h->levels != StarField::kLevels ||
+        h->count == 0 || size != sizeof(FileHeader) + tableSize + (size_t)h->count * sizeof(PackedStar)) {
+        std::cerr << "[StarCatalog] " << path << ": not a valid v" << kFileVersion << " sky file" << std::endl;
+        Close();
+        return false;
+    }
+
+    header    = h;
+    cellTable = (const uint32_t*)(data + sizeof(FileHeader));
+    stars     = (const PackedStar*)(data + sizeof(FileHeader) + tableSize);
+    std::cout << "[StarCatalog] " << path << ": " << h->count << " stars, mag " << h->magMin << " ~ " << h->magMax
+              << std::endl;
+    return true;
+}
+
+void Catalog::Close() {
+#ifdef _WIN32
+    if (view) {
+        UnmapViewOfFile(view);
+    }
+    if (mappingHandle) {
+        CloseHandle((HANDLE)mappingHandle);
+    }
+    if (fileHandle) {
+        CloseHandle((HANDLE)fileHandle);
+    }
+#endif
+    view          = nullptr;
+    mappingHandle = nullptr;
+    fileHandle    = nullptr;
+    buffer        = {};
+    header        = nullptr;
+    cellTable     = nullptr;
+    stars         = nullptr;
+}
+
+void Catalog::Decode(float* dst, StarField::SkyIndex* index, int threads) const {
+    if (!dst || !IsOpen()) {
+        return;
+    }
+
+    // 每个量化值对应的半径、颜色和点大小查表 (点大小只由星等决定，乘以半径抵消着色器的距离衰减)
+    float     radiusLUT[256], sizeLUT[256];
+    glm::vec3 colorLUT[256];
+    for (int q = 0; q < 256; q++) {
+        float t      = q / 255.0f;
+        radiusLUT[q] = header->minRadius + t * (header->maxRadius - header->minRadius);
+        colorLUT[q]  = ColorFromBV(kColorMin + t * (kColorMax - kColorMin));
+        sizeLUT[q]   = (1.0f + 5.0f * powf(1.0f - t, 1.5f)) / 1000.0f;
+    }
+
+    uint32_t count = header->count;
+    if (threads <= 0) {
+        threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = (int)std::min((uint32_t)threads, std::max(1u, count / 16384));
+    ParallelFor(count, threads, [&](uint32_t begin, uint32_t end, int) {
+        float* out = dst + (size_t)begin * StarField::kFloatsPerStar;
+        for (uint32_t i = begin; i < end; i++) {
+            const PackedStar& p = stars[i];
+            glm::vec3         d = OctDecode(p.octX, p.octY);
+            float             r = radiusLUT[p.distance];
+            const glm::vec3&  c = colorLUT[p.colorIndex];
+            out[0]              = d.x * r;
+            out[1]              = d.y * r;
+            out[2]              = d.z * r;
+            out[3]              = c.x;
+            out[4]              = c.y;
+            out[5]              = c.z;
+            out[6]              = sizeLUT[p.magnitude] * r;
+            out += StarField::kFloatsPerStar;
+        }
+    });
+
+    if (index) {
+        index->cellFirst.assign(cellTable, cellTable + StarField::kCells);
+        index->cellLevels.assign(cellTable + StarField::kCells,
+                                 cellTable + StarField::kCells + (size_t)StarField::kCells * StarField::kLevels);
+        index->minRadius = header->minRadius;
+        StarField::BuildCellBounds(*index);
+    }
+}
+
+} // namespace StarCatalog
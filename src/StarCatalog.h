@@ -0,0 +1,69 @@
+#pragma once
+// 星表 - 离线把 CSV 星表 (HYG / Gaia 子集) 转换为紧凑二进制天空格式 (.psky)
+// 文件内星星已按 (天区, 亮度) 排序并附带天区索引表，运行时内存映射后直接解码进星空缓冲，无需解析或排序
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "StarField.h"
+
+namespace StarCatalog {
+
+static const uint32_t kFileVersion = 1;
+
+#pragma pack(push, 1)
+// 文件头，之后依次为 cellFirst[kCells]、cellLevels[kCells * kLevels] (uint32) 和 PackedStar[count]
+struct FileHeader {
+    char     magic[4]; // "PSKY"
+    uint32_t version;
+    uint32_t count;
+    uint16_t bands, segments, levels, reserved; // 天区划分，须与 StarField 一致
+    float    minRadius, maxRadius;              // 场景中的星空半径范围
+    float    magMin, magMax;                    // 星等量化范围
+};
+
+// 每颗星 8 字节 (浮点顶点为 28 字节)
+struct PackedStar {
+    uint16_t octX, octY; // 八面体编码方向
+    uint8_t  distance;   // 对数距离，映射到 [minRadius, maxRadius]
+    uint8_t  colorIndex; // B-V 色指数，[-0.4, 2.0] 量化
+    uint8_t  magnitude;  // 视星等，[magMin, magMax] 量化 (0 最亮，高 6 位即亮度等级)
+    uint8_t  reserved;
+};
+#pragma pack(pop)
+
+// 离线转换 CSV 星表 (--convert-catalog <in.csv> <out.psky>)
+// 按列名识别: x/y/z (秒差距) 或 rarad/decrad 或 ra/dec (度)；mag / phot_g_mean_mag；ci / bp_rp；dist / parallax
+bool Convert(const std::string& csvPath, const std::string& outPath);
+
+// 内存映射的二进制星表
+class Catalog {
+  public:
+    Catalog() = default;
+    ~Catalog() { Close(); }
+    Catalog(const Catalog&)            = delete;
+    Catalog& operator=(const Catalog&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool     IsOpen() const { return stars != nullptr; }
+    uint32_t GetCount() const { return header ? header->count : 0; }
+
+    // 解码到星空顶点 (count * StarField::kFloatsPerStar 个 float) 并填充天区索引
+    // 纯 CPU，可在工作线程调用；threads 为 0 时使用全部硬件线程
+    void Decode(float* dst, StarField::SkyIndex* index, int threads = 0) const;
+
+  private:
+    const FileHeader* header    = nullptr;
+    const uint32_t*   cellTable = nullptr;
+    const PackedStar* stars     = nullptr;
+
+    void*                      fileHandle    = nullptr; // Windows: 文件和映射句柄
+    void*                      mappingHandle = nullptr;
+    const void*                view          = nullptr;
+    std::vector<unsigned char> buffer; // 非 Windows 平台: 整体读入内存
+};
+
+} // namespace StarCatalog
@@ -0,0 +1,354 @@
+// StarField.cpp - 星空生成实现
+
+#include "pch.h"
+
+#include <cmath>
+#include <thread>
+
+#include "StarField.h"
+#include "Utils.h" // HexToRGB, ParallelFor
+
+namespace StarField {
+
+// 计数器 RNG (SplitMix64 终结器): 无内部状态，任意序号可独立计算，天然适合并行
+static inline float Uniform(uint64_t key, uint64_t counter) {
+    uint64_t z = key + counter * 0x9E3779B97F4A7C15ull;
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (float)(z >> 40) * (1.0f / 16777216.0f); // 24 位精度 [0, 1)
+}
+
+static const float TWO_PI = 6.2831853f;
+
+// 单颗星的随机属性 (只由种子和序号决定)
+struct StarSample {
+    float    r, th, cosPh, size;
+    uint32_t cell;  // 天区
+    uint32_t level; // 亮度等级 (0 最亮)
+};
+
+class Sampler {
+  public:
+    explicit Sampler(const Params& params)
+        : key((uint64_t)params.seed * 0xD1B54A32D192ED03ull + 0x2545F4914F6CDD1Dull), minRadius(params.minRadius),
+          radiusSpan(params.maxRadius - params.minRadius) {
+        // 亮度以屏幕点大小贡献 (size / r) 的对数分级，范围由参数推出
+        logMax   = log2f(4.0f / params.minRadius);
+        logScale = kLevels / (logMax - log2f(1.0f / params.maxRadius));
+    }
+
+    StarSample Sample(uint32_t i) const {
+        // 每颗星使用 4 个随机数: 半径、方位角、极角余弦、大小
+        uint64_t   counter = (uint64_t)i * 4;
+        float      u1      = Uniform(key, counter + 1);
+        float      u2      = Uniform(key, counter + 2);
+        StarSample s;
+        s.r     = minRadius + Uniform(key, counter + 0) * radiusSpan;
+        s.th    = u1 * TWO_PI;
+        s.cosPh = 2.0f * u2 - 1.0f; // 球面均匀分布
+        s.size  = 1.0f + Uniform(key, counter + 3) * 3.0f;
+
+        // 天区: y 轴 (极轴) 方向等分条带 × 方位角等分，球面上等面积
+        uint32_t band  = std::min((uint32_t)(u2 * kBands), (uint32_t)kBands - 1);
+        uint32_t seg   = std::min((uint32_t)(u1 * kSegments), (uint32_t)kSegments - 1);
+        float    level = (logMax - log2f(s.size / s.r)) * logScale;
+        s.cell         = band * kSegments + seg;
+        s.level        = (uint32_t)std::clamp(level, 0.0f, (float)(kLevels - 1));
+        return s;
+    }
+
+  private:
+    uint64_t key;
+    float    minRadius, radiusSpan;
+    float    logMax, logScale;
+};
+
+// 写入一颗星 (映射内存通常是写合并内存，按顺序写、不回读)
+static inline void WriteStar(float* out, const StarSample& s, uint32_t i) {
+    static const glm::vec3 palette[4] = {HexToRGB(0xE3DAC5), HexToRGB(0xC9A070), HexToRGB(0xE3DAC5),
+                                         HexToRGB(0xB08D55)};
+    float                  sinPh      = sqrtf(std::max(0.0f, 1.0f - s.cosPh * s.cosPh));
+    const glm::vec3&       c          = palette[i % 4];
+    out[0]                            = s.r * sinPh * cosf(s.th);
+    out[1]                            = s.r * s.cosPh;
+    out[2]                            = s.r * sinPh * sinf(s.th);
+    out[3]                            = c.x;
+    out[4]                            = c.y;
+    out[5]                            = c.z;
+    out[6]                            = s.size;
+}
+
+uint32_t CellOf(const glm::vec3& dir) {
+    float    phi  = atan2f(dir.z, dir.x);
+    float    u1   = (phi < 0.0f ? phi + TWO_PI : phi) / TWO_PI;
+    float    u2   = (std::clamp(dir.y, -1.0f, 1.0f) + 1.0f) * 0.5f;
+    uint32_t band = std::min((uint32_t)(u2 * kBands), (uint32_t)kBands - 1);
+    uint32_t seg  = std::min((uint32_t)(u1 * kSegments), (uint32_t)kSegments - 1);
+    return band * kSegments + seg;
+}
+
+// 天区角半径取边界上 3x3 个采样点到中心的最大夹角
+void BuildCellBounds(SkyIndex& index) {
+    auto dirOf = [](float y, float phi) {
+        float s = sqrtf(std::max(0.0f, 1.0f - y * y));
+        return glm::vec3(s * cosf(phi), y, s * sinf(phi));
+    };
+    index.cellDir.resize(kCells);
+    index.cellRadius.resize(kCells);
+    for (int band = 0; band < kBands; band++) {
+        for (int seg = 0; seg < kSegments; seg++) {
+            int       c      = band * kSegments + seg;
+            float     y0     = (float)band / kBands * 2.0f - 1.0f;
+            float     y1     = (float)(band + 1) / kBands * 2.0f - 1.0f;
+            float     phi0   = (float)seg / kSegments * TWO_PI;
+            float     phi1   = (float)(seg + 1) / kSegments * TWO_PI;
+            glm::vec3 center = dirOf((y0 + y1) * 0.5f, (phi0 + phi1) * 0.5f);
+            float     minCos = 1.0f;
+            for (int i = 0; i <= 2; i++) {
+                for (int j = 0; j <= 2; j++) {
+                    glm::vec3 p = dirOf(y0 + (y1 - y0) * i * 0.5f, phi0 + (phi1 - phi0) * j * 0.5f);
+                    minCos      = std::min(minCos, glm::dot(center, p));
+                }
+            }
+            index.cellDir[c]    = center;
+            index.cellRadius[c] = acosf(std::clamp(minCos, -1.0f, 1.0f));
+        }
+    }
+}
+
+void Generate(const Params& params, float* dst, SkyIndex* index, int threads) {
+    if (!dst || params.count == 0) {
+        return;
+    }
+    if (threads <= 0) {
+        threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    }
+    // 每个线程至少处理 16K 颗星，少量星星时不值得开线程
+    uint32_t maxThreads = std::max(1u, params.count / 16384);
+    threads             = (int)std::min((uint32_t)threads, maxThreads);
+
+    const uint32_t n = params.count;
+    Sampler        sampler(params);
+
+    if (!index) {
+        ParallelFor(n, threads, [&](uint32_t begin, uint32_t end, int) {
+            for (uint32_t i = begin; i < end; i++) {
+                WriteStar(dst + (size_t)i * kFloatsPerStar, sampler.Sample(i), i);
+            }
+        });
+        return;
+    }
+
+    // 1. 计算排序键 (天区 * kLevels + 亮度等级) 和每线程直方图
+    const int                          kBuckets = kCells * kLevels;
+    std::vector<uint16_t>              keys(n);
+    std::vector<std::vector<uint32_t>> offsets(threads, std::vector<uint32_t>(kBuckets, 0));
+    ParallelFor(n, threads, [&](uint32_t begin, uint32_t end, int t) {
+        for (uint32_t i = begin; i < end; i++) {
+            StarSample s = sampler.Sample(i);
+            keys[i]      = (uint16_t)(s.cell * kLevels + s.level);
+            offsets[t][keys[i]]++;
+        }
+    });
+
+    // 2. 前缀和: 桶按 (天区, 亮度) 排列，桶内按线程顺序 (即星星序号升序)，结果与线程数无关
+    std::vector<uint32_t> bucketStart(kBuckets + 1);
+    uint32_t              running = 0;
+    for (int b = 0; b < kBuckets; b++) {
+        bucketStart[b] = running;
+        for (int t = 0; t < threads; t++) {
+            uint32_t c    = offsets[t][b];
+            offsets[t][b] = running;
+            running += c;
+        }
+    }
+    bucketStart[kBuckets] = running;
+
+    // 3. 计数排序: 得到排序后的星星序号
+    std::vector<uint32_t> order(n);
+    ParallelFor(n, threads, [&](uint32_t begin, uint32_t end, int t) {
+        std::vector<uint32_t>& offset = offsets[t];
+        for (uint32_t i = begin; i < end; i++) {
+            order[offset[keys[i]]++] = i;
+        }
+    });
+    keys    = {};
+    offsets = {};
+
+    // 4. 按排序后的顺序重新采样并顺序写入目标缓冲 (计数器 RNG 可以按任意顺序采样)
+    ParallelFor(n, threads, [&](uint32_t begin, uint32_t end, int) {
+        float* out = dst + (size_t)begin * kFloatsPerStar;
+        for (uint32_t j = begin; j < end; j++) {
+            WriteStar(out, sampler.Sample(order[j]), order[j]);
+            out += kFloatsPerStar;
+        }
+    });
+
+    // 5. 天区索引: 起始位置和按亮度等级的累积数量
+    index->cellFirst.resize(kCells);
+    index->cellLevels.resize((size_t)kCells * kLevels);
+    for (int c = 0; c < kCells; c++) {
+        uint32_t first      = bucketStart[c * kLevels];
+        index->cellFirst[c] = first;
+        for (int L = 0; L < kLevels; L++) {
+            index->cellLevels[c * kLevels + L] = bucketStart[c * kLevels + L + 1] - first;
+        }
+    }
+    index->minRadius = params.minRadius;
+    BuildCellBounds(*index);
+}
+
+void SelectLOD(const SkyIndex& index, const glm::mat4& viewModel, float tanHalfFovY, float aspect, uint32_t budget,
+               LODSelection& out) {
+    out.first.clear();
+    out.count.clear();
+    out.cells.clear();
+    out.total = 0;
+    if (index.cellFirst.empty()) {
+        return;
+    }
+
+    // 相机在星空局部空间中的朝向和位置 (viewModel 旋转部分为正交矩阵)
+    glm::vec3 forward = -glm::vec3(viewModel[0][2], viewModel[1][2], viewModel[2][2]);
+    glm::vec3 t       = glm::vec3(viewModel[3]);
+    glm::vec3 camPos  = -glm::vec3(glm::dot(glm::vec3(viewModel[0]), t), glm::dot(glm::vec3(viewModel[1]), t),
+                                   glm::dot(glm::vec3(viewModel[2]), t));
+
+    // 视锥外接圆锥半角 + 视差余量 (相机不在原点，近处星星的方向偏差最大为 asin(|camPos| / minRadius))
+    float halfDiag = atanf(tanHalfFovY * sqrtf(1.0f + aspect * aspect));
+    float parallax = asinf(std::min(1.0f, glm::length(camPos) / std::max(1.0f, index.minRadius)));
+
+    uint32_t totals[kLevels] = {};
+    for (int c = 0; c < kCells; c++) {
+        float angle = acosf(std::clamp(glm::dot(index.cellDir[c], forward), -1.0f, 1.0f));
+        if (angle - index.cellRadius[c] - parallax > halfDiag) {
+            continue;
+        }
+        out.cells.push_back(c);
+        const uint32_t* levels = &index.cellLevels[c * kLevels];
+        for (int L = 0; L < kLevels; L++) {
+            totals[L] += levels[L];
+        }
+    }
+
+    // 选出不超过预算的最暗等级 L，再从下一等级按各天区比例补足剩余预算
+    int L = -1;
+    while (L + 1 < kLevels && totals[L + 1] <= budget) {
+        L++;
+    }
+    uint32_t below     = L >= 0 ? totals[L] : 0;
+    uint32_t remaining = budget - below;
+    uint32_t nextTotal = L + 1 < kLevels ? totals[L + 1] - below : 0;
+
+    for (int c : out.cells) {
+        const uint32_t* levels = &index.cellLevels[c * kLevels];
+        uint32_t        base   = L >= 0 ? levels[L] : 0;
+        uint32_t        n      = base;
+        if (nextTotal > 0) {
+            n += (uint32_t)((uint64_t)(levels[L + 1] - base) * remaining / nextTotal);
+        }
+        if (n > 0) {
+            out.first.push_back((GLint)index.cellFirst[c]);
+            out.count.push_back((GLsizei)n);
+            out.total += n;
+        }
+    }
+}
+
+void BeginUpload(StarBuffer& buffer, uint32_t count) {
+    GLsizeiptr size = (GLsizeiptr)count * kFloatsPerStar * sizeof(float);
+    buffer.count    = count;
+
+    glGenVertexArrays(1, &buffer.vao);
+    glGenBuffers(1, &buffer.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo);
+    // 不可变存储: 持久映射用于上传，DYNAMIC_STORAGE 用于映射失败时的 glBufferSubData 回退
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_DYNAMIC_STORAGE_BIT);
+    // 显式刷新: 工作线程写完后由 EndUpload 一次性提交，无需 COHERENT
+    buffer.mapped = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size,
+                                             GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT |
+                                                 GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!buffer.mapped) {
+        std::cout << "[StarField] Persistent map failed, using staging buffer" << std::endl;
+        buffer.staging.resize((size_t)count * kFloatsPerStar);
+        buffer.mapped = buffer.staging.data();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void EndUpload(StarBuffer& buffer) {
+    GLsizeiptr size = (GLsizeiptr)buffer.count * kFloatsPerStar * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo);
+    if (!buffer.staging.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, buffer.staging.data());
+        buffer.staging = {};
+    } else if (buffer.mapped) {
+        glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, size);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    buffer.mapped = nullptr;
+
+    const GLsizei stride = kFloatsPerStar * sizeof(float);
+    glBindVertexArray(buffer.vao);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, 0, stride, 0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, 0, stride, (void*)12);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, 0, stride, (void*)24);
+    glBindVertexArray(0);
+    std::cout << "[StarField] " << buffer.count << " stars uploaded (" << (size >> 10) << " KB)" << std::endl;
+}
+
+void StarLayer::Init(int width, int height) {
+    w     = width;
+    h     = height;
+    valid = false;
+    if (fbo) {
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteTextures(1, &tex);
+    }
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    // 与主 FBO 相同的 HDR 格式，加法混合的星星亮度可以超过 1.0
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, width, height, 0, GL_RGB, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool StarLayer::NeedsRefresh(const glm::mat4& viewProj, uint32_t lodBudget, float thresholdPixels) const {
+    if (!valid || lodBudget != budget) {
+        return true;
+    }
+    // 取屏幕中心和四角，重投影后的像素位移即缓存画面的误差
+    static const glm::vec2 probes[5] = {{0.0f, 0.0f}, {-1.0f, -1.0f}, {1.0f, -1.0f}, {-1.0f, 1.0f}, {1.0f, 1.0f}};
+    glm::mat4              reproject = GetReprojection(viewProj);
+    for (const glm::vec2& p : probes) {
+        glm::vec4 q  = reproject * glm::vec4(p.x, p.y, 1.0f, 1.0f);
+        float     dx = (q.x / q.w - p.x) * 0.5f * w;
+        float     dy = (q.y / q.w - p.y) * 0.5f * h;
+        if (dx * dx + dy * dy > thresholdPixels * thresholdPixels) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void StarLayer::MarkCached(const glm::mat4& viewProj, uint32_t lodBudget) {
+    cachedViewProj = viewProj;
+    budget         = lodBudget;
+    valid          = true;
+}
+
+glm::mat4 StarLayer::GetReprojection(const glm::mat4& viewProj) const {
+    return cachedViewProj * glm::inverse(viewProj);
+}
+
+} // namespace StarField
@@ -0,0 +1,97 @@
+#pragma once
+// 星空生成 - 计数器 RNG 多线程并行生成，直接写入持久映射的顶点缓冲
+// 每颗星的随机数只由 (种子, 星星序号) 决定，结果与线程数和分块方式无关
+// 星星按 (天区, 亮度) 排序存放，绘制时按视锥和顶点预算只选取每个天区最亮的一段
+
+#include <cstdint>
+#include <vector>
+
+namespace StarField {
+
+static constexpr int kFloatsPerStar = 7; // pos3 + col3 + size (与 VertexStar 顶点布局一致)
+
+// 天区划分: 极轴方向按 y 等分条带 (球面上等面积) × 方位角等分，HEALPix 的简化版
+static constexpr int kBands    = 16;
+static constexpr int kSegments = 32;
+static constexpr int kCells    = kBands * kSegments;
+static constexpr int kLevels   = 64; // 亮度等级数 (按点大小 / 距离的对数划分，0 最亮)
+
+struct Params {
+    uint32_t count     = 50000;
+    uint32_t seed      = 0;
+    float    minRadius = 400.0f;
+    float    maxRadius = 3400.0f;
+};
+
+// 天区索引: 每个天区在缓冲中是一段连续区间，区间内按亮度从亮到暗排列
+struct SkyIndex {
+    std::vector<uint32_t>  cellFirst;     // 天区起始星星序号
+    std::vector<uint32_t>  cellLevels;    // [cell * kLevels + L]: 天区内亮度等级 <= L 的星星数
+    std::vector<glm::vec3> cellDir;       // 天区中心方向
+    std::vector<float>     cellRadius;    // 天区角半径 (弧度)
+    float                  minRadius = 0; // 星星最近距离 (用于视差余量)
+};
+
+// 每帧选出的绘制区间 (直接用于 glMultiDrawArrays)
+struct LODSelection {
+    std::vector<GLint>   first;
+    std::vector<GLsizei> count;
+    std::vector<int>     cells; // 可见天区 (临时数据，复用内存)
+    uint32_t             total = 0;
+};
+
+// 方向 (单位向量) 所在的天区，与 Generate 的划分一致
+uint32_t CellOf(const glm::vec3& dir);
+
+// 计算天区中心方向和角半径 (cellFirst / cellLevels 由调用方填充)
+void BuildCellBounds(SkyIndex& index);
+
+// 生成星星顶点到 dst (count * kFloatsPerStar 个 float，纯 CPU，可在工作线程调用)
+// index 非空时按 (天区, 亮度) 排序写入并填充索引；为空时按序号顺序写入
+// threads: 工作线程数，0 表示使用全部硬件线程
+void Generate(const Params& params, float* dst, SkyIndex* index = nullptr, int threads = 0);
+
+// 选择本帧绘制的星星: 剔除视锥外的天区，再按统一亮度阈值把可见星星数限制在 budget 以内
+// viewModel 为 view * model，tanHalfFovY / aspect 与投影矩阵一致；index 为空时 out 为空
+void SelectLOD(const SkyIndex& index, const glm::mat4& viewModel, float tanHalfFovY, float aspect, uint32_t budget,
+               LODSelection& out);
+
+// 星空 GPU 缓冲 (不可变存储，上传期间持久映射)
+struct StarBuffer {
+    GLuint             vao     = 0;
+    GLuint             vbo     = 0;
+    uint32_t           count   = 0;
+    float*             mapped  = nullptr; // BeginUpload 到 EndUpload 期间有效，可在工作线程写入
+    std::vector<float> staging;           // 映射失败时的 CPU 回退缓冲
+};
+
+// 在 GL 线程创建缓冲并持久映射 (映射期间主线程可以继续其他 GL 调用)
+// 驱动映射失败时回退到 CPU 暂存缓冲，调用方写入 mapped 的方式不变
+void BeginUpload(StarBuffer& buffer, uint32_t count);
+
+// 在 GL 线程提交写入、解除映射并设置顶点属性 (mapped 写入必须已经完成)
+void EndUpload(StarBuffer& buffer);
+
+// 星空缓存层: 星星渲染到屏幕大小的离屏纹理，每帧只做一次全屏重投影合成
+// 星空每秒只转 0.005 弧度，位移超过阈值 (像素) 或 LOD 预算变化时才重新绘制星星
+struct StarLayer {
+    GLuint    fbo = 0, tex = 0;
+    int       w = 0, h = 0;
+    bool      valid = false;
+    uint32_t  budget = 0;        // 缓存时的 LOD 预算
+    glm::mat4 cachedViewProj{1}; // 缓存时的 proj * view * model
+
+    // 创建 / 重建 (窗口大小变化时调用，缓存随之失效)
+    void Init(int width, int height);
+
+    // 当前变换下缓存画面在屏幕上的最大位移超过 thresholdPixels，或预算变化时需要重绘
+    bool NeedsRefresh(const glm::mat4& viewProj, uint32_t lodBudget, float thresholdPixels) const;
+
+    // 重绘完成后记录缓存时的变换
+    void MarkCached(const glm::mat4& viewProj, uint32_t lodBudget);
+
+    // 当前帧 NDC (远平面) → 缓存画面 NDC 的重投影矩阵
+    glm::mat4 GetReprojection(const glm::mat4& viewProj) const;
+};
+
+} // namespace StarField
@@ -0,0 +1,178 @@
+// StartupGraph.cpp - 启动任务图实现
+
+#include "pch.h"
+
+#include "StartupGraph.h"
+
+void StartupGraph::Add(const std::string& name, std::vector<std::string> deps, TaskFn fn) {
+    Task task;
+    task.name = name;
+    task.deps = std::move(deps);
+    task.fn   = std::move(fn);
+    tasks.push_back(std::move(task));
+}
+
+int StartupGraph::FindTask(const std::string& name) const {
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (tasks[i].name == name) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+double StartupGraph::ElapsedMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void StartupGraph::Start() {
+    if (started) {
+        return;
+    }
+    started   = true;
+    startTime = std::chrono::steady_clock::now();
+
+    // 解析依赖 (未知依赖视为已满足，只输出警告)
+    for (size_t i = 0; i < tasks.size(); i++) {
+        for (const std::string& dep : tasks[i].deps) {
+            int d = FindTask(dep);
+            if (d < 0) {
+                std::cerr << "[Startup] Task '" << tasks[i].name << "' depends on unknown task '" << dep << "'"
+                          << std::endl;
+                continue;
+            }
+            tasks[d].dependents.push_back(i);
+            tasks[i].pendingDeps++;
+        }
+    }
+
+    // 检测循环依赖: 模拟拓扑排序，无法到达的任务直接标记失败，避免 Wait()/Join() 永久阻塞
+    std::vector<int>    pending(tasks.size());
+    std::vector<size_t> order;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        pending[i] = tasks[i].pendingDeps;
+        if (pending[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    for (size_t k = 0; k < order.size(); k++) {
+        for (size_t d : tasks[order[k]].dependents) {
+            if (--pending[d] == 0) {
+                order.push_back(d);
+            }
+        }
+    }
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (pending[i] > 0) {
+            std::cerr << "[Startup] Task '" << tasks[i].name << "' is part of a dependency cycle, skipped" << std::endl;
+            tasks[i].done   = true;
+            tasks[i].failed = true;
+            doneCount++;
+        } else if (tasks[i].pendingDeps == 0) {
+            readyQueue.push_back(i);
+        }
+    }
+
+    // 工作线程数: 保留一个核心给主线程 (GL 上传、着色器编译)
+    size_t hw          = std::max(1u, std::thread::hardware_concurrency());
+    size_t workerCount = std::min(tasks.size(), std::max<size_t>(1, hw - 1));
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(&StartupGraph::WorkerLoop, this);
+    }
+    std::cout << "[Startup] " << tasks.size() << " tasks on " << workerCount << " worker threads" << std::endl;
+}
+
+void StartupGraph::Finish(size_t index, bool failed) {
+    Task& task  = tasks[index];
+    task.done   = true;
+    task.failed = task.failed || failed;
+    task.endMs  = ElapsedMs();
+    doneCount++;
+
+    for (size_t d : task.dependents) {
+        // 依赖失败时下游任务不再执行，只传播失败状态
+        if (task.failed) {
+            tasks[d].failed = true;
+        }
+        if (--tasks[d].pendingDeps == 0) {
+            readyQueue.push_back(d);
+        }
+    }
+    readyCv.notify_all();
+    doneCv.notify_all();
+}
+
+void StartupGraph::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        readyCv.wait(lock, [this] { return stopping || !readyQueue.empty(); });
+        if (readyQueue.empty()) {
+            return; // stopping
+        }
+        size_t index = readyQueue.front();
+        readyQueue.pop_front();
+
+        Task& task    = tasks[index];
+        task.beginMs  = ElapsedMs();
+        bool   failed = task.failed;
+        TaskFn fn     = std::move(task.fn);
+
+        if (!failed) {
+            lock.unlock();
+            try {
+                fn();
+            } catch (const std::exception& e) {
+                std::cerr << "[Startup] Task '" << task.name << "' failed: " << e.what() << std::endl;
+                failed = true;
+            } catch (...) {
+                std::cerr << "[Startup] Task '" << task.name << "' failed: unknown exception" << std::endl;
+                failed = true;
+            }
+            lock.lock();
+        }
+        Finish(index, failed);
+    }
+}
+
+bool StartupGraph::Wait(const std::string& name, const std::function<void()>& pump) {
+    Start();
+    int index = FindTask(name);
+    if (index < 0) {
+        std::cerr << "[Startup] Wait on unknown task '" << name << "'" << std::endl;
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!tasks[index].done) {
+        // 短超时等待，让主线程在等待期间处理窗口消息
+        doneCv.wait_for(lock, std::chrono::milliseconds(8));
+        if (pump && !tasks[index].done) {
+            lock.unlock();
+            pump();
+            lock.lock();
+        }
+    }
+    return !tasks[index].failed;
+}
+
+void StartupGraph::Join() {
+    if (!started || workers.empty()) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCv.wait(lock, [this] { return doneCount == tasks.size(); });
+        stopping = true;
+    }
+    readyCv.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    for (const Task& task : tasks) {
+        std::cout << "[Startup] " << task.name << ": " << (task.failed ? "FAILED" : "done") << " at "
+                  << task.beginMs << " - " << task.endMs << " ms (" << (task.endMs - task.beginMs) << " ms)"
+                  << std::endl;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+// 启动任务图 - 按依赖关系在工作线程上并行执行启动阶段的 CPU 任务
+// OpenGL 调用只能在主线程进行，因此图中只放纯 CPU 工作 (星空数据、网格、噪声纹理等)，
+// 主线程按需 Wait() 某个任务后再上传 GPU，等待期间可继续处理窗口消息
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class StartupGraph {
+  public:
+    using TaskFn = std::function<void()>;
+
+    // 添加任务 (必须在 Start() 之前)，deps 为依赖的任务名，任务内禁止调用 OpenGL
+    void Add(const std::string& name, std::vector<std::string> deps, TaskFn fn);
+
+    // 解析依赖并启动工作线程，依赖已满足的任务立即开始执行
+    void Start();
+
+    // 在主线程等待指定任务完成，等待期间周期性调用 pump (例如 glfwPollEvents) 保持窗口响应
+    // 返回任务是否成功 (任务抛出异常或名称不存在时返回 false)
+    bool Wait(const std::string& name, const std::function<void()>& pump = {});
+
+    // 等待全部任务完成并回收线程，输出各任务耗时
+    void Join();
+
+    ~StartupGraph() { Join(); }
+
+  private:
+    struct Task {
+        std::string              name;
+        std::vector<std::string> deps;
+        TaskFn                   fn;
+        std::vector<size_t>      dependents;      // 依赖本任务的任务索引
+        int                      pendingDeps = 0; // 尚未完成的依赖数
+        bool                     done        = false;
+        bool                     failed      = false;
+        double                   beginMs     = 0.0; // 相对 Start() 的开始/结束时间
+        double                   endMs       = 0.0;
+    };
+
+    void   WorkerLoop();
+    void   Finish(size_t index, bool failed); // 调用方需持有 mutex
+    int    FindTask(const std::string& name) const;
+    double ElapsedMs() const;
+
+    std::vector<Task>                     tasks;
+    std::deque<size_t>                    readyQueue;
+    std::vector<std::thread>              workers;
+    std::mutex                            mutex;
+    std::condition_variable               readyCv; // 有新任务就绪 (唤醒工作线程)
+    std::condition_variable               doneCv;  // 有任务完成 (唤醒主线程)
+    size_t                                doneCount = 0;
+    bool                                  started   = false;
+    bool                                  stopping  = false;
+    std::chrono::steady_clock::time_point startTime;
+};
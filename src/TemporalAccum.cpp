@@ -0,0 +1,111 @@
+// TemporalAccum.cpp - 粒子时间累积实现
+
+#include "pch.h"
+
+#include "TemporalAccum.h"
+#include "FrameGraph.h" // Capacity
+#include "Renderer.h"   // UniformCache
+
+namespace TemporalAccum {
+
+namespace {
+
+// Halton 低差异序列 (index 从 1 开始)
+float Halton(uint32_t index, uint32_t base) {
+    float f = 1.0f, r = 0.0f;
+    while (index > 0) {
+        f /= (float)base;
+        r += f * (float)(index % base);
+        index /= base;
+    }
+    return r;
+}
+
+} // namespace
+
+void Accumulator::Init(int width, int height) {
+    w     = std::max(1, width);
+    h     = std::max(1, height);
+    valid = false;
+    // 历史纹理按帧图的尺寸档位分配，动态分辨率的小幅变化只改逻辑尺寸 (历史照样作废)，超出容量才重新分配
+    if (targets[0].fbo && w <= capW && h <= capH) {
+        return;
+    }
+    capW = FrameGraph::Capacity(w);
+    capH = FrameGraph::Capacity(h);
+    for (Target& t : targets) {
+        if (t.fbo) {
+            glDeleteFramebuffers(1, &t.fbo);
+            glDeleteTextures(1, &t.tex);
+        }
+        glGenFramebuffers(1, &t.fbo);
+        glGenTextures(1, &t.tex);
+        glBindTexture(GL_TEXTURE_2D, t.tex);
+        // 与主 FBO 相同的 HDR 格式，累积的是加法混合后的粒子亮度
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, capW, capH, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindFramebuffer(GL_FRAMEBUFFER, t.fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, t.tex, 0);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+glm::mat4 Accumulator::JitterProjection(const glm::mat4& proj) {
+    // 透视投影第三列的 x / y 加偏移等价于 NDC 平移，抖动范围为 ±0.5 像素
+    uint32_t  index = jitterIndex++ % kJitterPhases + 1;
+    glm::mat4 p     = proj;
+    p[2][0] += (Halton(index, 2) - 0.5f) * 2.0f / w;
+    p[2][1] += (Halton(index, 3) - 0.5f) * 2.0f / h;
+    return p;
+}
+
+float Accumulator::HistoryWeight(const Frame& frame) const {
+    // 手出现 / 消失时粒子的动画方式切换，投影变化 (窗口尺寸) 时历史不再对应
+    if (!valid || frame.hasHand != prev.hasHand || frame.viewProj != prev.viewProj) {
+        return 0.0f;
+    }
+    // 模型矩阵的相对转角: trace(R) = 1 + 2cos(θ)
+    glm::mat3 delta    = glm::mat3(frame.model) * glm::transpose(glm::mat3(prev.model));
+    float     cosAngle = std::clamp((delta[0][0] + delta[1][1] + delta[2][2] - 1.0f) * 0.5f, -1.0f, 1.0f);
+    float     angle    = acosf(cosAngle);
+    float     scaling  = fabsf(frame.scale / std::max(prev.scale, 1e-3f) - 1.0f);
+    float     motion   = std::max(angle / kResetAngle, scaling / kResetScale);
+    return kHistoryWeight * std::clamp(1.0f - motion, 0.0f, 1.0f);
+}
+
+GLuint Accumulator::Resolve(GLuint program, const UniformCache& uc, GLuint vaoQuad, GLuint currentTex,
+                            const Frame& frame) {
+    float     weight     = HistoryWeight(frame);
+    GLuint    history    = targets[current].tex;
+    glm::mat4 invCurrent = glm::inverse(frame.viewProj);
+    glm::mat4 prevMvp    = prev.viewProj * prev.model;
+    current              = 1 - current;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, targets[current].fbo);
+    glViewport(0, 0, w, h);
+    glBlendFunc(GL_ONE, GL_ZERO);
+    glUseProgram(program);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, history);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, currentTex);
+    glUniform1i(uc.accum_uCurrent, 0);
+    glUniform1i(uc.accum_uHistory, 1);
+    glUniformMatrix4fv(uc.accum_uInvViewProj, 1, 0, &invCurrent[0][0]);
+    glUniformMatrix4fv(uc.accum_uPrevViewProj, 1, 0, &prevMvp[0][0]);
+    glUniform1f(uc.accum_uPrevScale, prev.scale);
+    glUniform2f(uc.accum_uStep, frame.ringStep, frame.bodyStep);
+    glUniform1f(uc.accum_uHistoryWeight, weight);
+    glUniform2f(uc.accum_uHistoryScale, (float)w / capW, (float)h / capH);
+    glBindVertexArray(vaoQuad);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    prev  = frame;
+    valid = true;
+    return targets[current].tex;
+}
+
+} // namespace TemporalAccum
@@ -0,0 +1,68 @@
+#pragma once
+// 粒子时间累积 - 土星粒子单独渲染到一层 (每帧亚像素抖动)，与按运动重投影的历史混合后再加到场景上
+// 重投影不需要速度缓冲: 粒子只绕模型 y 轴转动 (环粒子角速度 8 / sqrt(r)，本体匀速)，
+// 每个像素的视线与环平面 / 本体椭球求交即可得到粒子位置，再用上一帧的变换投影回去
+// 变换突变 (手势快速移动、缩放跳变) 时降低或清零历史权重，避免拖影
+
+#include <cstdint>
+
+struct UniformCache;
+
+namespace TemporalAccum {
+
+static constexpr float kHistoryWeight = 0.85f; // 静止时历史的混合权重 (约 6 帧有效样本)
+static constexpr float kResetAngle    = 0.08f; // 模型每帧转角 (弧度) 达到该值时完全丢弃历史
+static constexpr float kResetScale    = 0.05f; // 粒子缩放每帧相对变化达到该值时完全丢弃历史
+static constexpr int   kJitterPhases  = 8;     // Halton(2, 3) 抖动序列长度
+
+// 每帧的粒子变换 (与 VertexSaturn / ComputeSaturn 一致)
+struct Frame {
+    glm::mat4 viewProj{1};     // proj * view (未抖动)
+    glm::mat4 model{1};        // 土星模型矩阵 (只用于历史权重，着色器读取 LatchedInput)
+    float     scale    = 1.0f; // 粒子缩放 (uScale)
+    float     ringStep = 0.0f; // 环粒子本帧转角 = speed * ringStep
+    float     bodyStep = 0.0f; // 本体粒子本帧转角
+    bool      hasHand  = false;
+};
+
+class Accumulator {
+  public:
+    // 创建两张历史纹理 (ping-pong)，逻辑尺寸与场景渲染目标一致；尺寸变化时重新调用，历史随之失效
+    // 纹理按尺寸档位留有余量，只有超出容量时才重新分配
+    void Init(int width, int height);
+
+    // 下一帧不使用历史 (粒子重新生成等)
+    void Reset() { valid = false; }
+
+    // 本帧粒子 pass 的投影矩阵 (叠加亚像素抖动)，每帧调用一次
+    glm::mat4 JitterProjection(const glm::mat4& proj);
+
+    // 当前粒子层与重投影的历史混合，写入另一张历史纹理并返回 (GL 线程)
+    GLuint Resolve(GLuint program, const UniformCache& uc, GLuint vaoQuad, GLuint currentTex, const Frame& frame);
+
+    // 提交前锁存改写了本帧的土星姿态 (Resolve 之后调用): 下一帧按粒子实际绘制时的变换重投影历史
+    void Relatch(const glm::mat4& model, float scale) {
+        prev.model = model;
+        prev.scale = scale;
+    }
+
+    // 最近一次 Resolve 的结果
+    GLuint GetResult() const { return targets[current].tex; }
+
+  private:
+    struct Target {
+        GLuint fbo = 0, tex = 0;
+    };
+    Target   targets[2];
+    int      current = 0;
+    int      w = 0, h = 0;
+    int      capW = 0, capH = 0; // 历史纹理的分配尺寸 (>= w, h)
+    bool     valid = false;
+    Frame    prev;
+    uint32_t jitterIndex = 0;
+
+    // 由上一帧到本帧的变换幅度决定历史权重 (0 = 重置)
+    float HistoryWeight(const Frame& frame) const;
+};
+
+} // namespace TemporalAccum
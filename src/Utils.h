@@ -1,11 +1,16 @@
 #pragma once
 // 工具函数 - 通用辅助函数和数据结构
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 // 前向声明 HandTracker API (避免循环依赖)
 // 完整声明在 HandTracker.h 中
@@ -18,6 +23,9 @@ extern "C" {
 #define HAND_API_FWD __declspec(dllimport)
 #endif
 HAND_API_FWD bool GetHandData(float* out_scale, float* out_rot_x, float* out_rot_y, bool* out_has_hand);
+HAND_API_FWD bool GetHandDataEx(float* out_scale, float* out_rot_x, float* out_rot_y, bool* out_has_hand,
+                                unsigned int* out_sequence, double* out_age_ms);
+HAND_API_FWD void SetTrackerInterval(int interval_ms);
 }
 
 // 动画辅助类
@@ -42,10 +50,12 @@ struct SmoothState {
 
 // 手部追踪状态
 struct HandState {
-    bool  hasHand = false;
-    float scale   = 1.0f;
-    float rotX    = 0.5f;
-    float rotY    = 0.5f;
+    bool     hasHand    = false;
+    float    scale      = 1.0f;
+    float    rotX       = 0.5f;
+    float    rotY       = 0.5f;
+    double   sampleTime = 0.0; // 结果对应的摄像头帧取得时间 (换算到 glfwGetTime)，用于统计输入到显示的延迟
+    uint32_t sequence   = 0;   // 样本序号，追踪器产出新结果时 +1 (用于判断是否有新样本)
 };
 
 // 行星属性 (预定义以减少每帧计算)
@@ -58,14 +68,6 @@ struct PlanetData {
     float     atmosphere; // 大气层强度
 };
 
-// 行星实例数据 (用于 UBO 实例化渲染, 符合 std140 布局)
-struct PlanetInstance {
-    glm::mat4 modelMatrix; // 64 字节
-    glm::vec4 color1;      // 16 字节 (xyz = color, w = noiseScale)
-    glm::vec4 color2;      // 16 字节 (xyz = color, w = atmosphere)
-    // 总计 96 字节每实例
-};
-
 // 工具函数
 inline float Lerp(float a, float b, float f) {
     return a + f * (b - a);
@@ -75,6 +77,23 @@ inline glm::vec3 HexToRGB(int hex) {
     return glm::vec3(((hex >> 16) & 0xFF) / 255.0f, ((hex >> 8) & 0xFF) / 255.0f, (hex & 0xFF) / 255.0f);
 }
 
+// 把 [0, count) 按线程数切成连续区间并行执行 fn(begin, end, threadIndex)，调用线程处理第一段
+// 切分只取决于 count 和 threads，多次调用时同一线程拿到同一区间
+inline void ParallelFor(uint32_t count, int threads, const std::function<void(uint32_t, uint32_t, int)>& fn) {
+    threads                            = std::max(1, threads);
+    uint32_t                 perThread = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) {
+        uint32_t begin = std::min(count, t * perThread);
+        uint32_t end   = std::min(count, begin + perThread);
+        workers.emplace_back(fn, begin, end, t);
+    }
+    fn(0, std::min(count, perThread), 0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
 // 预定义行星常量数据 (从 Main.cpp 移至此处，避免硬编码)
 namespace PlanetConstants {
 // 定义行星的位置、大小、颜色等属性
@@ -89,52 +108,9 @@ inline const PlanetData kPlanets[] = {
 inline constexpr int kPlanetCount = sizeof(kPlanets) / sizeof(kPlanets[0]);
 } // namespace PlanetConstants
 
-// 环形缓冲区 FPS 计算器 (优化: 提供更平滑的 FPS 统计)
-// 使用固定大小的环形缓冲区存储最近 N 帧的帧时间，计算滑动平均
-template <int N = 60> class RingBufferFPS {
-  public:
-    RingBufferFPS() {
-        // 预填充假设 60 FPS 的帧时间，避免启动时 FPS 从 0 涨上去
-        for (int i = 0; i < N; i++) {
-            frameTimes[i] = 1.0f / 60.0f;
-        }
-        count = N; // 标记为已填满，与 sum 的初始值匹配
-    }
-
-    // 添加新的帧时间
-    void AddFrameTime(float dt) {
-        sum -= frameTimes[index];
-        frameTimes[index] = dt;
-        sum += dt;
-        index = (index + 1) % N;
-        // count 已经在构造函数中设为 N，不再增长
-    }
-
-    // 获取平均 FPS
-    float GetAverageFPS() const {
-        if (sum <= 0.0f) {
-            return 60.0f;
-        }
-        return (float)N / sum; // 始终使用 N 作为分子
-    }
-
-    // 获取平均帧时间
-    float GetAverageFrameTime() const {
-        if (sum <= 0.0f) {
-            return 1.0f / 60.0f;
-        }
-        return sum / (float)N; // 始终使用 N 作为分母
-    }
-
-  private:
-    float frameTimes[N];
-    float sum   = N * (1.0f / 60.0f); // 初始假设 60 FPS
-    int   index = 0;
-    int   count = N; // 初始化为 N，与预填充的数据匹配
-};
-
 // 异步手部追踪器 (优化: 将手部追踪从主线程解耦，消除阻塞)
 // 后台线程持续更新手部数据，主循环只需读取最新状态
+// 采样间隔可调 (省电模式下降低频率或暂停)，调整后立即唤醒线程
 class AsyncHandTracker {
   public:
     void Start() {
@@ -146,7 +122,11 @@ class AsyncHandTracker {
     }
 
     void Stop() {
-        running.store(false);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            running.store(false);
+        }
+        wake.notify_all();
         if (trackerThread.joinable()) {
             trackerThread.join();
         }
@@ -157,24 +137,58 @@ class AsyncHandTracker {
         return latestState;
     }
 
+    // 追踪间隔 (毫秒)，同时设置 DLL 工作线程处理摄像头帧的间隔；轮询间隔取其一半，新结果最多晚半帧取到
+    // 0 表示暂停: 工作线程释放摄像头，轮询线程阻塞等待，都不占用 CPU
+    // 在 wakeMutex 内修改，线程检查条件与进入等待之间不会漏掉通知
+    void SetIntervalMs(int ms) {
+        if (intervalMs.load() == ms) {
+            return;
+        }
+        SetTrackerInterval(ms);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            intervalMs.store(ms);
+        }
+        wake.notify_all();
+    }
+
     ~AsyncHandTracker() { Stop(); }
 
   private:
     void TrackingLoop() {
         while (running.load()) {
-            HandState temp;
-            GetHandData(&temp.scale, &temp.rotX, &temp.rotY, &temp.hasHand);
-            {
-                std::lock_guard<std::mutex> lock(stateMutex);
-                latestState = temp;
+            int interval = intervalMs.load();
+            if (interval > 0) {
+                // 轮询比追踪器处理帧更频繁；只有追踪器序号变化时才发布，重复的旧结果不算新样本
+                HandState    temp;
+                unsigned int trackerSequence = 0;
+                double       ageMs           = 0.0;
+                GetHandDataEx(&temp.scale, &temp.rotX, &temp.rotY, &temp.hasHand, &trackerSequence, &ageMs);
+                if (trackerSequence != lastTrackerSequence) {
+                    lastTrackerSequence = trackerSequence;
+                    temp.sampleTime     = glfwGetTime() - ageMs / 1000.0;
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    temp.sequence = latestState.sequence + 1;
+                    latestState   = temp;
+                }
+            }
+            // 默认追踪器约 30 FPS、轮询约 60 FPS，足够流畅且不过度占用 CPU；暂停时一直等到间隔变化或停止
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            auto changed = [&] { return !running.load() || intervalMs.load() != interval; };
+            if (interval > 0) {
+                wake.wait_for(lock, std::chrono::milliseconds(std::max(interval / 2, 1)), changed);
+            } else {
+                wake.wait(lock, changed);
             }
-            // 约60 FPS的追踪频率，足够流畅且不过度占用CPU
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
         }
     }
 
-    std::thread       trackerThread;
-    std::atomic<bool> running{false};
-    std::mutex        stateMutex;
-    HandState         latestState;
+    std::thread             trackerThread;
+    std::atomic<bool>       running{false};
+    std::atomic<int>        intervalMs{33};
+    std::mutex              stateMutex;
+    std::mutex              wakeMutex;
+    std::condition_variable wake;
+    HandState               latestState;
+    unsigned int            lastTrackerSequence = 0; // 最近一次发布的追踪器结果序号 (仅追踪线程访问)
 };
@@ -13,6 +13,10 @@
 #define DWMWA_USE_IMMERSIVE_DARK_MODE 20
 #endif
 
+#ifndef DWMWA_CLOAKED
+#define DWMWA_CLOAKED 14
+#endif
+
 #ifndef DWMWA_SYSTEMBACKDROP_TYPE
 #define DWMWA_SYSTEMBACKDROP_TYPE 38
 
@@ -190,4 +194,62 @@ inline void FramebufferSizeCallback(GLFWwindow* window, int width, int height) {
     }
 }
 
+// 最小化 / 恢复回调 (省电模式)
+inline void WindowIconifyCallback(GLFWwindow* window, int iconified) {
+    AppState* state = GetAppState(window);
+    if (state) {
+        state->window.iconified = iconified == GLFW_TRUE;
+    }
+}
+
+// 焦点变化回调 (省电模式)
+inline void WindowFocusCallback(GLFWwindow* window, int focused) {
+    AppState* state = GetAppState(window);
+    if (state) {
+        state->window.focused = focused == GLFW_TRUE;
+    }
+}
+
+// 窗口是否完全看不见: 被 DWM 隐藏 (切换虚拟桌面等)，或客户区被 Z 序在上方的可见窗口完全覆盖
+// DWM 合成下 GL 默认帧缓冲没有像素归属信息 (呈现也不会返回遮挡状态)，只能按窗口矩形计算
+inline bool IsWindowOccluded(GLFWwindow* window) {
+#ifdef _WIN32
+    HWND  hwnd    = glfwGetWin32Window(window);
+    DWORD cloaked = 0;
+    if (SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked, sizeof(cloaked))) && cloaked) {
+        return true;
+    }
+    RECT client;
+    if (!GetClientRect(hwnd, &client)) {
+        return false;
+    }
+    MapWindowPoints(hwnd, nullptr, (POINT*)&client, 2);
+    HRGN visible  = CreateRectRgnIndirect(&client);
+    bool occluded = false;
+    for (HWND above = GetWindow(hwnd, GW_HWNDPREV); above && !occluded; above = GetWindow(above, GW_HWNDPREV)) {
+        // 隐藏、最小化、被 DWM 隐藏的窗口和分层窗口 (半透明叠加层、阴影) 不算遮挡
+        DWORD aboveCloaked = 0;
+        DwmGetWindowAttribute(above, DWMWA_CLOAKED, &aboveCloaked, sizeof(aboveCloaked));
+        if (!IsWindowVisible(above) || IsIconic(above) || aboveCloaked ||
+            (GetWindowLongW(above, GWL_EXSTYLE) & WS_EX_LAYERED)) {
+            continue;
+        }
+        // 扩展边框之外的阴影 / 调整大小区域是透明的，取 DWM 的实际可见边界
+        RECT bounds;
+        if (FAILED(DwmGetWindowAttribute(above, DWMWA_EXTENDED_FRAME_BOUNDS, &bounds, sizeof(bounds))) &&
+            !GetWindowRect(above, &bounds)) {
+            continue;
+        }
+        HRGN cover = CreateRectRgnIndirect(&bounds);
+        occluded   = CombineRgn(visible, visible, cover, RGN_DIFF) == NULLREGION;
+        DeleteObject(cover);
+    }
+    DeleteObject(visible);
+    return occluded;
+#else
+    (void)window;
+    return false;
+#endif
+}
+
 } // namespace WindowManager
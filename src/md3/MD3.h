@@ -304,6 +304,12 @@ MD3Context& GetContext();
 // 公共 API
 //=============================================================================
 
+// 着色器程序创建函数 (由宿主程序提供，例如带二进制缓存的实现)
+typedef GLuint (*ProgramFactory)(const char* vertexSrc, const char* fragmentSrc, const char* name);
+
+// 设置着色器程序创建函数，需在 Init 之前调用；未设置时直接从源码编译
+void SetProgramFactory(ProgramFactory factory);
+
 // 初始化 MD3 系统
 void Init(float dpiScale = 1.0f);
 
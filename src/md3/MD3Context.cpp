@@ -71,6 +71,13 @@ static GLuint CreateProgram(const char* vertexSrc, const char* fragmentSrc) {
     return program;
 }
 
+// 宿主提供的程序创建函数
+static ProgramFactory g_programFactory = nullptr;
+
+void SetProgramFactory(ProgramFactory factory) {
+    g_programFactory = factory;
+}
+
 void Init(float dpiScale) {
     if (g_context.initialized) {
         return;
@@ -81,7 +88,9 @@ void Init(float dpiScale) {
     g_context.colors     = GetDarkColorScheme();
 
     // 创建 Ripple 着色器程序
-    g_context.rippleProgram = CreateProgram(MD3Shaders::VertexRipple, MD3Shaders::FragmentRipple);
+    g_context.rippleProgram =
+        g_programFactory ? g_programFactory(MD3Shaders::VertexRipple, MD3Shaders::FragmentRipple, "md3_ripple")
+                         : CreateProgram(MD3Shaders::VertexRipple, MD3Shaders::FragmentRipple);
 
     if (!g_context.rippleProgram) {
         std::cerr << "[MD3] Failed to create ripple shader program" << std::endl;